@@ -22,6 +22,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -274,6 +275,7 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	Common::ProfileZone zone("mixCallback", Common::kProfileTrackAudio);
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
@@ -26,6 +26,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/translation.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/action.h"
@@ -195,6 +196,11 @@ bool DefaultEventManager::pollEvent(Common::Event &event) {
 			g_engine->flipMute();
 		break;
 
+	case Common::EVENT_PROFILER:
+		ProfilerMan.setOverlayVisible(!ProfilerMan.isOverlayVisible());
+		forwardEvent = false;
+		break;
+
 	case Common::EVENT_QUIT:
 		if (g_engine && ConfMan.getBool("confirm_exit")) {
 			if (_confirmExitDialogActive) {
@@ -371,6 +377,11 @@ Common::Keymap *DefaultEventManager::getGlobalKeymap() {
 	act->setEvent(EVENT_DEBUGGER);
 	globalKeymap->addAction(act);
 
+	act = new Action("PROFILER", _("Toggle frame profiler"));
+	act->addDefaultInputMapping("C+A+p");
+	act->setEvent(EVENT_PROFILER);
+	globalKeymap->addAction(act);
+
 	_virtualMouse->addActionsToKeymap(globalKeymap);
 
 	return globalKeymap;
@@ -28,6 +28,7 @@
 #include "backends/mutex/mutex.h"
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 #include "graphics/pixelbuffer.h"
@@ -185,15 +186,21 @@ void ModularGraphicsBackend::fillScreen(uint32 col) {
 }
 
 void ModularGraphicsBackend::updateScreen() {
+	{
+		Common::ProfileZone zone("updateScreen");
+
 #ifdef ENABLE_EVENTRECORDER
-	g_eventRec.preDrawOverlayGui();
+		g_eventRec.preDrawOverlayGui();
 #endif
 
-	_graphicsManager->updateScreen();
+		_graphicsManager->updateScreen();
 
 #ifdef ENABLE_EVENTRECORDER
-	g_eventRec.postDrawOverlayGui();
+		g_eventRec.postDrawOverlayGui();
 #endif
+	}
+
+	ProfilerMan.endFrame();
 }
 
 void ModularGraphicsBackend::setShakePos(int shakeXOffset, int shakeYOffset) {
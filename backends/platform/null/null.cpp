@@ -56,10 +56,17 @@ typedef void (*sighandler_t)(int);
 #include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
 #include "backends/mixer/null/null-mixer.h"
-#include "backends/mutex/null/null-mutex.h"
 #include "backends/graphics/null/null-graphics.h"
 #include "gui/debugger.h"
 #endif
+#include "backends/mutex/null/null-mutex.h"
+
+// The tests run the thread pool on real worker threads where possible
+#if defined(NULL_DRIVER_USE_FOR_TEST) && defined(POSIX)
+#define NULL_DRIVER_USE_THREADS
+#include "backends/mutex/pthread/pthread-mutex.h"
+#include <pthread.h>
+#endif
 
 /*
  * Include header files needed for the getFilesystemFactory() method.
@@ -86,6 +93,7 @@ public:
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual uint32 getMillis(bool skipRecord = false);
+	virtual uint64 getMicros();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
 
@@ -95,6 +103,16 @@ public:
 
 	virtual void addSysArchivesToSearchSet(Common::SearchSet &s, int priority);
 
+#ifdef NULL_DRIVER_USE_THREADS
+	virtual uint getNumProcessors();
+	virtual ThreadRef createThread(ThreadProc proc, void *param);
+	virtual void joinThread(ThreadRef thread);
+	virtual SemaphoreRef createSemaphore(uint initialValue);
+	virtual void waitSemaphore(SemaphoreRef semaphore);
+	virtual void signalSemaphore(SemaphoreRef semaphore);
+	virtual void deleteSemaphore(SemaphoreRef semaphore);
+#endif
+
 private:
 #ifdef POSIX
 	timeval _startTime;
@@ -117,6 +135,20 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+	// The tests don't initialize the backend, but may use Common::Mutex
+#if defined(NULL_DRIVER_USE_THREADS)
+	_mutexManager = new PthreadMutexManager();
+#elif defined(NULL_DRIVER_USE_FOR_TEST)
+	_mutexManager = new NullMutexManager();
+#endif
+
+	// Start the clock here, as the startup is timed from before initBackend()
+#ifdef POSIX
+	gettimeofday(&_startTime, 0);
+#elif defined(WIN32)
+	_startTime = GetTickCount();
+#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
@@ -134,12 +166,6 @@ void intHandler(int dummy) {
 #endif
 
 void OSystem_NULL::initBackend() {
-#ifdef POSIX
-	gettimeofday(&_startTime, 0);
-#elif defined(WIN32)
-	_startTime = GetTickCount();
-#endif
-
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #ifdef POSIX
 	last_handler = signal(SIGINT, intHandler);
@@ -200,6 +226,18 @@ uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #endif
 }
 
+uint64 OSystem_NULL::getMicros() {
+#ifdef POSIX
+	timeval curTime;
+
+	gettimeofday(&curTime, 0);
+
+	return (uint64)(curTime.tv_sec - _startTime.tv_sec) * 1000000 + (curTime.tv_usec - _startTime.tv_usec);
+#else
+	return OSystem::getMicros();
+#endif
+}
+
 void OSystem_NULL::delayMillis(uint msecs) {
 #ifdef POSIX
 	usleep(msecs * 1000);
@@ -241,6 +279,85 @@ void OSystem_NULL::addSysArchivesToSearchSet(Common::SearchSet &s, int priority)
 	s.add("gui/themes", new Common::FSDirectory("gui/themes", 4), priority);
 }
 
+#ifdef NULL_DRIVER_USE_THREADS
+uint OSystem_NULL::getNumProcessors() {
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 1 ? (uint)count : 1;
+}
+
+struct NullThreadStart {
+	OSystem::ThreadProc proc;
+	void *param;
+};
+
+static void *nullThreadEntry(void *data) {
+	NullThreadStart start = *(NullThreadStart *)data;
+	delete (NullThreadStart *)data;
+
+	start.proc(start.param);
+	return nullptr;
+}
+
+OSystem::ThreadRef OSystem_NULL::createThread(ThreadProc proc, void *param) {
+	NullThreadStart *start = new NullThreadStart;
+	start->proc = proc;
+	start->param = param;
+
+	pthread_t *thread = new pthread_t;
+	if (pthread_create(thread, nullptr, nullThreadEntry, start) != 0) {
+		warning("pthread_create() failed");
+		delete start;
+		delete thread;
+		return 0;
+	}
+
+	return (ThreadRef)thread;
+}
+
+void OSystem_NULL::joinThread(ThreadRef thread) {
+	pthread_join(*(pthread_t *)thread, nullptr);
+	delete (pthread_t *)thread;
+}
+
+struct NullSemaphore {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	uint count;
+};
+
+OSystem::SemaphoreRef OSystem_NULL::createSemaphore(uint initialValue) {
+	NullSemaphore *sem = new NullSemaphore;
+	pthread_mutex_init(&sem->mutex, nullptr);
+	pthread_cond_init(&sem->cond, nullptr);
+	sem->count = initialValue;
+	return (SemaphoreRef)sem;
+}
+
+void OSystem_NULL::waitSemaphore(SemaphoreRef semaphore) {
+	NullSemaphore *sem = (NullSemaphore *)semaphore;
+	pthread_mutex_lock(&sem->mutex);
+	while (!sem->count)
+		pthread_cond_wait(&sem->cond, &sem->mutex);
+	sem->count--;
+	pthread_mutex_unlock(&sem->mutex);
+}
+
+void OSystem_NULL::signalSemaphore(SemaphoreRef semaphore) {
+	NullSemaphore *sem = (NullSemaphore *)semaphore;
+	pthread_mutex_lock(&sem->mutex);
+	sem->count++;
+	pthread_cond_signal(&sem->cond);
+	pthread_mutex_unlock(&sem->mutex);
+}
+
+void OSystem_NULL::deleteSemaphore(SemaphoreRef semaphore) {
+	NullSemaphore *sem = (NullSemaphore *)semaphore;
+	pthread_cond_destroy(&sem->cond);
+	pthread_mutex_destroy(&sem->mutex);
+	delete sem;
+}
+#endif
+
 OSystem *OSystem_NULL_create() {
 	return new OSystem_NULL();
 }
@@ -25,6 +25,7 @@
 #include "backends/platform/sdl/sdl.h"
 #include "common/config-manager.h"
 #include "gui/EventRecorder.h"
+#include "common/profiler.h"
 #include "common/taskbar.h"
 #include "common/textconsole.h"
 
@@ -660,13 +661,84 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+uint64 OSystem_SDL::getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	static const uint64 frequency = SDL_GetPerformanceFrequency();
+	uint64 counter = SDL_GetPerformanceCounter();
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
 void OSystem_SDL::delayMillis(uint msecs) {
+	Common::ProfileZone zone("delayMillis");
+
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
 #endif
 		SDL_Delay(msecs);
 }
 
+uint OSystem_SDL::getNumProcessors() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return MAX(SDL_GetCPUCount(), 1);
+#else
+	return 1;
+#endif
+}
+
+struct SdlThreadStart {
+	OSystem::ThreadProc proc;
+	void *param;
+};
+
+static int SDLCALL sdlThreadEntry(void *data) {
+	SdlThreadStart start = *(SdlThreadStart *)data;
+	delete (SdlThreadStart *)data;
+
+	start.proc(start.param);
+	return 0;
+}
+
+OSystem::ThreadRef OSystem_SDL::createThread(ThreadProc proc, void *param) {
+	SdlThreadStart *start = new SdlThreadStart;
+	start->proc = proc;
+	start->param = param;
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	SDL_Thread *thread = SDL_CreateThread(sdlThreadEntry, "ScummVM worker", start);
+#else
+	SDL_Thread *thread = SDL_CreateThread(sdlThreadEntry, start);
+#endif
+	if (!thread) {
+		warning("SDL_CreateThread() failed: %s", SDL_GetError());
+		delete start;
+	}
+
+	return (ThreadRef)thread;
+}
+
+void OSystem_SDL::joinThread(ThreadRef thread) {
+	SDL_WaitThread((SDL_Thread *)thread, nullptr);
+}
+
+OSystem::SemaphoreRef OSystem_SDL::createSemaphore(uint initialValue) {
+	return (SemaphoreRef)SDL_CreateSemaphore(initialValue);
+}
+
+void OSystem_SDL::waitSemaphore(SemaphoreRef semaphore) {
+	SDL_SemWait((SDL_sem *)semaphore);
+}
+
+void OSystem_SDL::signalSemaphore(SemaphoreRef semaphore) {
+	SDL_SemPost((SDL_sem *)semaphore);
+}
+
+void OSystem_SDL::deleteSemaphore(SemaphoreRef semaphore) {
+	SDL_DestroySemaphore((SDL_sem *)semaphore);
+}
+
 void OSystem_SDL::getTimeAndDate(TimeDate &td, bool skipRecord) const {
 	time_t curTime = time(0);
 	struct tm t = *localtime(&curTime);
@@ -84,8 +84,19 @@ public:
 	virtual void setWindowCaption(const Common::U32String &caption) override;
 	virtual void addSysArchivesToSearchSet(Common::SearchSet &s, int priority = 0) override;
 	virtual uint32 getMillis(bool skipRecord = false) override;
+	virtual uint64 getMicros() override;
 	virtual void delayMillis(uint msecs) override;
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const override;
+
+	// Worker threads
+	virtual uint getNumProcessors() override;
+	virtual ThreadRef createThread(ThreadProc proc, void *param) override;
+	virtual void joinThread(ThreadRef thread) override;
+	virtual SemaphoreRef createSemaphore(uint initialValue) override;
+	virtual void waitSemaphore(SemaphoreRef semaphore) override;
+	virtual void signalSemaphore(SemaphoreRef semaphore) override;
+	virtual void deleteSemaphore(SemaphoreRef semaphore) override;
+
 	virtual MixerManager *getMixerManager() override;
 	virtual Common::TimerManager *getTimerManager() override;
 	virtual Common::SaveFileManager *getSavefileManager() override;
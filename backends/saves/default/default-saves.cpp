@@ -42,6 +42,11 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/lz4.h"
+#include "common/memstream.h"
+#include "common/osd_message_queue.h"
+#include "common/threadpool.h"
+#include "common/translation.h"
 #include "common/zlib.h"
 
 #include <errno.h>	// for removeSavefile()
@@ -50,13 +55,109 @@
 const char *DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+struct DefaultSaveFileManager::PendingSave {
+	PendingSave(Common::ThreadPool &pool) : group(pool), success(false) {}
+
+	Common::TaskGroup group;
+	bool success;           ///< Set by the task before it finishes
+};
+
+namespace {
+
+class SaveWriteTask : public Common::Task {
+public:
+	SaveWriteTask(Common::WriteStream *stream, byte *data, uint32 size, bool &success, const Common::U32String &failureMessage)
+		: _stream(stream), _data(data), _size(size), _success(success), _failureMessage(failureMessage) {}
+
+	void run() override {
+		_stream->write(_data, _size);
+		_stream->finalize();
+		_success = !_stream->err();
+
+		// Nobody may be waiting for the save, so tell the user right away
+		if (!_success)
+			Common::OSDMessageQueue::instance().addMessage(_failureMessage);
+
+		delete _stream;
+		free(_data);
+	}
+
+private:
+	Common::WriteStream *_stream;
+	byte *_data;
+	uint32 _size;
+	bool &_success;
+	Common::U32String _failureMessage;
+};
+
+Common::WriteStream *wrapSaveCompression(Common::WriteStream *stream, bool compress) {
+	if (!compress)
+		return stream;
+	if (ConfMan.get("save_compression") == "lz4")
+		return Common::wrapLZ4WriteStream(stream);
+	return Common::wrapCompressedWriteStream(stream);
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+} // End of anonymous namespace
+
+/**
+ * Stream keeping a save file in memory, which is compressed and written by
+ * the save file manager in the background once the stream is finalized.
+ *
+ * Neither finalize() nor err() wait for the save file to be written, so
+ * err() only reports a write error if the worker is already done. Later
+ * errors are shown on the OSD, and reported by the save file manager.
+ */
+class AsyncSaveWriteStream : public Common::MemoryWriteStreamDynamic {
+public:
+	AsyncSaveWriteStream(DefaultSaveFileManager *manager, const Common::String &filename, Common::WriteStream *file)
+		: Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO), _manager(manager), _filename(filename), _file(file) {}
+
+	~AsyncSaveWriteStream() {
+		finalize();
+	}
+
+	void finalize() override {
+		if (!_file)
+			return;
+
+		_save = _manager->queueSave(_filename, _file, _data, _size);
+		_file = nullptr;
+
+		// The data belongs to the writer now
+		_data = _ptr = nullptr;
+		_capacity = _size = _pos = 0;
+	}
+
+	bool err() const override {
+		if (!_save)
+			return Common::MemoryWriteStreamDynamic::err();
+
+		// Write errors are only known once the worker is done
+		if (_save->group.isDone() && !_save->success)
+			return true;
+		return Common::MemoryWriteStreamDynamic::err();
+	}
+
+private:
+	DefaultSaveFileManager *_manager;
+	Common::String _filename;
+	Common::WriteStream *_file;
+	DefaultSaveFileManager::PendingSavePtr _save;
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _writerPool(nullptr) {
+}
+
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _writerPool(nullptr) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	waitForPendingSaves();
+	delete _writerPool;
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -98,6 +199,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	waitForPendingSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -114,6 +217,8 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	waitForPendingSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -131,11 +236,18 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 	} else {
 		// Open the file for loading.
 		Common::SeekableReadStream *sf = file->_value.createReadStream();
+
+		// Save files may also be compressed with LZ4, see wrapSaveCompression()
+		Common::SeekableReadStream *lz4 = Common::wrapLZ4ReadStream(sf);
+		if (lz4 != sf)
+			return lz4;
 		return Common::wrapCompressedReadStream(sf);
 	}
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	waitForPendingSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::String savePathName = getSavePath();
 	assureCached(savePathName);
@@ -171,7 +283,19 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	Common::WriteStream *const stream = wrapSaveCompression(sf, compress);
+
+	// The cloud manager syncs the saves as soon as they are finalized, so
+	// they cannot be written in the background
+#if !defined(USE_CLOUD) || !defined(USE_LIBCURL)
+	if (ConfMan.getBool("save_async")) {
+		Common::OutSaveFile *const result = new Common::OutSaveFile(new AsyncSaveWriteStream(this, filename, stream));
+		_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+		return result;
+	}
+#endif
+
+	Common::OutSaveFile *const result = new Common::OutSaveFile(stream);
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
@@ -180,6 +304,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	waitForPendingSave(filename);
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -236,6 +362,66 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+bool DefaultSaveFileManager::isSavePending(const Common::String &filename) {
+	PendingSaveMap::iterator save = _pendingSaves.find(filename);
+	if (save == _pendingSaves.end())
+		return false;
+
+	if (!save->_value->group.isDone())
+		return true;
+
+	finishPendingSave(save);
+	return false;
+}
+
+bool DefaultSaveFileManager::waitForPendingSaves() {
+	bool success = true;
+	while (!_pendingSaves.empty()) {
+		PendingSaveMap::iterator save = _pendingSaves.begin();
+		save->_value->group.wait();
+		success &= finishPendingSave(save);
+	}
+	return success;
+}
+
+DefaultSaveFileManager::PendingSavePtr DefaultSaveFileManager::queueSave(const Common::String &filename, Common::WriteStream *stream, byte *data, uint32 size) {
+	waitForPendingSave(filename);
+
+	if (!_writerPool)
+		_writerPool = new Common::ThreadPool(1);
+
+	// Create the message queue here, the worker only posts to it. Likewise,
+	// the failure message is translated before the task is queued.
+	Common::OSDMessageQueue::instance();
+
+	// Without thread support, the task runs right away
+	PendingSavePtr save(new PendingSave(*_writerPool));
+	_pendingSaves[filename] = save;
+	save->group.run(new SaveWriteTask(stream, data, size, save->success, _("Failed to save game")));
+	return save;
+}
+
+void DefaultSaveFileManager::waitForPendingSave(const Common::String &filename) {
+	PendingSaveMap::iterator save = _pendingSaves.find(filename);
+	if (save == _pendingSaves.end())
+		return;
+
+	save->_value->group.wait();
+	finishPendingSave(save);
+}
+
+bool DefaultSaveFileManager::finishPendingSave(PendingSaveMap::iterator save) {
+	bool success = save->_value->success;
+	if (!success) {
+		warning("DefaultSaveFileManager: Failed to write save file '%s'", save->_key.c_str());
+		// The writer has already shown the error on the OSD
+		setError(Common::kWritingFailed, "Failed to write save file '" + save->_key + "'");
+	}
+
+	_pendingSaves.erase(save);
+	return success;
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
@@ -28,8 +28,14 @@
 #include "common/str.h"
 #include "common/fs.h"
 #include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/ptr.h"
 #include <limits.h>
 
+namespace Common {
+class ThreadPool;
+}
+
 /**
  * Provides a default savefile manager implementation for common platforms.
  */
@@ -37,6 +43,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	~DefaultSaveFileManager();
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -45,6 +52,8 @@ public:
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	bool isSavePending(const Common::String &filename) override;
+	bool waitForPendingSaves() override;
 
 #ifdef USE_LIBCURL
 
@@ -96,6 +105,31 @@ protected:
 	Common::StringArray _lockedFiles;
 
 private:
+	friend class AsyncSaveWriteStream;
+
+	struct PendingSave;
+	typedef Common::SharedPtr<PendingSave> PendingSavePtr;
+	typedef Common::HashMap<Common::String, PendingSavePtr, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> PendingSaveMap;
+
+	/**
+	 * Write a save file in the background, taking ownership of the
+	 * stream and of the malloc'ed data. Returns the pending save, which
+	 * records whether writing succeeded.
+	 */
+	PendingSavePtr queueSave(const Common::String &filename, Common::WriteStream *stream, byte *data, uint32 size);
+
+	/** Wait until the given save file is written, if it is being written. */
+	void waitForPendingSave(const Common::String &filename);
+
+	/** Forget about a written save file, and report if writing it failed. */
+	bool finishPendingSave(PendingSaveMap::iterator save);
+
+	/** Worker writing the save files, created on first use. */
+	Common::ThreadPool *_writerPool;
+
+	/** The save files being written in the background. */
+	PendingSaveMap _pendingSaves;
+
 	/**
 	 * The currently cached directory.
 	 */
@@ -134,6 +134,9 @@ static const char HELP_STRING[] =
 	"  --debug-channels-only    Show only the specified debug channels\n"
 	"  -u, --dump-scripts       Enable script dumping if a directory called 'dumps'\n"
 	"                           exists in the current directory\n"
+	"  --profiler               Record frame timings while running the game (see the\n"
+	"                           'profiler' debugger command)\n"
+	"  --startup-profile        Print how long each phase of the startup took\n"
 	"\n"
 	"  --cdrom=DRIVE            CD drive to play CD audio from; can either be a\n"
 	"                           drive, path, or numeric index (default: 0 = best\n"
@@ -175,6 +178,8 @@ static const char HELP_STRING[] =
 	"  --record-file-name=FILE  Specify record file name\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
+	"  --benchmark              Play back the record file without display as fast as\n"
+	"                           possible, then print frame time statistics\n"
 #endif
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
@@ -288,8 +293,11 @@ void registerDefaults() {
 	ConfMan.registerDefault("subtitles", false);
 	ConfMan.registerDefault("boot_param", 0);
 	ConfMan.registerDefault("dump_scripts", false);
+	ConfMan.registerDefault("profiler", false);
 	ConfMan.registerDefault("save_slot", -1);
 	ConfMan.registerDefault("autosave_period", 5 * 60); // By default, trigger autosave every 5 minutes
+	ConfMan.registerDefault("save_compression", "zlib"); // "zlib" or "lz4", which is faster
+	ConfMan.registerDefault("save_async", false); // Write save files in the background
 
 #if defined(ENABLE_SCUMM) || defined(ENABLE_SWORD2)
 	ConfMan.registerDefault("object_labels", true);
@@ -320,6 +328,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("disable_display", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
+	ConfMan.registerDefault("benchmark", false);
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
@@ -658,6 +667,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
+
+			DO_LONG_OPTION_BOOL("benchmark")
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
@@ -748,6 +760,12 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("dump-midi")
 			END_OPTION
 
+			DO_LONG_OPTION_BOOL("profiler")
+			END_OPTION
+
+			DO_LONG_OPTION_BOOL("startup-profile")
+			END_OPTION
+
 			DO_LONG_OPTION_BOOL("enable-gs")
 			END_OPTION
 
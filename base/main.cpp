@@ -38,17 +38,20 @@
 #include "base/version.h"
 
 #include "common/archive.h"
+#include "common/array.h"
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/debug-channels.h" /* for debug manager */
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/profiler.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
 #include "common/text-to-speech.h"
@@ -91,7 +94,66 @@
 #include "gui/updates-dialog.h"
 #endif
 
+/**
+ * Times the phases of the startup, which are printed when ScummVM is
+ * started with --startup-profile.
+ */
+class StartupProfile {
+public:
+	StartupProfile() : _enabled(false), _reported(false), _start(0), _phaseStart(0) {}
+
+	void start() {
+		_enabled = true;
+		_start = _phaseStart = g_system->getMicros();
+	}
+
+	/** Finish the current phase, and start timing the next one. */
+	void endPhase(const char *name) {
+		if (!_enabled || _reported)
+			return;
+
+		uint64 now = g_system->getMicros();
+		Phase phase;
+		phase.name = name;
+		phase.duration = (uint32)(now - _phaseStart);
+		_phases.push_back(phase);
+		_phaseStart = now;
+	}
+
+	/** Print the phases once the launcher or the first game is about to run. */
+	void report() {
+		if (!_enabled || _reported)
+			return;
+		_reported = true;
+
+		debug("Startup profile:");
+		for (uint i = 0; i < _phases.size(); i++)
+			debug("  %-20s %8.2f ms", _phases[i].name, _phases[i].duration / 1000.0);
+		debug("  %-20s %8.2f ms", "Total", (g_system->getMicros() - _start) / 1000.0);
+	}
+
+private:
+	struct Phase {
+		const char *name;
+		uint32 duration;
+	};
+
+	bool _enabled;
+	bool _reported;
+	uint64 _start;
+	uint64 _phaseStart;
+	Common::Array<Phase> _phases;
+};
+
+static StartupProfile s_startupProfile;
+
 static bool launcherDialog() {
+	// Loading the theme and its fonts takes a while, so the GUI is only set
+	// up once it is needed. Do it before the command line options are
+	// discarded, so that --gui-theme is still honored.
+	GUI::GuiManager::instance();
+	s_startupProfile.endPhase("GUI");
+	s_startupProfile.report();
 
 	// Discard any command line options. Those that affect the graphics
 	// mode and the others (like bootparam etc.) should not
@@ -307,9 +369,15 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 	system.getEventManager()->purgeKeyboardEvents();
 	system.getEventManager()->purgeMouseEvents();
 
+	if (ConfMan.getBool("profiler"))
+		ProfilerMan.setEnabled(true);
+
 	// Run the engine
 	Common::Error result = engine->run();
 
+	if (Common::Profiler::isEnabled())
+		ProfilerMan.setEnabled(false);
+
 	// Make sure we do not return to the launcher if this is not possible.
 	if (!engine->hasFeature(Engine::kSupportsReturnToLauncher))
 		ConfMan.setBool("gui_return_to_launcher_at_exit", false, Common::ConfigManager::kTransientDomain);
@@ -361,12 +429,6 @@ static void setupGraphics(OSystem &system) {
 
 	system.applyBackendSettings();
 
-	// When starting up launcher for the first time, the user might have specified
-	// a --gui-theme option, to allow that option to be working, we need to initialize
-	// GUI here.
-	// FIXME: Find a nicer way to allow --gui-theme to be working
-	GUI::GuiManager::instance();
-
 	// Set initial window caption
 	system.setWindowCaption(Common::U32String(gScummVMFullVersion));
 
@@ -414,6 +476,12 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	Common::StringMap settings;
 	command = Base::parseCommandLine(settings, argc, argv);
 
+	if (settings.contains("startup-profile")) {
+		if (settings["startup-profile"] == "true")
+			s_startupProfile.start();
+		settings.erase("startup-profile"); // This option should not be passed to ConfMan.
+	}
+
 	// Load the config file (possibly overridden via command line):
 	if (settings.contains("config")) {
 		ConfMan.loadConfigFile(settings["config"]);
@@ -455,10 +523,13 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			DebugMan.enableDebugChannel(token);
 	}
 
+	s_startupProfile.endPhase("Config");
+
 	ConfMan.registerDefault("always_run_fallback_detection_extern", true);
 	PluginManager::instance().init();
  	PluginManager::instance().loadAllPlugins(); // load plugins for cached plugin manager
 	PluginManager::instance().loadDetectionPlugin(); // load detection plugin for uncached plugin manager
+	s_startupProfile.endPhase("Plugins");
 
 	// If we received an invalid music parameter via command line we check this here.
 	// We can't check this before loading the music plugins.
@@ -501,6 +572,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	// Init the backend. Must take place after all config data (including
 	// the command line params) was read.
 	system.initBackend();
+	s_startupProfile.endPhase("Backend");
 
 	// If we received an invalid graphics mode parameter via command line
 	// we check this here. We can't do it until after the backend is inited,
@@ -523,17 +595,34 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	if (settings.contains("disable-display")) {
 		ConfMan.setInt("disable-display", 1, Common::ConfigManager::kTransientDomain);
 	}
-	setupGraphics(system);
 
-	// Init the different managers that are used by the engines.
-	// Do it here to prevent fragmentation later
-	system.getAudioCDManager();
-	MusicManager::instance();
-	Common::DebugManager::instance();
+	{
+		// The GUI translation is needed from the keymapper setup on. Read it
+		// while the graphics and the event manager are being set up.
+		Common::ThreadPool pool(1);
+		Common::TaskGroup translationLoad(pool);
+#ifdef USE_TRANSLATION
+		TransMan.setLanguageAsync(ConfMan.get("gui_language"), translationLoad);
+#endif
+
+		setupGraphics(system);
+		s_startupProfile.endPhase("Graphics");
 
-	// Init the event manager. As the virtual keyboard is loaded here, it must
-	// take place after the backend is initiated and the screen has been setup
-	system.getEventManager()->init();
+		// Init the different managers that are used by the engines.
+		// Do it here to prevent fragmentation later
+		system.getAudioCDManager();
+		MusicManager::instance();
+		Common::DebugManager::instance();
+
+		// Init the event manager. As the virtual keyboard is loaded here, it must
+		// take place after the backend is initiated and the screen has been setup
+		system.getEventManager()->init();
+
+		translationLoad.wait();
+#ifdef USE_TRANSLATION
+		TransMan.finishLanguageLoad();
+#endif
+	}
 
 #ifdef ENABLE_EVENTRECORDER
 	// Directly after initializing the event manager, we will initialize our
@@ -549,6 +638,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 
 	// Now as the event manager is created, setup the keymapper
 	setupKeymapper(system);
+	s_startupProfile.endPhase("Events, keymapper");
 
 #ifdef USE_UPDATES
 	if (!ConfMan.hasKey("updates_check") && g_system->getUpdateManager()) {
@@ -599,6 +689,11 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			Common::String recordMode = ConfMan.get("record_mode");
 			Common::String recordFileName = ConfMan.get("record_file_name");
 
+			if (ConfMan.getBool("benchmark")) {
+				recordMode = "playback";
+				ConfMan.setBool("disable_display", true, Common::ConfigManager::kTransientDomain);
+			}
+
 			if (recordMode == "record") {
 				g_eventRec.init(g_eventRec.generateRecordFileName(ConfMan.getActiveDomainName()), GUI::EventRecorder::kRecorderRecord);
 			} else if (recordMode == "playback") {
@@ -615,6 +710,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				ttsMan->pushState();
 			}
 			// Try to run the game
+			s_startupProfile.endPhase("Detection");
+			s_startupProfile.report();
 			Common::Error result = runGame(plugin, enginePlugin, system, specialDebug);
 			if (ttsMan != nullptr) {
 				ttsMan->popState();
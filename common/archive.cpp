@@ -93,6 +93,12 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+
+	// The new archive gets indexed on demand
+	--it;
+	it->_order = _nextOrder++;
+	it->_indexState = kIndexPending;
+	insertSorted(_unindexed, &*it);
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -171,6 +177,7 @@ void SearchSet::addSubDirectoriesMatching(const FSNode &directory, String origPa
 void SearchSet::remove(const String &name) {
 	ArchiveNodeList::iterator it = find(name);
 	if (it != _list.end()) {
+		unindexArchive(&*it);
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
@@ -188,6 +195,8 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	_index.clear();
+	_unindexed.clear();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -201,22 +210,158 @@ void SearchSet::setPriority(const String &name, int priority) {
 		return;
 
 	Node node(*it);
+	unindexArchive(&*it);
 	_list.erase(it);
 	node._priority = priority;
 	insert(node);
 }
 
-bool SearchSet::hasFile(const Path &path) const {
-	if (path.empty())
+bool SearchSet::searchedBefore(const Node *a, const Node *b) {
+	if (a->_priority != b->_priority)
+		return a->_priority > b->_priority;
+	return a->_order < b->_order;
+}
+
+void SearchSet::insertSorted(NodeArray &nodes, const Node *node) {
+	NodeArray::iterator it = nodes.begin();
+	while (it != nodes.end() && searchedBefore(*it, node))
+		++it;
+	nodes.insert(it, node);
+}
+
+void SearchSet::removeNode(NodeArray &nodes, const Node *node) {
+	for (NodeArray::iterator it = nodes.begin(); it != nodes.end(); ++it) {
+		if (*it == node) {
+			nodes.erase(it);
+			return;
+		}
+	}
+}
+
+bool SearchSet::indexArchive(const Node *node) const {
+	assert(node->_indexState == kIndexPending);
+
+	StringArray names;
+	if (!node->_arc->listMemberNames(names)) {
+		node->_indexState = kNotIndexable;
 		return false;
+	}
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(path))
-			return true;
+	for (StringArray::const_iterator name = names.begin(); name != names.end(); ++name) {
+		MemberIndex::iterator entry = _index.find(*name);
+		if (entry == _index.end()) {
+			_index[*name] = NodeArray(1, node);
+		} else if (Common::find(entry->_value.begin(), entry->_value.end(), node) == entry->_value.end()) {
+			// Names which only differ in case are listed twice
+			insertSorted(entry->_value, node);
+		}
+	}
+
+	node->_indexState = kIndexed;
+	removeNode(_unindexed, node);
+	_archivesIndexed++;
+	return true;
+}
+
+void SearchSet::unindexArchive(const Node *node) {
+	if (node->_indexState != kIndexed) {
+		removeNode(_unindexed, node);
+		return;
+	}
+
+	// Archives which can be indexed don't change their member names
+	StringArray names;
+	node->_arc->listMemberNames(names);
+	for (StringArray::const_iterator name = names.begin(); name != names.end(); ++name) {
+		MemberIndex::iterator entry = _index.find(*name);
+		if (entry == _index.end())
+			continue;
+
+		removeNode(entry->_value, node);
+		if (entry->_value.empty())
+			_index.erase(entry);
+	}
+}
+
+template<class Lookup>
+const SearchSet::Node *SearchSet::lookup(const Path &path, Lookup &callback) const {
+	_lookups++;
+
+	String name = path.rawString();
+	MemberIndex::const_iterator indexed = _index.find(name);
+	const Node *hit = indexed != _index.end() ? indexed->_value.front() : nullptr;
+
+	// Archives which aren't indexed, but come first in search order
+	uint i = 0;
+	while (i < _unindexed.size()) {
+		const Node *node = _unindexed[i];
+		if (hit && searchedBefore(hit, node))
+			break;
+
+		if (node->_indexState == kIndexPending && indexArchive(node)) {
+			// The archive left _unindexed and may have the member
+			indexed = _index.find(name);
+			hit = indexed != _index.end() ? indexed->_value.front() : nullptr;
+			continue;
+		}
+
+		node->_lookups++;
+		if (callback(node->_arc, path))
+			return node;
+		node->_misses++;
+		i++;
+	}
+
+	if (hit) {
+		hit->_lookups++;
+		if (callback(hit->_arc, path))
+			return hit;
+		hit->_misses++;
+
+		// The member has been removed since the archive was indexed, search
+		// the other archives the slow way
+		for (ArchiveNodeList::const_iterator it = _list.begin(); it != _list.end(); ++it) {
+			if (&*it == hit)
+				continue;
+
+			it->_lookups++;
+			if (callback(it->_arc, path))
+				return &*it;
+			it->_misses++;
+		}
 	}
 
-	return false;
+	_misses++;
+	return nullptr;
+}
+
+namespace {
+
+struct HasFileLookup {
+	bool operator()(const Archive *archive, const Path &path) {
+		return archive->hasFile(path);
+	}
+};
+
+struct StreamLookup {
+	SeekableReadStream *stream;
+
+	StreamLookup() : stream(nullptr) {}
+
+	bool operator()(const Archive *archive, const Path &path) {
+		stream = archive->createReadStreamForMember(path);
+		return stream != nullptr;
+	}
+};
+
+} // End of anonymous namespace
+
+bool SearchSet::hasFile(const Path &path) const {
+	if (path.empty())
+		return false;
+
+	HasFileLookup callback;
+	return lookup(path, callback) != nullptr;
 }
 
 int SearchSet::listMatchingMembers(ArchiveMemberList &list, const Path &pattern) const {
@@ -243,27 +388,43 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path) const {
 	if (path.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(path))
-			return it->_arc->getMember(path);
-	}
+	HasFileLookup callback;
+	const Node *node = lookup(path, callback);
+	if (!node)
+		return ArchiveMemberPtr();
 
-	return ArchiveMemberPtr();
+	return node->_arc->getMember(path);
 }
 
 SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const {
 	if (path.empty())
 		return nullptr;
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		SeekableReadStream *stream = it->_arc->createReadStreamForMember(path);
-		if (stream)
-			return stream;
+	StreamLookup callback;
+	lookup(path, callback);
+	return callback.stream;
+}
+
+SearchSet::Stats SearchSet::getStats() const {
+	Stats stats;
+	stats.lookups = _lookups;
+	stats.misses = _misses;
+	stats.archivesIndexed = _archivesIndexed;
+	stats.indexedNames = _index.size();
+	return stats;
+}
+
+String SearchSet::getStatsReport() const {
+	String report = String::format("%u lookups, %u misses, %u archives indexed, %u indexed names\n",
+	                               _lookups, _misses, _archivesIndexed, _index.size());
+
+	static const char *const stateNames[] = { "not indexed yet", "indexed", "not indexable" };
+	for (ArchiveNodeList::const_iterator it = _list.begin(); it != _list.end(); ++it) {
+		report += String::format("  %s (priority %d, %s): %u lookups, %u misses\n", it->_name.c_str(), it->_priority,
+		                         stateNames[it->_indexState], it->_lookups, it->_misses);
 	}
 
-	return nullptr;
+	return report;
 }
 
 
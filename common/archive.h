@@ -24,10 +24,14 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/path.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
+#include "common/str-array.h"
 
 namespace Common {
 
@@ -138,6 +142,18 @@ public:
 	 * @return The newly created input stream.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const Path &path) const = 0;
+
+	/**
+	 * Add the names of all members, as accepted by hasFile(), to the list.
+	 * The names are raw path strings, see Path::rawString().
+	 *
+	 * This lets a SearchSet resolve names through a single index rather than
+	 * asking every archive in turn.
+	 *
+	 * @return False if the archive cannot list every name accepted by
+	 *         hasFile(), or if its members may change over time.
+	 */
+	virtual bool listMemberNames(StringArray &names) const { return false; }
 };
 
 
@@ -150,13 +166,23 @@ public:
  * priority order. In case of conflicting priorities, insertion order prevails.
  */
 class SearchSet : public Archive {
+	enum IndexState {
+		kIndexPending,		//!< The archive has not been asked for its member names yet
+		kIndexed,			//!< The member names of the archive are in the index
+		kNotIndexable		//!< The archive cannot list its member names
+	};
+
 	struct Node {
 		int		_priority;
 		String	_name;
 		Archive	*_arc;
 		bool	_autoFree;
+		uint32	_order;		//!< Insertion order, to sort nodes of the same priority
+		mutable byte	_indexState;
+		mutable uint32	_lookups;	//!< Number of times the archive was asked for a member
+		mutable uint32	_misses;	//!< Number of those the archive did not have
 		Node(int priority, const String &name, Archive *arc, bool autoFree)
-			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree) {
+			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree), _order(0), _indexState(kIndexPending), _lookups(0), _misses(0) {
 		}
 	};
 	typedef List<Node> ArchiveNodeList;
@@ -168,9 +194,45 @@ class SearchSet : public Archive {
 	void insert(const Node& node); //!< Add an archive while keeping the list sorted by descending priority.
 
 	bool _ignoreClashes;
+	uint32 _nextOrder;
+
+	typedef Array<const Node *> NodeArray;
+	typedef HashMap<String, NodeArray, IgnoreCase_Hash, IgnoreCase_EqualTo> MemberIndex;
+
+	/**
+	 * Names of the members of the indexed archives, mapped to the archives
+	 * containing them in search order.
+	 *
+	 * Archives are only indexed when a lookup would otherwise have to ask
+	 * them, so that directories are still cached on demand, and removing an
+	 * archive only removes its own names. The index is not thread-safe, like
+	 * the rest of SearchSet it must only be used from the main thread.
+	 */
+	mutable MemberIndex _index;
+	mutable NodeArray _unindexed;	//!< Archives which are not indexed (yet), in search order
+
+	mutable uint32 _lookups;
+	mutable uint32 _misses;
+	mutable uint32 _archivesIndexed;
+
+	static bool searchedBefore(const Node *a, const Node *b);
+	static void insertSorted(NodeArray &nodes, const Node *node);
+	static void removeNode(NodeArray &nodes, const Node *node);
+
+	/** Add the member names of a pending archive to the index, if it can list them. */
+	bool indexArchive(const Node *node) const;
+	/** Remove an archive from the index before it leaves the list. */
+	void unindexArchive(const Node *node);
+
+	/**
+	 * Return the first archive, in search order, for which the callback
+	 * finds the member, using the index where possible.
+	 */
+	template<class Lookup>
+	const Node *lookup(const Path &path, Lookup &callback) const;
 
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _ignoreClashes(false), _nextOrder(0), _lookups(0), _misses(0), _archivesIndexed(0) { }
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -269,6 +331,19 @@ public:
 	 * in @ref FSDirectory documentation.
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
+
+	struct Stats {
+		uint32 lookups;         ///< Members searched for
+		uint32 misses;          ///< Members not found in any archive
+		uint32 archivesIndexed; ///< Times the names of an archive were added to the index
+		uint32 indexedNames;    ///< Names in the member index
+	};
+
+	/** Return the lookup statistics since the set was created. */
+	Stats getStats() const;
+
+	/** Return a report of the lookup statistics, with the lookups and misses of every archive. */
+	String getStatsReport() const;
 };
 
 
@@ -25,6 +25,7 @@
 #include "common/debug.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/memorypool.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -72,6 +73,34 @@ static void displayCoroStats() {
 } // End of anonymous namespace
 #endif
 
+namespace {
+
+enum {
+	kContextPoolGranularity = 32,
+	kNumContextPools = 8
+};
+
+/** Pools for contexts of up to kNumContextPools * kContextPoolGranularity bytes */
+MemoryPool *s_contextPools[kNumContextPools];
+
+uint32 s_contextsPooled = 0;
+uint32 s_contextsAllocated = 0;
+
+/** Number of contexts currently allocated from the pools */
+uint32 s_contextsLive = 0;
+/** Set if the scheduler is gone and the pools should go once unused */
+bool s_releasePools = false;
+
+void releaseContextPools() {
+	for (int i = 0; i < kNumContextPools; i++) {
+		delete s_contextPools[i];
+		s_contextPools[i] = nullptr;
+	}
+	s_releasePools = false;
+}
+
+} // End of anonymous namespace
+
 CoroBaseContext::CoroBaseContext(const char *func)
 	: _line(0), _sleep(0), _subctx(nullptr) {
 #ifdef COROUTINE_DEBUG
@@ -92,6 +121,36 @@ CoroBaseContext::~CoroBaseContext() {
 	delete _subctx;
 }
 
+void *CoroBaseContext::operator new(size_t size) {
+	size_t pool = (size - 1) / kContextPoolGranularity;
+	if (pool >= kNumContextPools) {
+		s_contextsAllocated++;
+		return ::operator new(size);
+	}
+
+	if (!s_contextPools[pool])
+		s_contextPools[pool] = new MemoryPool((pool + 1) * kContextPoolGranularity);
+
+	s_contextsPooled++;
+	s_contextsLive++;
+	return s_contextPools[pool]->allocChunk();
+}
+
+void CoroBaseContext::operator delete(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	size_t pool = (size - 1) / kContextPoolGranularity;
+	if (pool >= kNumContextPools) {
+		::operator delete(ptr);
+		return;
+	}
+
+	s_contextPools[pool]->freeChunk(ptr);
+	if (--s_contextsLive == 0 && s_releasePools)
+		releaseContextPools();
+}
+
 //--------------------- Scheduler Class ------------------------
 
 CoroutineScheduler::CoroutineScheduler() {
@@ -99,15 +158,13 @@ CoroutineScheduler::CoroutineScheduler() {
 	pFreeProcesses = nullptr;
 	pCurrent = nullptr;
 
-#ifdef DEBUG
-	// diagnostic process counters
-	numProcs = 0;
-	maxProcs = 0;
-#endif
+	memset(&_stats, 0, sizeof(_stats));
 
 	pRCfunction = nullptr;
 	pidCounter = 0;
 
+	s_releasePools = false;
+
 	active = new PROCESS;
 	active->pPrevious = nullptr;
 	active->pNext = nullptr;
@@ -131,16 +188,21 @@ CoroutineScheduler::~CoroutineScheduler() {
 	active = nullptr;
 
 	// Clear the event list
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i)
-		delete *i;
+	for (EventMap::iterator i = _events.begin(); i != _events.end(); ++i)
+		delete i->_value;
+
+	// Contexts outside of processes may still be around, in which case the
+	// pools are released once the last of them is deleted
+	if (s_contextsLive == 0)
+		releaseContextPools();
+	else
+		s_releasePools = true;
 }
 
 void CoroutineScheduler::reset() {
-#ifdef DEBUG
 	// clear number of process in use
-	numProcs = 0;
-#endif
+	_stats.numProcesses = 0;
+	_activePids.clear();
 
 	if (processList == nullptr) {
 		// first time - allocate memory for process list
@@ -160,6 +222,7 @@ void CoroutineScheduler::reset() {
 	while (pProc != nullptr) {
 		delete pProc->state;
 		pProc->state = nullptr;
+		pProc->wakeTime = 0;
 		Common::fill(&pProc->pidWaiting[0], &pProc->pidWaiting[CORO_MAX_PID_WAITING], 0);
 		pProc = pProc->pNext;
 	}
@@ -178,11 +241,19 @@ void CoroutineScheduler::reset() {
 }
 
 
-#ifdef DEBUG
+CoroutineScheduler::Stats CoroutineScheduler::getStats() const {
+	Stats stats = _stats;
+	stats.contextsPooled = s_contextsPooled;
+	stats.contextsAllocated = s_contextsAllocated;
+	return stats;
+}
+
 void CoroutineScheduler::printStats() {
-	debug("%i process of %i used", maxProcs, CORO_NUM_PROCESS);
+	Stats stats = getStats();
+	debug("%d process of %d used, %d at most", stats.numProcesses, CORO_NUM_PROCESS, stats.maxProcesses);
+	debug("%d dispatches, %d skipped while sleeping", stats.dispatches, stats.sleepersSkipped);
+	debug("%d contexts pooled, %d allocated", stats.contextsPooled, stats.contextsAllocated);
 }
-#endif
 
 #ifdef DEBUG
 void CoroutineScheduler::checkStack() {
@@ -226,9 +297,14 @@ void CoroutineScheduler::schedule() {
 	while (pProc != nullptr) {
 		pNext = pProc->pNext;
 
-		if (--pProc->sleepTime <= 0) {
+		if (--pProc->sleepTime <= 0 && pProc->wakeTime && g_system->getMillis() < pProc->wakeTime) {
+			// process is parked in sleep(), check again on the next cycle
+			pProc->sleepTime = 1;
+			_stats.sleepersSkipped++;
+		} else if (pProc->sleepTime <= 0) {
 			// process is ready for dispatch, activate it
 			pCurrent = pProc;
+			_stats.dispatches++;
 			pProc->coroAddr(pProc->state, pProc->param);
 
 			if (!pProc->state || pProc->state->_sleep <= 0) {
@@ -248,13 +324,13 @@ void CoroutineScheduler::schedule() {
 	}
 
 	// Disable any events that were pulsed
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pulsing) {
+	for (uint i = 0; i < _pulsedEvents.size(); ++i) {
+		EVENT *evt = getEvent(_pulsedEvents[i]);
+		if (evt && evt->pulsing) {
 			evt->pulsing = evt->signalled = false;
 		}
 	}
+	_pulsedEvents.clear();
 }
 
 void CoroutineScheduler::rescheduleAll() {
@@ -348,7 +424,7 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 
 	CORO_BEGIN_CONTEXT;
 		uint32 endTime;
-		PROCESS *pProcess;
+		bool processActive;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -365,12 +441,12 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() <= _ctx->endTime) {
 		// Check to see if a process or event with the given Id exists
-		_ctx->pProcess = getProcess(pid);
-		_ctx->pEvent = !_ctx->pProcess ? getEvent(pid) : nullptr;
+		_ctx->processActive = isProcessActive(pid);
+		_ctx->pEvent = !_ctx->processActive ? getEvent(pid) : nullptr;
 
 		// If there's no active process or event, presume it's a process that's finished,
 		// so the waiting can immediately exit
-		if ((_ctx->pProcess == nullptr) && (_ctx->pEvent == nullptr)) {
+		if (!_ctx->processActive && (_ctx->pEvent == nullptr)) {
 			if (expired)
 				*expired = false;
 			break;
@@ -408,7 +484,7 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		bool signalled;
 		bool pidSignalled;
 		int i;
-		PROCESS *pProcess;
+		bool processActive;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -428,11 +504,11 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		_ctx->signalled = bWaitAll;
 
 		for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
-			_ctx->pProcess = getProcess(pidList[_ctx->i]);
-			_ctx->pEvent = !_ctx->pProcess ? getEvent(pidList[_ctx->i]) : nullptr;
+			_ctx->processActive = isProcessActive(pidList[_ctx->i]);
+			_ctx->pEvent = !_ctx->processActive ? getEvent(pidList[_ctx->i]) : nullptr;
 
 			// Determine the signalled state
-			_ctx->pidSignalled = (_ctx->pProcess) || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
+			_ctx->pidSignalled = (_ctx->processActive) || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
 
 			if (bWaitAll && !_ctx->pidSignalled)
 				_ctx->signalled = false;
@@ -471,20 +547,24 @@ void CoroutineScheduler::sleep(CORO_PARAM, uint32 duration) {
 
 	CORO_BEGIN_CONTEXT;
 		uint32 endTime;
-		PROCESS *pProcess;
-		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
 	CORO_BEGIN_CODE(_ctx);
 
 	_ctx->endTime = g_system->getMillis() + duration;
 
+	// Park the process, so that schedule() does not dispatch it again before
+	// the time is up instead of running the whole chain of callers each cycle
+	pCurrent->wakeTime = _ctx->endTime;
+
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() < _ctx->endTime) {
 		// Sleep until the next cycle
 		CORO_SLEEP(1);
 	}
 
+	pCurrent->wakeTime = 0;
+
 	CORO_END_CODE;
 }
 
@@ -497,11 +577,9 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 	// trap no free process
 	assert(pProc != nullptr); // Out of processes
 
-#ifdef DEBUG
 	// one more process in use
-	if (++numProcs > maxProcs)
-		maxProcs = numProcs;
-#endif
+	if (++_stats.numProcesses > _stats.maxProcesses)
+		_stats.maxProcesses = _stats.numProcesses;
 
 	// get link to next free process
 	pFreeProcesses = pProc->pNext;
@@ -536,9 +614,11 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 
 	// wake process up as soon as possible
 	pProc->sleepTime = 1;
+	pProc->wakeTime = 0;
 
 	// set new process id
 	pProc->pid = pid;
+	addActivePid(pid);
 
 	// set new process specific info
 	if (sizeParam) {
@@ -568,11 +648,10 @@ void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 	// can not kill the current process using killProcess !
 	assert(pCurrent != pKillProc);
 
-#ifdef DEBUG
 	// one less process in use
-	--numProcs;
-	assert(numProcs >= 0);
-#endif
+	assert(_stats.numProcesses > 0);
+	--_stats.numProcesses;
+	removeActivePid(pKillProc->pid);
 
 	// Free process' resources
 	if (pRCfunction != nullptr)
@@ -622,6 +701,7 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 			if (pProc != pCurrent) {
 				// kill this process
 				numKilled++;
+				removeActivePid(pProc->pid);
 
 				// Free the process' resources
 				if (pRCfunction != nullptr)
@@ -649,11 +729,9 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 		}
 	}
 
-#ifdef DEBUG
 	// adjust process in use
-	numProcs -= numKilled;
-	assert(numProcs >= 0);
-#endif
+	assert(_stats.numProcesses >= (uint32)numKilled);
+	_stats.numProcesses -= numKilled;
 
 	// return number of processes killed
 	return numKilled;
@@ -663,23 +741,24 @@ void CoroutineScheduler::setResourceCallback(VFPTRPP pFunc) {
 	pRCfunction = pFunc;
 }
 
-PROCESS *CoroutineScheduler::getProcess(uint32 pid) {
-	PROCESS *pProc = active->pNext;
-	while ((pProc != nullptr) && (pProc->pid != pid))
-		pProc = pProc->pNext;
-
-	return pProc;
+bool CoroutineScheduler::isProcessActive(uint32 pid) const {
+	return _activePids.contains(pid);
 }
 
 EVENT *CoroutineScheduler::getEvent(uint32 pid) {
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pid == pid)
-			return evt;
-	}
+	EventMap::iterator i = _events.find(pid);
+	return (i != _events.end()) ? i->_value : nullptr;
+}
+
+void CoroutineScheduler::addActivePid(uint32 pid) {
+	_activePids[pid]++;
+}
 
-	return nullptr;
+void CoroutineScheduler::removeActivePid(uint32 pid) {
+	PidCountMap::iterator i = _activePids.find(pid);
+	assert(i != _activePids.end());
+	if (--i->_value == 0)
+		_activePids.erase(i);
 }
 
 
@@ -690,14 +769,14 @@ uint32 CoroutineScheduler::createEvent(bool bManualReset, bool bInitialState) {
 	evt->signalled = bInitialState;
 	evt->pulsing = false;
 
-	_events.push_back(evt);
+	_events[evt->pid] = evt;
 	return evt->pid;
 }
 
 void CoroutineScheduler::closeEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
 	if (evt) {
-		_events.remove(evt);
+		_events.erase(pidEvent);
 		delete evt;
 	}
 }
@@ -722,6 +801,7 @@ void CoroutineScheduler::pulseEvent(uint32 pidEvent) {
 	// Set the event as signalled and pulsing
 	evt->signalled = true;
 	evt->pulsing = true;
+	_pulsedEvents.push_back(pidEvent);
 
 	// If there's an active process, and it's not the first in the queue, then reschedule all
 	// the other prcoesses in the queue to run again this frame
@@ -25,6 +25,8 @@
 
 #include "common/scummsys.h"
 #include "common/util.h"    // for SCUMMVM_CURRENT_FUNCTION
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/singleton.h"
 
@@ -68,6 +70,13 @@ struct CoroBaseContext {
 	 * Destructor for coroutine context.
 	 */
 	virtual ~CoroBaseContext();
+
+	/**
+	 * Contexts are created for every coroutine invocation which yields,
+	 * so they are allocated from size-bucketed memory pools.
+	 */
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
 };
 
 typedef CoroBaseContext *CoroContext;
@@ -306,6 +315,7 @@ struct PROCESS {
 	CORO_ADDR  coroAddr;    ///< Entry point of the coroutine.
 
 	int sleepTime;      ///< Number of scheduler cycles to sleep.
+	uint32 wakeTime;    ///< If set, the process is not dispatched before this time (in milliseconds).
 	uint32 pid;         ///< Process ID.
 	uint32 pidWaiting[CORO_MAX_PID_WAITING];    ///< Process ID(s) that the process is currently waiting on.
 	char param[CORO_PARAM_SIZE];    ///< Process-specific information.
@@ -359,14 +369,33 @@ private:
 	/** Auto-incrementing process ID. */
 	int pidCounter;
 
-	/** Event list. */
-	Common::List<EVENT *> _events;
+	typedef HashMap<uint32, EVENT *> EventMap;
+	typedef HashMap<uint32, uint> PidCountMap;
 
-#ifdef DEBUG
-	/** Diagnostic process counters. */
-	int numProcs;
-	int maxProcs;
+	/** Events indexed by their ID. */
+	EventMap _events;
+
+	/** Events pulsed during the current tick, which are reset by schedule(). */
+	Array<uint32> _pulsedEvents;
 
+	/** Number of active processes per process ID. */
+	PidCountMap _activePids;
+
+public:
+	/** Scheduler statistics. */
+	struct Stats {
+		uint32 numProcesses;        ///< Processes currently active
+		uint32 maxProcesses;        ///< Maximum number of processes active at once
+		uint32 dispatches;          ///< Number of times a process was run
+		uint32 sleepersSkipped;     ///< Number of times a sleeping process was not run
+		uint32 contextsPooled;      ///< Coroutine contexts allocated from the pools
+		uint32 contextsAllocated;   ///< Coroutine contexts too large for the pools
+	};
+
+private:
+	Stats _stats;
+
+#ifdef DEBUG
 	/**
 	 * Check both the active and free process list to ensure that all links are valid,
 	 * and that no processes have been lost.
@@ -380,20 +409,26 @@ private:
 	 */
 	VFPTRPP pRCfunction;
 
-	PROCESS *getProcess(uint32 pid);
+	bool isProcessActive(uint32 pid) const;
 	EVENT *getEvent(uint32 pid);
+
+	void addActivePid(uint32 pid);
+	void removeActivePid(uint32 pid);
 public:
 	/**
 	 * Kill all processes and place them on the free list.
 	 */
 	void reset();
 
-#ifdef DEBUG
 	/**
-	 * Show the maximum number of processes used at once.
+	 * Return the scheduler statistics.
+	 */
+	Stats getStats() const;
+
+	/**
+	 * Show the scheduler statistics.
 	 */
 	void printStats();
-#endif
 
 	/**
 	 * Give all active processes a chance to run.
@@ -444,7 +479,8 @@ public:
 	 *
 	 * @param duration      Duration in milliseconds
 	 * @remarks     This duration is not precise, since it relies on the frequency the
-	 *              scheduler is called.
+	 *              scheduler is called. The process is not dispatched again
+	 *              until the duration has passed.
 	 */
 	void sleep(CORO_PARAM, uint32 duration);
 
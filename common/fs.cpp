@@ -391,5 +391,18 @@ int FSDirectory::listMembers(ArchiveMemberList &list) const {
 	return files;
 }
 
+bool FSDirectory::listMemberNames(StringArray &names) const {
+	if (!_node.isDirectory())
+		return true;
+
+	// Cache dir data
+	ensureCached();
+
+	for (NodeCache::const_iterator it = _fileCache.begin(); it != _fileCache.end(); ++it)
+		names.push_back(it->_key);
+
+	return true;
+}
+
 
 } // End of namespace Common
@@ -394,6 +394,11 @@ public:
 	 * for success.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const Path &path) const;
+
+	/**
+	 * Return the relative paths of all the files in the cache.
+	 */
+	virtual bool listMemberNames(StringArray &names) const;
 };
 
 /** @} */
@@ -0,0 +1,312 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/lz4.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+namespace {
+
+const uint32 kLZ4StreamHeader = MKTAG('L', 'Z', '4', 'S');
+const uint32 kBlockSize = 64 * 1024;
+
+const uint32 kMinMatch = 4;
+const uint32 kLastLiterals = 5;     ///< The block always ends with literals
+const uint32 kMatchSearchEnd = 12;  ///< No match starts this close to the end
+const uint32 kHashBits = 12;
+
+uint32 hashSequence(uint32 sequence) {
+	return (sequence * 2654435761U) >> (32 - kHashBits);
+}
+
+void writeLength(byte *&dst, uint32 length) {
+	for (; length >= 255; length -= 255)
+		*dst++ = 255;
+	*dst++ = length;
+}
+
+bool readLength(const byte *&src, const byte *srcEnd, uint32 &length) {
+	byte b;
+	do {
+		if (src == srcEnd)
+			return false;
+		b = *src++;
+		length += b;
+	} while (b == 255);
+	return true;
+}
+
+} // End of anonymous namespace
+
+uint32 lz4CompressBound(uint32 srcLen) {
+	return srcLen + srcLen / 255 + 16;
+}
+
+uint32 lz4Compress(byte *dst, const byte *src, uint32 srcLen) {
+	assert(srcLen <= kBlockSize);
+
+	uint16 table[1 << kHashBits];
+	memset(table, 0, sizeof(table));
+
+	byte *out = dst;
+	uint32 anchor = 0;
+	uint32 ip = 1;
+
+	while (srcLen >= kMatchSearchEnd && ip < srcLen - kMatchSearchEnd) {
+		uint32 sequence = READ_UINT32(src + ip);
+		uint32 hash = hashSequence(sequence);
+		uint32 ref = table[hash];
+		table[hash] = ip;
+
+		if (READ_UINT32(src + ref) != sequence) {
+			// Skip faster through data which does not compress
+			ip += 1 + ((ip - anchor) >> 6);
+			continue;
+		}
+
+		// Extend the match backward over pending literals, then forward
+		while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+			ip--;
+			ref--;
+		}
+		uint32 matchLength = kMinMatch;
+		while (ip + matchLength < srcLen - kLastLiterals && src[ip + matchLength] == src[ref + matchLength])
+			matchLength++;
+
+		uint32 literals = ip - anchor;
+		byte *token = out++;
+		*token = MIN<uint32>(literals, 15) << 4;
+		if (literals >= 15)
+			writeLength(out, literals - 15);
+		memcpy(out, src + anchor, literals);
+		out += literals;
+
+		WRITE_LE_UINT16(out, ip - ref);
+		out += 2;
+
+		*token |= MIN<uint32>(matchLength - kMinMatch, 15);
+		if (matchLength - kMinMatch >= 15)
+			writeLength(out, matchLength - kMinMatch - 15);
+
+		ip += matchLength;
+		anchor = ip;
+	}
+
+	uint32 literals = srcLen - anchor;
+	*out++ = MIN<uint32>(literals, 15) << 4;
+	if (literals >= 15)
+		writeLength(out, literals - 15);
+	memcpy(out, src + anchor, literals);
+	out += literals;
+
+	return out - dst;
+}
+
+bool lz4Decompress(byte *dst, uint32 dstLen, const byte *src, uint32 srcLen) {
+	const byte *srcEnd = src + srcLen;
+	byte *out = dst;
+	byte *outEnd = dst + dstLen;
+
+	while (src < srcEnd) {
+		byte token = *src++;
+
+		uint32 literals = token >> 4;
+		if (literals == 15 && !readLength(src, srcEnd, literals))
+			return false;
+		if (literals > (uint32)(srcEnd - src) || literals > (uint32)(outEnd - out))
+			return false;
+		memcpy(out, src, literals);
+		src += literals;
+		out += literals;
+
+		// The last sequence has no match
+		if (src == srcEnd)
+			break;
+
+		if (srcEnd - src < 2)
+			return false;
+		uint32 offset = READ_LE_UINT16(src);
+		src += 2;
+		if (offset == 0 || offset > (uint32)(out - dst))
+			return false;
+
+		uint32 matchLength = token & 15;
+		if (matchLength == 15 && !readLength(src, srcEnd, matchLength))
+			return false;
+		matchLength += kMinMatch;
+		if (matchLength > (uint32)(outEnd - out))
+			return false;
+
+		// The match may overlap the bytes being written
+		const byte *match = out - offset;
+		for (uint32 i = 0; i < matchLength; i++)
+			out[i] = match[i];
+		out += matchLength;
+	}
+
+	return out == outEnd;
+}
+
+namespace {
+
+/**
+ * Stream compressing blocks of data with LZ4. Each block is written as its
+ * uncompressed and compressed sizes, followed by the data, which is stored
+ * as is when it does not compress. A block with an uncompressed size of 0
+ * ends the stream.
+ */
+class LZ4WriteStream : public WriteStream {
+public:
+	LZ4WriteStream(WriteStream *w) : _wrapped(w), _bufferSize(0), _pos(0), _finalized(false) {
+		assert(w);
+		_wrapped->writeUint32BE(kLZ4StreamHeader);
+	}
+
+	~LZ4WriteStream() {
+		finalize();
+	}
+
+	bool err() const override { return _wrapped->err(); }
+	void clearErr() override { _wrapped->clearErr(); }
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		assert(!_finalized);
+
+		const byte *data = (const byte *)dataPtr;
+		uint32 left = dataSize;
+		while (left) {
+			uint32 len = MIN(left, kBlockSize - _bufferSize);
+			memcpy(_buffer + _bufferSize, data, len);
+			_bufferSize += len;
+			data += len;
+			left -= len;
+
+			if (_bufferSize == kBlockSize)
+				writeBlock();
+		}
+
+		_pos += dataSize;
+		return dataSize;
+	}
+
+	void finalize() override {
+		if (_finalized)
+			return;
+
+		writeBlock();
+		_wrapped->writeUint32LE(0);
+		_wrapped->finalize();
+		_finalized = true;
+	}
+
+	int64 pos() const override { return _pos; }
+
+private:
+	void writeBlock() {
+		if (!_bufferSize)
+			return;
+
+		uint32 compressedSize = lz4Compress(_compressed, _buffer, _bufferSize);
+		_wrapped->writeUint32LE(_bufferSize);
+		if (compressedSize < _bufferSize) {
+			_wrapped->writeUint32LE(compressedSize);
+			_wrapped->write(_compressed, compressedSize);
+		} else {
+			_wrapped->writeUint32LE(_bufferSize);
+			_wrapped->write(_buffer, _bufferSize);
+		}
+		_bufferSize = 0;
+	}
+
+	ScopedPtr<WriteStream> _wrapped;
+	byte _buffer[kBlockSize];
+	byte _compressed[kBlockSize + kBlockSize / 255 + 16];
+	uint32 _bufferSize;
+	uint32 _pos;
+	bool _finalized;
+};
+
+} // End of anonymous namespace
+
+SeekableReadStream *wrapLZ4ReadStream(SeekableReadStream *toBeWrapped) {
+	if (!toBeWrapped)
+		return nullptr;
+
+	int64 start = toBeWrapped->pos();
+	if (toBeWrapped->size() - start < 4 || toBeWrapped->readUint32BE() != kLZ4StreamHeader) {
+		toBeWrapped->seek(start, SEEK_SET);
+		return toBeWrapped;
+	}
+
+	ScopedPtr<SeekableReadStream> stream(toBeWrapped);
+	MemoryWriteStreamDynamic out(DisposeAfterUse::NO);
+	byte *compressed = (byte *)malloc(kBlockSize);
+	byte *block = (byte *)malloc(kBlockSize);
+	bool success = false;
+
+	for (;;) {
+		uint32 size = stream->readUint32LE();
+		if (stream->eos() || stream->err() || size > kBlockSize)
+			break;
+
+		if (!size) {
+			success = true;
+			break;
+		}
+
+		uint32 compressedSize = stream->readUint32LE();
+		if (compressedSize > size || stream->read(compressed, compressedSize) != compressedSize)
+			break;
+
+		if (compressedSize == size) {
+			out.write(compressed, size);
+		} else {
+			if (!lz4Decompress(block, size, compressed, compressedSize))
+				break;
+			out.write(block, size);
+		}
+	}
+
+	free(compressed);
+	free(block);
+
+	if (!success) {
+		warning("wrapLZ4ReadStream: Invalid compressed data");
+		free(out.getData());
+		return nullptr;
+	}
+
+	return new MemoryReadStream(out.getData(), out.size(), DisposeAfterUse::YES);
+}
+
+WriteStream *wrapLZ4WriteStream(WriteStream *toBeWrapped) {
+	if (!toBeWrapped)
+		return nullptr;
+	return new LZ4WriteStream(toBeWrapped);
+}
+
+} // End of namespace Common
@@ -0,0 +1,90 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_LZ4_H
+#define COMMON_LZ4_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_lz4 LZ4
+ * @ingroup common
+ *
+ * @brief Fast compression in the LZ4 block format.
+ *
+ * The compressor is a simple greedy one, which trades compression ratio
+ * for speed: it is meant for save files, where zlib can take long enough
+ * to cause a noticeable hitch. It does not depend on any library.
+ *
+ * Compressed streams start with a 4-byte header, followed by blocks of at
+ * most 64 KB of uncompressed data, each compressed independently.
+ * @{
+ */
+
+class SeekableReadStream;
+class WriteStream;
+
+/** Return the maximum size of the compressed data of srcLen bytes. */
+uint32 lz4CompressBound(uint32 srcLen);
+
+/**
+ * Compress a block of at most 64 KB in the LZ4 block format.
+ *
+ * @param dst  Buffer of at least lz4CompressBound(srcLen) bytes.
+ * @return     The size of the compressed data.
+ */
+uint32 lz4Compress(byte *dst, const byte *src, uint32 srcLen);
+
+/**
+ * Decompress a block in the LZ4 block format.
+ *
+ * @return True if the block decompressed to exactly dstLen bytes.
+ */
+bool lz4Decompress(byte *dst, uint32 dstLen, const byte *src, uint32 srcLen);
+
+/**
+ * Take an arbitrary SeekableReadStream and decompress it if it starts with
+ * the header of LZ4 compressed streams. Otherwise, the stream is returned
+ * unmodified.
+ *
+ * The stream is decompressed into memory at once. If the compressed data
+ * is invalid, NULL is returned. In both cases, the passed stream is deleted.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ */
+SeekableReadStream *wrapLZ4ReadStream(SeekableReadStream *toBeWrapped);
+
+/**
+ * Take an arbitrary WriteStream and wrap it in a custom stream which
+ * compresses the data with LZ4. The created stream becomes responsible for
+ * freeing the passed stream.
+ */
+WriteStream *wrapLZ4WriteStream(WriteStream *toBeWrapped);
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -21,6 +21,7 @@ MODULE_OBJS := \
 	json.o \
 	language.o \
 	localization.o \
+	lz4.o \
 	macresman.o \
 	memorypool.o \
 	md5.o \
@@ -29,6 +30,7 @@ MODULE_OBJS := \
 	osd_message_queue.o \
 	path.o \
 	platform.o \
+	profiler.o \
 	punycode.o \
 	quicktime.o \
 	random.o \
@@ -43,6 +45,7 @@ MODULE_OBJS := \
 	stuffit.o \
 	system.o \
 	textconsole.o \
+	threadpool.o \
 	text-to-speech.o \
 	tokenizer.o \
 	translation.o \
@@ -0,0 +1,225 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/profiler.h"
+#include "common/algorithm.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/stream.h"
+#include "common/ustr.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+bool Profiler::_enabled = false;
+
+namespace {
+
+/** Number of zones listed in the overlay */
+const uint kSummaryZones = 4;
+
+struct ZoneTotal {
+	String name;
+	uint64 total;
+};
+
+bool greaterTotal(const ZoneTotal &a, const ZoneTotal &b) {
+	return a.total > b.total;
+}
+
+String escapeJSON(const char *str) {
+	String result;
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			result += '\\';
+		result += *str;
+	}
+	return result;
+}
+
+} // End of anonymous namespace
+
+Profiler::Profiler() : _currentFrame(0), _numFrames(0), _droppedZones(0), _overlayVisible(false), _lastOverlayUpdate(0) {
+	for (uint i = 0; i < kNumFrames; i++)
+		_frames[i].start = _frames[i].end = 0;
+}
+
+void Profiler::setEnabled(bool enabled) {
+	if (enabled == _enabled)
+		return;
+
+	if (enabled) {
+		StackLock lock(_mutex);
+		_currentFrame = 0;
+		_numFrames = 0;
+		_droppedZones = 0;
+		_frames[0].start = g_system->getMicros();
+		_frames[0].zones.resize(0);
+	} else {
+		setOverlayVisible(false);
+	}
+
+	_enabled = enabled;
+}
+
+void Profiler::setOverlayVisible(bool visible) {
+	_overlayVisible = visible;
+	_lastOverlayUpdate = 0;
+
+	if (visible)
+		setEnabled(true);
+}
+
+void Profiler::addZone(const char *name, uint64 start, uint64 end, ProfileTrack track) {
+	StackLock lock(_mutex);
+
+	Array<Zone> &zones = _frames[_currentFrame].zones;
+	if (zones.size() >= kMaxZonesPerFrame) {
+		_droppedZones++;
+		return;
+	}
+
+	Zone zone;
+	zone.name = name;
+	zone.start = start;
+	zone.duration = (uint32)(end - start);
+	zone.track = track;
+	zones.push_back(zone);
+}
+
+void Profiler::endFrame() {
+	if (!_enabled)
+		return;
+
+	uint64 now = g_system->getMicros();
+
+	{
+		StackLock lock(_mutex);
+
+		_frames[_currentFrame].end = now;
+		_currentFrame = (_currentFrame + 1) % kNumFrames;
+		if (_numFrames < kNumFrames - 1)
+			_numFrames++;
+
+		// Keep the zone storage of the recycled frame
+		Frame &frame = _frames[_currentFrame];
+		frame.start = now;
+		frame.end = 0;
+		frame.zones.resize(0);
+	}
+
+	if (_overlayVisible && now - _lastOverlayUpdate >= 1000000) {
+		_lastOverlayUpdate = now;
+		updateOverlay();
+	}
+}
+
+const Profiler::Frame &Profiler::getFrame(uint frame) const {
+	assert(frame < _numFrames);
+	return _frames[(_currentFrame + kNumFrames - 1 - frame) % kNumFrames];
+}
+
+uint Profiler::getNumFrames() {
+	StackLock lock(_mutex);
+	return _numFrames;
+}
+
+uint32 Profiler::getFrameTime(uint frame) {
+	StackLock lock(_mutex);
+	const Frame &f = getFrame(frame);
+	return (uint32)(f.end - f.start);
+}
+
+String Profiler::getSummary() {
+	StackLock lock(_mutex);
+
+	if (!_numFrames)
+		return "No frames recorded";
+
+	uint64 totalTime = 0;
+	uint32 maxTime = 0;
+	HashMap<String, uint64> zoneTotals;
+
+	for (uint i = 0; i < _numFrames; i++) {
+		const Frame &frame = getFrame(i);
+		uint32 frameTime = (uint32)(frame.end - frame.start);
+		totalTime += frameTime;
+		maxTime = MAX(maxTime, frameTime);
+
+		for (uint j = 0; j < frame.zones.size(); j++) {
+			if (frame.zones[j].track == kProfileTrackMain)
+				zoneTotals[frame.zones[j].name] += frame.zones[j].duration;
+		}
+	}
+
+	Array<ZoneTotal> zones;
+	for (HashMap<String, uint64>::const_iterator i = zoneTotals.begin(); i != zoneTotals.end(); ++i) {
+		ZoneTotal zone;
+		zone.name = i->_key;
+		zone.total = i->_value;
+		zones.push_back(zone);
+	}
+	sort(zones.begin(), zones.end(), greaterTotal);
+
+	String summary = String::format("Frame: %.2f ms avg, %.2f ms max",
+	                                totalTime / 1000.0 / _numFrames, maxTime / 1000.0);
+	for (uint i = 0; i < zones.size() && i < kSummaryZones; i++)
+		summary += String::format("\n%s: %.2f ms", zones[i].name.c_str(), zones[i].total / 1000.0 / _numFrames);
+
+	return summary;
+}
+
+void Profiler::updateOverlay() {
+	g_system->displayMessageOnOSD(U32String(getSummary()));
+}
+
+void Profiler::exportChromeTrace(WriteStream &stream) {
+	static const char *const trackNames[] = { "Main", "Audio", "Worker" };
+
+	StackLock lock(_mutex);
+
+	stream.writeString("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	for (uint i = 0; i < ARRAYSIZE(trackNames); i++) {
+		stream.writeString(String::format("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}},\n",
+		                                  i, trackNames[i]));
+	}
+
+	// Oldest frame first
+	for (uint i = _numFrames; i-- > 0;) {
+		const Frame &frame = getFrame(i);
+		stream.writeString(String::format("{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%u},\n",
+		                                  kProfileTrackMain, (unsigned long long)frame.start, (uint32)(frame.end - frame.start)));
+
+		for (uint j = 0; j < frame.zones.size(); j++) {
+			const Zone &zone = frame.zones[j];
+			stream.writeString(String::format("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%u},\n",
+			                                  escapeJSON(zone.name).c_str(), zone.track, (unsigned long long)zone.start, zone.duration));
+		}
+	}
+
+	// Closing metadata event, which avoids dealing with the trailing comma
+	stream.writeString(String::format("{\"name\":\"dropped_zones\",\"ph\":\"M\",\"pid\":1,\"args\":{\"count\":%u}}\n]}\n", _droppedZones));
+}
+
+} // End of namespace Common
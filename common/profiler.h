@@ -0,0 +1,176 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "common/system.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_profiler Frame profiler
+ * @ingroup common
+ *
+ * @brief Lightweight profiler recording timed zones of the last frames.
+ *
+ * Zones are recorded with Common::ProfileZone, and a frame ends with every
+ * call to OSystem::updateScreen(). The recorded frames can be exported in
+ * the Chrome trace event format (for chrome://tracing or Perfetto) with
+ * the "profiler" debugger command, and a summary is shown on the OSD when
+ * the profiler is toggled with the global keymap.
+ *
+ * While the profiler is disabled, a zone costs a single flag test.
+ * @{
+ */
+
+class WriteStream;
+
+#define ProfilerMan Common::Profiler::instance()
+
+/** The track a zone is shown on in the exported trace. */
+enum ProfileTrack {
+	kProfileTrackMain = 0,      ///< Engine and GUI thread
+	kProfileTrackAudio = 1,     ///< Mixer callback
+	kProfileTrackWorker = 2     ///< Thread pool workers
+};
+
+class Profiler : public Singleton<Profiler> {
+public:
+	enum {
+		kNumFrames = 128,           ///< Number of frames kept
+		kMaxZonesPerFrame = 4096    ///< Further zones of a frame are dropped
+	};
+
+	/** Return true if zones are being recorded. */
+	static bool isEnabled() { return _enabled; }
+
+	/** Start or stop recording. Starting discards previously recorded frames. */
+	void setEnabled(bool enabled);
+
+	/**
+	 * Show a summary of the recorded frames on the OSD, updated every second.
+	 * Showing the overlay enables the profiler.
+	 */
+	void setOverlayVisible(bool visible);
+	bool isOverlayVisible() const { return _overlayVisible; }
+
+	/**
+	 * Record a finished zone in the current frame. This may be called from
+	 * any thread. Times are in microseconds, as returned by OSystem::getMicros().
+	 */
+	void addZone(const char *name, uint64 start, uint64 end, ProfileTrack track);
+
+	/** Finish the current frame and start the next one. */
+	void endFrame();
+
+	/** Return the number of completely recorded frames. */
+	uint getNumFrames();
+
+	/**
+	 * Return the duration in microseconds of a recorded frame.
+	 *
+	 * @param frame  Index of the frame, 0 being the last finished frame.
+	 */
+	uint32 getFrameTime(uint frame);
+
+	/** Return a few lines summarizing frame times and the most expensive zones. */
+	String getSummary();
+
+	/** Write the recorded frames as a Chrome trace JSON document. */
+	void exportChromeTrace(WriteStream &stream);
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	Profiler();
+
+	struct Zone {
+		const char *name;
+		uint64 start;
+		uint32 duration;
+		ProfileTrack track;
+	};
+
+	struct Frame {
+		uint64 start;
+		uint64 end;
+		Array<Zone> zones;
+	};
+
+	const Frame &getFrame(uint frame) const;
+	void updateOverlay();
+
+	static bool _enabled;
+
+	Mutex _mutex;                   ///< Protects the frames
+	Frame _frames[kNumFrames];      ///< Ring buffer of frames
+	uint _currentFrame;             ///< Index of the frame being recorded
+	uint _numFrames;                ///< Number of finished frames in the ring
+	uint32 _droppedZones;
+
+	bool _overlayVisible;
+	uint64 _lastOverlayUpdate;
+};
+
+/**
+ * Record the time between construction and destruction as a zone of the
+ * current frame.
+ *
+ * @code
+ * void Foo::draw() {
+ *     Common::ProfileZone zone("Foo::draw");
+ *     ...
+ * }
+ * @endcode
+ */
+class ProfileZone {
+public:
+	/**
+	 * @param name   Name of the zone. It must be a string literal, or
+	 *               otherwise outlive the profiler.
+	 * @param track  Track of the zone in the exported trace.
+	 */
+	explicit ProfileZone(const char *name, ProfileTrack track = kProfileTrackMain) : _name(name), _track(track), _start(0) {
+		if (Profiler::isEnabled())
+			_start = g_system->getMicros();
+	}
+
+	~ProfileZone() {
+		if (_start && Profiler::isEnabled())
+			ProfilerMan.addZone(_name, _start, g_system->getMicros(), _track);
+	}
+
+private:
+	const char *_name;
+	ProfileTrack _track;
+	uint64 _start;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -277,6 +277,30 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Check whether the given save file is still being written in the
+	 * background.
+	 *
+	 * When the "save_async" setting is enabled, OutSaveFile::finalize()
+	 * returns as soon as the data is in memory, and the save file is
+	 * compressed and written by a worker thread. OutSaveFile::err() does
+	 * not wait for it, so it only reports the write errors which already
+	 * occurred. Any write error is shown on the OSD, and reported through
+	 * getError() once the save is waited for or found not to be pending.
+	 *
+	 * @param name Name of the save file.
+	 *
+	 * @return true if the save file is not stored yet. false otherwise.
+	 */
+	virtual bool isSavePending(const String &name) { return false; }
+
+	/**
+	 * Wait until all the save files written in the background are stored.
+	 *
+	 * @return true if no error occurred. false otherwise.
+	 */
+	virtual bool waitForPendingSaves() { return true; }
 };
 
 /** @} */
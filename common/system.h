@@ -1358,6 +1358,14 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get the number of microseconds since the program was started.
+	 *
+	 * This is meant for profiling, and is never recorded by the event
+	 * recorder. The default implementation is based on getMillis().
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1479,6 +1487,69 @@ public:
 
 
 
+	/**
+	 * @defgroup common_system_thread Worker threads
+	 * @ingroup common_system
+	 * @{
+	 *
+	 * Optional support for background worker threads, used by
+	 * Common::ThreadPool. Worker threads must not call into the graphics,
+	 * event or audio APIs of OSystem; they are meant for pure computation
+	 * and for file I/O.
+	 *
+	 * Backends without thread support keep the default implementations,
+	 * in which case createThread() fails and all work is done synchronously
+	 * by the caller.
+	 */
+
+	typedef struct OpaqueThread *ThreadRef;
+	typedef struct OpaqueSemaphore *SemaphoreRef;
+	typedef void (*ThreadProc)(void *param);
+
+	/**
+	 * Return the number of processors available to run threads on.
+	 */
+	virtual uint getNumProcessors() { return 1; }
+
+	/**
+	 * Start a new thread running the given procedure.
+	 *
+	 * @return The new thread, or 0 if threads are not supported or an
+	 *         error occurred.
+	 */
+	virtual ThreadRef createThread(ThreadProc proc, void *param) { return 0; }
+
+	/**
+	 * Wait for the given thread to finish and release it.
+	 */
+	virtual void joinThread(ThreadRef thread) {}
+
+	/**
+	 * Create a new counting semaphore.
+	 *
+	 * @return The newly created semaphore, or 0 if an error occurred.
+	 */
+	virtual SemaphoreRef createSemaphore(uint initialValue) { return 0; }
+
+	/**
+	 * Block until the semaphore count is positive, then decrement it.
+	 */
+	virtual void waitSemaphore(SemaphoreRef semaphore) {}
+
+	/**
+	 * Increment the semaphore count, waking up one waiting thread.
+	 */
+	virtual void signalSemaphore(SemaphoreRef semaphore) {}
+
+	/**
+	 * Delete the given semaphore. No thread may be waiting on it.
+	 */
+	virtual void deleteSemaphore(SemaphoreRef semaphore) {}
+
+	/** @} */
+
+
+
 	/** @defgroup common_system_sound Sound
 	 *  @ingroup common_system
 	 *  @{
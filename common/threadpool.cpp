@@ -0,0 +1,276 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/threadpool.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+TaskGroup::TaskGroup(ThreadPool &pool) : _pool(pool), _pending(0), _finished(0) {
+	if (_pool.getNumWorkers()) {
+		_finished = g_system->createSemaphore(0);
+		if (!_finished)
+			warning("TaskGroup: Could not create a semaphore, running tasks synchronously");
+	}
+}
+
+TaskGroup::~TaskGroup() {
+	wait();
+	if (_finished)
+		g_system->deleteSemaphore(_finished);
+}
+
+void TaskGroup::run(Task *task) {
+	assert(task);
+
+	// Without a semaphore to wait on, run the task right away rather than
+	// having wait() spin
+	if (!_finished) {
+		task->run();
+		delete task;
+
+		StackLock lock(_pool._mutex);
+		_pool._tasksInline++;
+		return;
+	}
+
+	{
+		StackLock lock(_mutex);
+		_pending++;
+	}
+	_pool.submit(task, this);
+}
+
+void TaskGroup::wait() {
+	for (;;) {
+		if (isDone())
+			return;
+
+		// Run other tasks rather than blocking, this also keeps tasks
+		// which wait for nested groups from deadlocking the pool
+		if (!_pool.helpOut())
+			g_system->waitSemaphore(_finished);
+	}
+}
+
+bool TaskGroup::isDone() {
+	StackLock lock(_mutex);
+	return _pending == 0;
+}
+
+void TaskGroup::taskDone() {
+	StackLock lock(_mutex);
+	assert(_pending > 0);
+	if (--_pending == 0)
+		g_system->signalSemaphore(_finished);
+}
+
+ThreadPool::ThreadPool(int numWorkers) : _workAvailable(0), _quit(false), _nextQueue(0), _tasksHelped(0), _tasksInline(0) {
+	if (numWorkers < 0)
+		numWorkers = (int)g_system->getNumProcessors() - 1;
+	if (numWorkers <= 0)
+		return;
+
+	_workAvailable = g_system->createSemaphore(0);
+	if (!_workAvailable)
+		return;
+
+	for (int i = 0; i < numWorkers; i++) {
+		Worker *worker = new Worker;
+		worker->pool = this;
+		worker->index = i;
+		worker->tasksRun = 0;
+		worker->tasksStolen = 0;
+		worker->thread = g_system->createThread(workerProc, worker);
+		if (!worker->thread) {
+			delete worker;
+			break;
+		}
+		_workers.push_back(worker);
+	}
+
+	if (_workers.empty()) {
+		g_system->deleteSemaphore(_workAvailable);
+		_workAvailable = 0;
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	if (_workers.empty())
+		return;
+
+	_quit = true;
+	for (uint i = 0; i < _workers.size(); i++)
+		g_system->signalSemaphore(_workAvailable);
+
+	for (uint i = 0; i < _workers.size(); i++) {
+		g_system->joinThread(_workers[i]->thread);
+		if (!_workers[i]->queue.empty())
+			warning("ThreadPool: Destroyed with pending tasks");
+		delete _workers[i];
+	}
+
+	g_system->deleteSemaphore(_workAvailable);
+}
+
+void ThreadPool::workerProc(void *param) {
+	Worker *self = (Worker *)param;
+	ThreadPool *pool = self->pool;
+
+	for (;;) {
+		g_system->waitSemaphore(pool->_workAvailable);
+		if (pool->_quit)
+			break;
+
+		// The task this wakeup was meant for may already have been taken
+		// by a waiting thread, in which case we go back to sleep
+		QueuedTask task;
+		if (pool->takeTask(self, task))
+			pool->execute(task);
+	}
+}
+
+void ThreadPool::submit(Task *task, TaskGroup *group) {
+	QueuedTask queued;
+	queued.task = task;
+	queued.group = group;
+
+	uint queue;
+	{
+		StackLock lock(_mutex);
+		queue = _nextQueue;
+		_nextQueue = (_nextQueue + 1) % _workers.size();
+	}
+
+	{
+		StackLock lock(_workers[queue]->mutex);
+		_workers[queue]->queue.push_back(queued);
+	}
+	g_system->signalSemaphore(_workAvailable);
+}
+
+bool ThreadPool::takeTask(Worker *self, QueuedTask &task) {
+	uint first = 0;
+
+	if (self) {
+		StackLock lock(self->mutex);
+		if (!self->queue.empty()) {
+			task = self->queue.back();
+			self->queue.pop_back();
+			self->tasksRun++;
+			return true;
+		}
+		first = self->index + 1;
+	}
+
+	bool found = false;
+	for (uint i = 0; i < _workers.size() && !found; i++) {
+		Worker *victim = _workers[(first + i) % _workers.size()];
+		if (victim == self)
+			continue;
+
+		StackLock lock(victim->mutex);
+		if (!victim->queue.empty()) {
+			task = victim->queue.front();
+			victim->queue.pop_front();
+			found = true;
+		}
+	}
+
+	if (!found)
+		return false;
+
+	if (self) {
+		StackLock lock(self->mutex);
+		self->tasksRun++;
+		self->tasksStolen++;
+	}
+	return true;
+}
+
+bool ThreadPool::helpOut() {
+	QueuedTask task;
+	if (!takeTask(nullptr, task))
+		return false;
+
+	{
+		StackLock lock(_mutex);
+		_tasksHelped++;
+	}
+	execute(task);
+	return true;
+}
+
+void ThreadPool::execute(const QueuedTask &task) {
+	task.task->run();
+	delete task.task;
+	task.group->taskDone();
+}
+
+namespace {
+
+class RangeTask : public Task {
+public:
+	RangeTask(Functor2<int, int, void> &body, int first, int last) : _body(body), _first(first), _last(last) {}
+	void run() override { _body(_first, _last); }
+
+private:
+	Functor2<int, int, void> &_body;
+	int _first, _last;
+};
+
+} // End of anonymous namespace
+
+void ThreadPool::parallelFor(int begin, int end, int grainSize, Functor2<int, int, void> &body) {
+	if (grainSize < 1)
+		grainSize = 1;
+
+	if (_workers.empty() || end - begin <= grainSize) {
+		if (begin < end)
+			body(begin, end);
+		return;
+	}
+
+	TaskGroup group(*this);
+	for (int first = begin; first < end; first += grainSize)
+		group.run(new RangeTask(body, first, MIN(first + grainSize, end)));
+	group.wait();
+}
+
+ThreadPool::Stats ThreadPool::getStats() {
+	Stats stats;
+	stats.tasksRun = 0;
+	stats.tasksStolen = 0;
+
+	for (uint i = 0; i < _workers.size(); i++) {
+		StackLock lock(_workers[i]->mutex);
+		stats.tasksRun += _workers[i]->tasksRun;
+		stats.tasksStolen += _workers[i]->tasksStolen;
+	}
+
+	StackLock lock(_mutex);
+	stats.tasksHelped = _tasksHelped;
+	stats.tasksInline = _tasksInline;
+	return stats;
+}
+
+} // End of namespace Common
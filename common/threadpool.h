@@ -0,0 +1,218 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/array.h"
+#include "common/func.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/ptr.h"
+#include "common/system.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_threadpool Thread pool
+ * @ingroup common
+ *
+ * @brief Work-stealing thread pool for parallelizing CPU-bound work.
+ *
+ * The pool runs on the worker threads provided by OSystem. On ports
+ * without thread support it has no workers, and every task is run
+ * synchronously by the thread submitting or waiting for it, so callers
+ * never need a separate code path.
+ *
+ * Tasks must not use the graphics, event or audio APIs of OSystem.
+ * @{
+ */
+
+class ThreadPool;
+
+/**
+ * A unit of work submitted to a ThreadPool.
+ */
+class Task {
+public:
+	virtual ~Task() {}
+	virtual void run() = 0;
+};
+
+/**
+ * A set of tasks which can be waited for together.
+ *
+ * The group takes ownership of the tasks passed to run() and deletes them
+ * once they are finished. Destroying a group waits for all of its tasks.
+ */
+class TaskGroup : NonCopyable {
+public:
+	explicit TaskGroup(ThreadPool &pool);
+	~TaskGroup();
+
+	/** Queue a task for execution. */
+	void run(Task *task);
+
+	/**
+	 * Wait until all tasks of the group are finished. While waiting, the
+	 * calling thread runs pending tasks of the pool itself.
+	 */
+	void wait();
+
+	/** Return true if all tasks of the group are finished. */
+	bool isDone();
+
+private:
+	friend class ThreadPool;
+
+	void taskDone();
+
+	ThreadPool &_pool;
+	Mutex _mutex;
+	uint _pending;
+	OSystem::SemaphoreRef _finished;
+};
+
+/**
+ * The result of a function run asynchronously on a ThreadPool.
+ *
+ * @code
+ * Common::Future<int> result(pool, new Common::Functor0Mem<int, Foo>(foo, &Foo::compute));
+ * ...
+ * int value = result.get();
+ * @endcode
+ */
+template<class T>
+class Future : NonCopyable {
+public:
+	/** Start running the function, taking ownership of it. */
+	Future(ThreadPool &pool, Functor0<T> *func) : _result(new T()), _group(pool) {
+		_group.run(new CallTask(func, _result.get()));
+	}
+
+	/** Return true if the result is available. */
+	bool isReady() { return _group.isDone(); }
+
+	/** Wait for the function to finish and return its result. */
+	const T &get() {
+		_group.wait();
+		return *_result;
+	}
+
+private:
+	class CallTask : public Task {
+	public:
+		CallTask(Functor0<T> *func, T *result) : _func(func), _result(result) {}
+		void run() override { *_result = (*_func)(); }
+
+	private:
+		ScopedPtr<Functor0<T> > _func;
+		T *_result;
+	};
+
+	// Declared before _group, so that it outlives the task
+	ScopedPtr<T> _result;
+	TaskGroup _group;
+};
+
+/**
+ * Fixed-size pool of worker threads.
+ *
+ * Each worker has its own task queue. Workers take the most recently
+ * queued task from their own queue, and steal the oldest task from the
+ * other queues when theirs is empty. Threads waiting for a TaskGroup
+ * help out by stealing tasks as well.
+ */
+class ThreadPool : NonCopyable {
+public:
+	/**
+	 * Create a thread pool.
+	 *
+	 * @param numWorkers Number of worker threads. By default one less than
+	 *                   the number of processors, since the waiting thread
+	 *                   does work as well. Fewer workers are started if the
+	 *                   backend does not support threads.
+	 */
+	explicit ThreadPool(int numWorkers = -1);
+	~ThreadPool();
+
+	/** Return the number of worker threads; 0 means tasks run synchronously. */
+	uint getNumWorkers() const { return _workers.size(); }
+
+	/**
+	 * Call body(first, last) for consecutive sub-ranges of [begin, end)
+	 * covering the whole range, in parallel. Each sub-range has at most
+	 * grainSize elements. Returns once all calls are finished.
+	 */
+	void parallelFor(int begin, int end, int grainSize, Functor2<int, int, void> &body);
+
+	struct Stats {
+		uint32 tasksRun;       ///< Tasks run by the workers
+		uint32 tasksStolen;    ///< Tasks taken from the queue of another worker
+		uint32 tasksHelped;    ///< Tasks run by waiting threads
+		uint32 tasksInline;    ///< Tasks run synchronously for lack of workers or semaphores
+	};
+
+	/** Return the task statistics since the pool was created. */
+	Stats getStats();
+
+private:
+	friend class TaskGroup;
+
+	struct QueuedTask {
+		Task *task;
+		TaskGroup *group;
+	};
+
+	struct Worker {
+		ThreadPool *pool;
+		uint index;
+		OSystem::ThreadRef thread;
+		Mutex mutex;			///< Protects the queue and the counters
+		List<QueuedTask> queue;
+		uint32 tasksRun;
+		uint32 tasksStolen;
+	};
+
+	static void workerProc(void *param);
+
+	void submit(Task *task, TaskGroup *group);
+	bool takeTask(Worker *self, QueuedTask &task);
+	bool helpOut();
+	void execute(const QueuedTask &task);
+
+	Array<Worker *> _workers;
+	OSystem::SemaphoreRef _workAvailable;
+	bool _quit;
+
+	Mutex _mutex;			///< Protects the members below
+	uint _nextQueue;
+	uint32 _tasksHelped;
+	uint32 _tasksInline;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -33,6 +33,7 @@
 #include "common/fs.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/unicode-bidi.h"
 
 #ifdef USE_TRANSLATION
@@ -45,7 +46,7 @@ bool operator<(const TLanguage &l, const TLanguage &r) {
 	return l.name < r.name;
 }
 
-TranslationManager::TranslationManager(const Common::String &fileName) : _currentLang(-1) {
+TranslationManager::TranslationManager(const Common::String &fileName) : _currentLang(-1), _pendingLang(-1) {
 	loadTranslationsInfoDat(fileName);
 
 	// Set the default language
@@ -82,7 +83,75 @@ int32 TranslationManager::findMatchingLanguage(const String &lang) {
 	return -1;
 }
 
+namespace {
+
+class LanguageLoadTask : public Task {
+public:
+	LanguageLoadTask(Functor1<File &, void> *read, File *in) : _read(read), _in(in) {}
+	~LanguageLoadTask() {
+		delete _read;
+		delete _in;
+	}
+
+	void run() override { (*_read)(*_in); }
+
+private:
+	Functor1<File &, void> *_read;
+	File *_in;
+};
+
+} // End of anonymous namespace
+
 void TranslationManager::setLanguage(const String &lang) {
+	int langIndex = findLanguageIndex(lang);
+
+	// Load messages for that language.
+	// Call it even if the index is -1 to unload previously loaded translations.
+	if (langIndex != _currentLang) {
+		loadLanguageDat(langIndex);
+		_currentLang = langIndex;
+	}
+}
+
+void TranslationManager::setLanguageAsync(const String &lang, TaskGroup &group) {
+	int langIndex = findLanguageIndex(lang);
+	if (langIndex == _currentLang)
+		return;
+
+	_currentTranslationMessages.clear();
+	_currentCharset.clear();
+	_currentLang = langIndex;
+
+	// Finding and opening the file uses the config and SearchMan, so it stays
+	// on the calling thread
+	File *in = new File();
+	if (!openLanguageDat(langIndex, *in)) {
+		delete in;
+		return;
+	}
+
+	// The worker only fills _pendingMessages, which nothing else touches
+	// until finishLanguageLoad() is called
+	_pendingMessages.clear();
+	_pendingLang = langIndex;
+	group.run(new LanguageLoadTask(new Functor1Mem<File &, void, TranslationManager>(this, &TranslationManager::readPendingLanguageDat), in));
+}
+
+void TranslationManager::finishLanguageLoad() {
+	if (_pendingLang == -1)
+		return;
+
+	// Drop the messages if another language has been set in the meantime
+	if (_pendingLang == _currentLang) {
+		_currentTranslationMessages = _pendingMessages;
+		_currentCharset = "UTF-32";
+	}
+
+	_pendingMessages.clear();
+	_pendingLang = -1;
+}
+
+int32 TranslationManager::findLanguageIndex(const String &lang) {
 	// Get lang index.
 	int langIndex = -1;
 	String langStr(lang);
@@ -100,12 +169,7 @@ void TranslationManager::setLanguage(const String &lang) {
 		langIndex = findMatchingLanguage(langCut);
 	}
 
-	// Load messages for that language.
-	// Call it even if the index is -1 to unload previously loaded translations.
-	if (langIndex != _currentLang) {
-		loadLanguageDat(langIndex);
-		_currentLang = langIndex;
-	}
+	return langIndex;
 }
 
 U32String TranslationManager::getTranslation(const char *message) const {
@@ -328,25 +392,30 @@ void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 void TranslationManager::loadLanguageDat(int index) {
 	_currentTranslationMessages.clear();
 	_currentCharset.clear();
+
+	File in;
+	if (openLanguageDat(index, in)) {
+		readLanguageDat(in, _currentTranslationMessages);
+		_currentCharset = "UTF-32";
+	}
+}
+
+bool TranslationManager::openLanguageDat(int index, File &in) {
 	// Sanity check
 	if (index < 0 || index >= (int)_langs.size()) {
 		if (index != -1)
 			warning("Invalid language index %d passed to TranslationManager::loadLanguageDat", index);
-		return;
+		return false;
 	}
 
-	File in;
 	if (!openTranslationsFile(in))
-		return;
-
-	char buf[1024];
-	int len;
+		return false;
 
 	// Get number of translations
 	int nbTranslations = in.readUint16BE();
 	if (nbTranslations != (int)_langs.size()) {
 		warning("The 'translations.dat' file has changed since starting ScummVM. GUI translation will not be available");
-		return;
+		return false;
 	}
 
 	// Get size of blocks to skip.
@@ -361,17 +430,24 @@ void TranslationManager::loadLanguageDat(int index) {
 	skipSize += 4 * (nbTranslations - index);	// 4 because block sizes are written in Uint32BE in the .dat file.
 
 	// Seek to start of block we want to read
-	in.seek(skipSize, SEEK_CUR);
+	return in.seek(skipSize, SEEK_CUR);
+}
+
+void TranslationManager::readPendingLanguageDat(File &in) {
+	readLanguageDat(in, _pendingMessages);
+}
+
+void TranslationManager::readLanguageDat(File &in, Array<PoMessageEntry> &messages) {
+	char buf[1024];
+	int len;
 
 	// Read number of translated messages
 	int nbMessages = in.readUint16BE();
-	_currentTranslationMessages.resize(nbMessages);
-
-	_currentCharset = "UTF-32";
+	messages.resize(nbMessages);
 
 	// Read messages
 	for (int i = 0; i < nbMessages; ++i) {
-		_currentTranslationMessages[i].msgid = in.readUint16BE();
+		messages[i].msgid = in.readUint16BE();
 		len = in.readUint16BE();
 		String msg;
 		while (len > 0) {
@@ -379,11 +455,11 @@ void TranslationManager::loadLanguageDat(int index) {
 			msg += String(buf, len > 256 ? 256 : len - 1);
 			len -= 256;
 		}
-		_currentTranslationMessages[i].msgstr = msg.decode();
+		messages[i].msgstr = msg.decode();
 		len = in.readUint16BE();
 		if (len > 0) {
 			in.read(buf, len);
-			_currentTranslationMessages[i].msgctxt = String(buf, len - 1);
+			messages[i].msgctxt = String(buf, len - 1);
 		}
 	}
 }
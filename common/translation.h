@@ -44,6 +44,7 @@ namespace Common {
  */
 
 class File;
+class TaskGroup;
 
 /**
  * Translation IDs.
@@ -125,6 +126,25 @@ public:
 		setLanguage(getLangById(id));
 	}
 
+	/**
+	 * Set the current translation language like setLanguage(), but read the
+	 * messages of the language on a worker of the pool of @p group.
+	 *
+	 * Messages are not translated until the group has been waited for and
+	 * finishLanguageLoad() has been called. The translation manager may be
+	 * used on the calling thread in the meantime.
+	 *
+	 * @param lang  Language to set up.
+	 * @param group Task group the loading is added to.
+	 */
+	void setLanguageAsync(const String &lang, TaskGroup &group);
+
+	/**
+	 * Start using the messages read by setLanguageAsync(). The task group
+	 * passed to it must have been waited for.
+	 */
+	void finishLanguageLoad();
+
 	/**
 	 * Get the ID for the given language string.
 	 *
@@ -203,6 +223,15 @@ private:
 	 */
 	int32 findMatchingLanguage(const String &lang);
 
+	/**
+	 * Find the index of the given language or of a derivate of it, the
+	 * default system language being used if @p lang is empty.
+	 *
+	 * @return Index of the language or -1 in case no matching language could
+	 *         be found.
+	 */
+	int32 findLanguageIndex(const String &lang);
+
 	/**
 	 * Find the translations.dat file.
 	 *
@@ -230,6 +259,24 @@ private:
 	 */
 	void loadLanguageDat(int index);
 
+	/**
+	 * Open the translations.dat file, positioned at the start of the
+	 * translation for the given language.
+	 */
+	bool openLanguageDat(int index, File &in);
+
+	/**
+	 * Read the translation at the current position of the translations.dat
+	 * file into @p messages. This doesn't touch any other member, so it may
+	 * run on a worker thread.
+	 */
+	void readLanguageDat(File &in, Array<PoMessageEntry> &messages);
+
+	/**
+	 * Read the translation for setLanguageAsync() into _pendingMessages.
+	 */
+	void readPendingLanguageDat(File &in);
+
 	/**
 	 * Check the header of the given file to make sure it is a valid translations data file.
 	 */
@@ -242,6 +289,8 @@ private:
 	Array<PoMessageEntry> _currentTranslationMessages;
 	String _currentCharset;
 	int _currentLang;
+	Array<PoMessageEntry> _pendingMessages;
+	int _pendingLang;
 	Common::String _translationsFileName;
 };
 
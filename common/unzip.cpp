@@ -105,7 +105,12 @@ typedef struct {
 
 #include "common/fs.h"
 #include "common/unzip.h"
+#include "common/zlib.h"
 #include "common/memstream.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/substream.h"
+#include "common/textconsole.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -273,6 +278,13 @@ int unzOpenCurrentFile(unzFile file);
   If there is no error, the return value is UNZ_OK.
 */
 
+int unzGetCurrentFileDataPos(unzFile file, uLong *pos);
+/*
+  Give the position of the data of the current file in the zipfile stream,
+  after checking its local header.
+  If there is no error, the return value is UNZ_OK.
+*/
+
 int unzCloseCurrentFile(unzFile file);
 /*
   Close the file in zip opened with unzOpenCurrentFile
@@ -1034,6 +1046,31 @@ static int unzlocal_CheckCurrentFileCoherencyHeader(unz_s* s, uInt* piSizeVar,
 	return err;
 }
 
+/*
+  Give the position of the data of the current file in the zipfile stream.
+  If there is no error, the return value is UNZ_OK.
+*/
+int unzGetCurrentFileDataPos(unzFile file, uLong *pos) {
+	uInt iSizeVar;
+	unz_s* s;
+	uLong offset_local_extrafield;  /* offset of the local extra field */
+	uInt  size_local_extrafield;    /* size of the local extra field */
+
+	if (file==nullptr)
+		return UNZ_PARAMERROR;
+	s=(unz_s*)file;
+	if (!s->current_file_ok)
+		return UNZ_PARAMERROR;
+
+	if (unzlocal_CheckCurrentFileCoherencyHeader(s,&iSizeVar,
+				&offset_local_extrafield,&size_local_extrafield)!=UNZ_OK)
+		return UNZ_BADZIPFILE;
+
+	*pos = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar +
+		s->byte_before_the_zipfile;
+	return UNZ_OK;
+}
+
 /*
   Open for reading data the current file in the zipfile.
   If there is no error and the file is opened, the return value is UNZ_OK.
@@ -1419,12 +1456,331 @@ int unzGetGlobalComment(unzFile file, char *szComment, uLong uSizeBuf) {
 
 namespace Common {
 
+/**
+ * The stream of a ZIP archive, shared by the archive and the streams of its
+ * members, which may outlive the archive.
+ */
+struct ZipSharedStream {
+	ZipSharedStream(SeekableReadStream *s) : stream(s), size(s->size()) {}
+
+	ScopedPtr<SeekableReadStream> stream;
+	int64 size;
+	Mutex mutex;        ///< Protects the position of the stream
+};
+
+/**
+ * A view of the archive stream with its own position. Any number of cursors
+ * may be used at the same time, as every read from the shared stream seeks
+ * it first. Reads are buffered, so that small reads don't each have to
+ * lock and seek the shared stream.
+ *
+ * The mutex makes reading from cursors on different threads safe, but
+ * cursors must only be created and destroyed on one thread, as the
+ * reference count of the shared stream is not atomic.
+ */
+class ZipStreamCursor : public SeekableReadStream {
+public:
+	ZipStreamCursor(const SharedPtr<ZipSharedStream> &shared)
+		: _shared(shared), _pos(0), _eos(false), _err(false), _bufStart(0), _bufSize(0) {}
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _err; }
+	void clearErr() override { _eos = _err = false; }
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _shared->size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		switch (whence) {
+		case SEEK_END:
+			offset += _shared->size;
+			break;
+		case SEEK_CUR:
+			offset += _pos;
+			break;
+		case SEEK_SET:
+		default:
+			break;
+		}
+
+		if (offset < 0 || offset > _shared->size)
+			return false;
+
+		// The buffer stays valid, the archive is never written to
+		_pos = offset;
+		_eos = false;
+		return true;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
+
+		while (total < dataSize && !_err) {
+			if (_pos >= _bufStart && _pos < _bufStart + _bufSize) {
+				uint32 len = MIN<uint32>(dataSize - total, _bufStart + _bufSize - _pos);
+				memcpy(dst + total, _buf + (_pos - _bufStart), len);
+				total += len;
+				_pos += len;
+				continue;
+			}
+
+			// Large reads bypass the buffer
+			uint32 len;
+			if (dataSize - total >= kBufSize) {
+				len = readShared(dst + total, dataSize - total);
+				total += len;
+				_pos += len;
+			} else {
+				len = readShared(_buf, kBufSize);
+				_bufStart = _pos;
+				_bufSize = len;
+			}
+
+			if (!len)
+				break;
+		}
+
+		if (total < dataSize && !_err)
+			_eos = true;
+
+		return total;
+	}
+
+private:
+	enum {
+		kBufSize = 4096
+	};
+
+	uint32 readShared(byte *dst, uint32 len) {
+		StackLock lock(_shared->mutex);
+		SeekableReadStream &stream = *_shared->stream;
+
+		if (stream.pos() != _pos && !stream.seek(_pos)) {
+			_err = true;
+			return 0;
+		}
+
+		uint32 actualSize = stream.read(dst, len);
+
+		// Keep the flags of the shared stream clean for the other cursors
+		_err |= stream.err();
+		stream.clearErr();
+
+		return actualSize;
+	}
+
+	SharedPtr<ZipSharedStream> _shared;
+	int64 _pos;
+	bool _eos;
+	bool _err;
+
+	byte _buf[kBufSize];
+	int64 _bufStart;            ///< Position of the buffered data in the stream
+	uint32 _bufSize;
+};
+
+#ifdef USE_ZLIB
+
+/** Deflated members up to this size are inflated into memory when opened. */
+const uint32 kZipInflateInMemoryLimit = 64 * 1024;
+
+/**
+ * Stream inflating a deflated member on demand.
+ *
+ * For large members, the inflate state is saved at regular intervals of the
+ * uncompressed data, so that seeking only has to decompress from the closest
+ * checkpoint rather than from the start of the member.
+ */
+class ZipInflateReadStream : public SeekableReadStream {
+public:
+	ZipInflateReadStream(SeekableReadStream *compressed, uint32 size, uint32 crc);
+	~ZipInflateReadStream();
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _err; }
+	void clearErr() override {
+		// zlib errors are not recoverable
+		_eos = false;
+	}
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override;
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+
+private:
+	enum {
+		kBufSize = 16384
+	};
+
+	uint32 inflateData(byte *dst, uint32 len);
+	void restoreCheckpoint(const InflateCheckpoints::Checkpoint &checkpoint);
+	void rewind();
+
+	ScopedPtr<SeekableReadStream> _compressed;
+	z_stream _zStream;
+	byte _buf[kBufSize];
+
+	uint32 _pos;
+	uint32 _size;
+	bool _eos;
+	bool _err;
+
+	uint32 _crc;
+	uint32 _expectedCrc;
+	bool _crcValid;             ///< The CRC covers all the data up to _pos
+
+	InflateCheckpoints _checkpoints;
+};
+
+ZipInflateReadStream::ZipInflateReadStream(SeekableReadStream *compressed, uint32 size, uint32 crc)
+	: _compressed(compressed), _zStream(), _pos(0), _size(size), _eos(false), _err(false),
+	  _crc(0), _expectedCrc(crc), _crcValid(true), _checkpoints(size) {
+	assert(compressed);
+
+	// A negative windowBits tells zlib there is no zlib header
+	if (inflateInit2(&_zStream, -MAX_WBITS) != Z_OK)
+		_err = true;
+	_zStream.next_in = _buf;
+	_zStream.avail_in = 0;
+}
+
+ZipInflateReadStream::~ZipInflateReadStream() {
+	inflateEnd(&_zStream);
+}
+
+uint32 ZipInflateReadStream::inflateData(byte *dst, uint32 len) {
+	_zStream.next_out = dst;
+	_zStream.avail_out = len;
+
+	while (_zStream.avail_out) {
+		if (!_zStream.avail_in) {
+			_zStream.next_in = _buf;
+			_zStream.avail_in = _compressed->read(_buf, kBufSize);
+		}
+
+		int res = inflate(&_zStream, Z_NO_FLUSH);
+		if (res == Z_STREAM_END)
+			break;
+		if (res != Z_OK) {
+			_err = true;
+			break;
+		}
+	}
+
+	uint32 actualSize = len - _zStream.avail_out;
+	_pos += actualSize;
+
+	if (_crcValid) {
+		_crc = crc32(_crc, dst, actualSize);
+		if (_pos == _size) {
+			_crcValid = false;
+			if (_crc != _expectedCrc) {
+				warning("ZipInflateReadStream: CRC mismatch");
+				_err = true;
+			}
+		}
+	}
+
+	return actualSize;
+}
+
+uint32 ZipInflateReadStream::read(void *dataPtr, uint32 dataSize) {
+	if (_err)
+		return 0;
+
+	if (dataSize > _size - _pos) {
+		dataSize = _size - _pos;
+		_eos = true;
+	}
+
+	byte *dst = (byte *)dataPtr;
+	uint32 total = 0;
+	while (total < dataSize && !_err) {
+		uint32 len = _checkpoints.limitRead(_pos, dataSize - total);
+		uint32 actualSize = inflateData(dst + total, len);
+		total += actualSize;
+
+		if (actualSize < len) {
+			// The deflated data ended early
+			_err = true;
+		} else {
+			_checkpoints.add(_pos, _compressed->pos() - _zStream.avail_in, &_zStream);
+		}
+	}
+
+	return total;
+}
+
+void ZipInflateReadStream::restoreCheckpoint(const InflateCheckpoints::Checkpoint &checkpoint) {
+	if (!_checkpoints.restore(checkpoint, &_zStream)) {
+		_err = true;
+		return;
+	}
+
+	_zStream.next_in = _buf;
+	_zStream.avail_in = 0;
+	_compressed->seek(checkpoint.inPos);
+	_pos = checkpoint.outPos;
+	_crcValid = false;
+}
+
+void ZipInflateReadStream::rewind() {
+	if (inflateReset(&_zStream) != Z_OK) {
+		_err = true;
+		return;
+	}
+
+	_zStream.next_in = _buf;
+	_zStream.avail_in = 0;
+	_compressed->seek(0);
+	_pos = 0;
+	_crc = 0;
+	_crcValid = true;
+}
+
+bool ZipInflateReadStream::seek(int64 offset, int whence) {
+	switch (whence) {
+	case SEEK_END:
+		offset += _size;
+		break;
+	case SEEK_CUR:
+		offset += _pos;
+		break;
+	case SEEK_SET:
+	default:
+		break;
+	}
+
+	if (_err || offset < 0 || offset > _size)
+		return false;
+
+	uint32 target = (uint32)offset;
+
+	const InflateCheckpoints::Checkpoint *checkpoint = _checkpoints.find(_pos, target);
+	if (checkpoint)
+		restoreCheckpoint(*checkpoint);
+	else if (target < _pos)
+		rewind();
+
+	byte tmpBuf[4096];
+	while (_pos < target && !_err)
+		read(tmpBuf, MIN<uint32>(sizeof(tmpBuf), target - _pos));
+
+	_eos = false;
+	return !_err;
+}
+
+#endif // USE_ZLIB
 
 class ZipArchive : public Archive {
 	unzFile _zipFile;
+	SharedPtr<ZipSharedStream> _stream;
 
 public:
-	ZipArchive(unzFile zipFile);
+	ZipArchive(unzFile zipFile, const SharedPtr<ZipSharedStream> &stream);
 
 
 	~ZipArchive();
@@ -1433,6 +1789,7 @@ public:
 	virtual int listMembers(ArchiveMemberList &list) const;
 	virtual const ArchiveMemberPtr getMember(const Path &path) const;
 	virtual SeekableReadStream *createReadStreamForMember(const Path &path) const;
+	virtual bool listMemberNames(StringArray &names) const;
 };
 
 /*
@@ -1453,7 +1810,7 @@ public:
 };
 */
 
-ZipArchive::ZipArchive(unzFile zipFile) : _zipFile(zipFile) {
+ZipArchive::ZipArchive(unzFile zipFile, const SharedPtr<ZipSharedStream> &stream) : _zipFile(zipFile), _stream(stream) {
 	assert(_zipFile);
 }
 
@@ -1479,6 +1836,16 @@ int ZipArchive::listMembers(ArchiveMemberList &list) const {
 	return members;
 }
 
+bool ZipArchive::listMemberNames(StringArray &names) const {
+	const unz_s *const archive = (const unz_s *)_zipFile;
+	for (ZipHash::const_iterator i = archive->_hash.begin(), end = archive->_hash.end();
+	     i != end; ++i) {
+		names.push_back(Path(i->_key, '/').rawString());
+	}
+
+	return true;
+}
+
 const ArchiveMemberPtr ZipArchive::getMember(const Path &path) const {
 	String name = path.toString();
 	if (!hasFile(name))
@@ -1493,31 +1860,43 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const Path &path) cons
 		return nullptr;
 
 	unz_file_info fileInfo;
-	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
+	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
 		return nullptr;
 
-	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
+	uLong dataPos;
+	if (unzGetCurrentFileDataPos(_zipFile, &dataPos) != UNZ_OK)
 		return nullptr;
 
+	// Every member stream reads the archive through its own cursor, so that
+	// members can be used independently of each other and of the archive
+	SeekableReadStream *data = new SeekableSubReadStream(new ZipStreamCursor(_stream),
+		dataPos, dataPos + fileInfo.compressed_size, DisposeAfterUse::YES);
+
+	if (fileInfo.compression_method == 0)
+		return data;
+
+#ifdef USE_ZLIB
+	SeekableReadStream *stream = new ZipInflateReadStream(data, fileInfo.uncompressed_size, fileInfo.crc);
+	if (fileInfo.uncompressed_size > kZipInflateInMemoryLimit)
+		return stream;
+
+	// Small members take less memory inflated than the zlib state does
 	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
 	assert(buffer);
 
-	if (unzReadCurrentFile(_zipFile, buffer, fileInfo.uncompressed_size) != (int)fileInfo.uncompressed_size) {
-		free(buffer);
-		return nullptr;
-	}
+	bool success = stream->read(buffer, fileInfo.uncompressed_size) == fileInfo.uncompressed_size && !stream->err();
+	delete stream;
 
-	if (unzCloseCurrentFile(_zipFile) != UNZ_OK) {
+	if (!success) {
 		free(buffer);
 		return nullptr;
 	}
 
 	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
-
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
+#else
+	delete data;
+	return nullptr;
+#endif
 }
 
 Archive *makeZipArchive(const String &name) {
@@ -1531,13 +1910,14 @@ Archive *makeZipArchive(const FSNode &node) {
 Archive *makeZipArchive(SeekableReadStream *stream) {
 	if (!stream)
 		return nullptr;
-	unzFile zipFile = unzOpen(stream);
+	SharedPtr<ZipSharedStream> shared(new ZipSharedStream(stream));
+	unzFile zipFile = unzOpen(new ZipStreamCursor(shared));
 	if (!zipFile) {
-		// stream gets deleted by unzOpen() call if something
-		// goes wrong.
+		// The cursor gets deleted by unzOpen() call if something
+		// goes wrong, and the stream along with the last reference.
 		return nullptr;
 	}
-	return new ZipArchive(zipFile);
+	return new ZipArchive(zipFile, shared);
 }
 
 } // End of namespace Common
@@ -28,6 +28,40 @@
 
 namespace Common {
 
+namespace {
+
+/** Entries of a compiled document */
+enum CompiledEntry {
+	kCompiledEnd = 0,
+	kCompiledKey = 1,
+	kCompiledClosedKey = 2,
+	kCompiledHeader = 3,
+	kCompiledClosure = 4
+};
+
+void writeCompiledString(WriteStream *stream, const String &str) {
+	stream->writeUint32LE(str.size());
+	stream->write(str.c_str(), str.size());
+}
+
+String readCompiledString(SeekableReadStream &stream) {
+	uint32 size = stream.readUint32LE();
+	if (size > stream.size() - stream.pos())
+		return String();
+
+	String str;
+	char buf[256];
+	while (size > 0) {
+		uint32 chunk = MIN<uint32>(size, sizeof(buf));
+		stream.read(buf, chunk);
+		str += String(buf, chunk);
+		size -= chunk;
+	}
+	return str;
+}
+
+} // End of anonymous namespace
+
 XMLParser::~XMLParser() {
 	while (!_activeKey.empty())
 		freeNode(_activeKey.pop());
@@ -80,6 +114,13 @@ void XMLParser::close() {
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
+	if (!_stream) {
+		// Compiled documents have no text to show
+		String errorMessage = "\nParser error: " + errStr + "\n\n";
+		g_system->logMessage(LogMessageType::kError, errorMessage.c_str());
+		return false;
+	}
+
 	const int startPosition = _stream->pos();
 	int currentPosition = startPosition;
 	int lineCount = 1;
@@ -387,6 +428,9 @@ bool XMLParser::parse() {
 
 		case kParserNeedPropertyName:
 			if (activeClosure) {
+				if (_compileStream)
+					_compileStream->writeByte(kCompiledClosure);
+
 				if (!closeKey()) {
 					parserError("Missing data when closing key '" + _activeKey.top()->name + "'.");
 					break;
@@ -413,7 +457,14 @@ bool XMLParser::parse() {
 			if (_char == '>') {
 				if (activeHeader && !selfClosure) {
 					parserError("XML Header must be self-closed.");
-				} else if (parseActiveKey(selfClosure)) {
+					break;
+				}
+
+				// Write the key before the callbacks, which may add values
+				if (_compileStream)
+					compileKey(_activeKey.top(), selfClosure);
+
+				if (parseActiveKey(selfClosure)) {
 					_char = _stream->readByte();
 					_state = kParserNeedKey;
 				}
@@ -459,9 +510,95 @@ bool XMLParser::parse() {
 	if (_state != kParserNeedKey || !_activeKey.empty())
 		return parserError("Unexpected end of file.");
 
+	if (_compileStream)
+		_compileStream->writeByte(kCompiledEnd);
+
 	return true;
 }
 
+void XMLParser::compileKey(const ParserNode *node, bool closed) {
+	if (node->header)
+		_compileStream->writeByte(kCompiledHeader);
+	else
+		_compileStream->writeByte(closed ? kCompiledClosedKey : kCompiledKey);
+
+	writeCompiledString(_compileStream, node->name);
+	_compileStream->writeUint32LE(node->values.size());
+	for (StringMap::const_iterator i = node->values.begin(); i != node->values.end(); ++i) {
+		writeCompiledString(_compileStream, i->_key);
+		writeCompiledString(_compileStream, i->_value);
+	}
+}
+
+bool XMLParser::parseCompiled(SeekableReadStream &stream) {
+	SeekableReadStream *textStream = _stream;
+	_stream = nullptr;
+
+	if (_XMLkeys == nullptr)
+		buildLayout();
+
+	while (!_activeKey.empty())
+		freeNode(_activeKey.pop());
+
+	cleanup();
+
+	_state = kParserNeedKey;
+
+	bool result = false;
+	for (;;) {
+		byte entry = stream.readByte();
+		if (stream.eos() || stream.err()) {
+			parserError("Unexpected end of compiled document.");
+			break;
+		}
+
+		if (entry == kCompiledEnd) {
+			result = _activeKey.empty() || parserError("Unexpected end of compiled document.");
+			break;
+		}
+
+		if (entry == kCompiledClosure) {
+			if (_activeKey.empty()) {
+				parserError("Unexpected closure.");
+				break;
+			}
+			if (!closeKey()) {
+				parserError("Missing data when closing key.");
+				break;
+			}
+			continue;
+		}
+
+		if (entry != kCompiledKey && entry != kCompiledClosedKey && entry != kCompiledHeader) {
+			parserError("Invalid compiled document.");
+			break;
+		}
+
+		ParserNode *node = allocNode();
+		node->name = readCompiledString(stream);
+		node->ignore = false;
+		node->header = (entry == kCompiledHeader);
+		node->depth = _activeKey.size();
+		node->layout = nullptr;
+		_activeKey.push(node);
+
+		uint32 numValues = stream.readUint32LE();
+		for (uint32 i = 0; i < numValues && !stream.eos(); i++) {
+			String key = readCompiledString(stream);
+			node->values[key] = readCompiledString(stream);
+		}
+
+		if (!parseActiveKey(entry != kCompiledKey))
+			break;
+	}
+
+	while (!_activeKey.empty())
+		freeNode(_activeKey.pop());
+
+	_stream = textStream;
+	return result;
+}
+
 bool XMLParser::skipSpaces() {
 	if (!isSpace(_char))
 		return false;
@@ -46,6 +46,7 @@ namespace Common {
  */
 
 class SeekableReadStream;
+class WriteStream;
 
 #define MAX_XML_DEPTH 8
 
@@ -101,7 +102,7 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _compileStream(nullptr) {}
 
 	virtual ~XMLParser();
 
@@ -196,6 +197,26 @@ public:
 	 */
 	bool parse();
 
+	/**
+	 * Write the keys found by the following calls to parse() to a stream,
+	 * in a binary form which parseCompiled() can process without tokenizing
+	 * the XML again.
+	 *
+	 * @param stream Stream the keys are written to, or nullptr to stop
+	 *               writing them. It is not owned by the parser.
+	 */
+	void setCompileStream(WriteStream *stream) { _compileStream = stream; }
+
+	/**
+	 * Process a document written by parse() to a compile stream, calling the
+	 * key callbacks just like parsing the original XML would.
+	 *
+	 * The stream is left after the end of the document, so several
+	 * documents written one after another are processed by successive calls.
+	 * Returns true if successful.
+	 */
+	bool parseCompiled(SeekableReadStream &stream);
+
 	/**
 	 * Returns the active node being parsed (the one on top of
 	 * the node stack).
@@ -346,8 +367,12 @@ protected:
 	List<XMLKeyLayout *> _layoutList;
 
 private:
+	/** Write a key of the parsed document to the compile stream */
+	void compileKey(const ParserNode *node, bool closed);
+
 	char _char;
 	SeekableReadStream *_stream;
+	WriteStream *_compileStream;
 	String _fileName;
 
 	ParserState _state; /** Internal state of the parser */
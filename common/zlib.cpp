@@ -24,6 +24,7 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/zlib.h"
+#include "common/array.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -218,6 +219,70 @@ bool inflateZlibHeaderless(Common::WriteStream *dst, Common::SeekableReadStream
 	return (status == Z_OK);
 }
 
+namespace {
+
+enum {
+	kCheckpointMinSize = 1024 * 1024,       ///< Smaller streams are never checkpointed
+	kCheckpointMinInterval = 256 * 1024,
+	kMaxCheckpoints = 64                    ///< Each checkpoint holds a copy of the 32 KB window
+};
+
+} // End of anonymous namespace
+
+InflateCheckpoints::InflateCheckpoints(uint32 size) : _interval(0) {
+	if (size >= kCheckpointMinSize)
+		_interval = MAX<uint32>(kCheckpointMinInterval, size / kMaxCheckpoints);
+}
+
+InflateCheckpoints::~InflateCheckpoints() {
+	for (uint i = 0; i < _checkpoints.size(); i++) {
+		inflateEnd(_checkpoints[i].state);
+		delete _checkpoints[i].state;
+	}
+}
+
+uint32 InflateCheckpoints::limitRead(uint32 pos, uint32 len) const {
+	uint32 next = (_checkpoints.size() + 1) * _interval;
+	if (_interval && pos < next)
+		len = MIN(len, next - pos);
+	return len;
+}
+
+void InflateCheckpoints::add(uint32 pos, uint32 inPos, z_stream_s *stream) {
+	if (!_interval || pos != (_checkpoints.size() + 1) * _interval)
+		return;
+
+	Checkpoint checkpoint;
+	checkpoint.outPos = pos;
+	checkpoint.inPos = inPos;
+	checkpoint.state = new z_stream();
+	if (inflateCopy(checkpoint.state, stream) != Z_OK) {
+		delete checkpoint.state;
+		return;
+	}
+
+	_checkpoints.push_back(checkpoint);
+}
+
+const InflateCheckpoints::Checkpoint *InflateCheckpoints::find(uint32 pos, uint32 target) const {
+	for (uint i = _checkpoints.size(); i-- > 0;) {
+		const Checkpoint &checkpoint = _checkpoints[i];
+		if (checkpoint.outPos > target)
+			continue;
+
+		// Going on from pos is closer if it lies between the two
+		if (target < pos || checkpoint.outPos > pos)
+			return &checkpoint;
+		return nullptr;
+	}
+	return nullptr;
+}
+
+bool InflateCheckpoints::restore(const Checkpoint &checkpoint, z_stream_s *stream) const {
+	inflateEnd(stream);
+	return inflateCopy(stream, checkpoint.state) == Z_OK;
+}
+
 #ifndef RELEASE_BUILD
 static bool _shownBackwardSeekingWarning = false;
 #endif
@@ -226,6 +291,10 @@ static bool _shownBackwardSeekingWarning = false;
  * A simple wrapper class which can be used to wrap around an arbitrary
  * other SeekableReadStream and will then provide on-the-fly decompression support.
  * Assumes the compressed data to be in gzip format.
+ *
+ * For large streams of known size, the inflate state is saved at regular
+ * intervals while reading, so that seeking backward only has to decompress
+ * from the closest checkpoint rather than from the start of the stream.
  */
 class GZipReadStream : public SeekableReadStream {
 protected:
@@ -242,6 +311,36 @@ protected:
 	uint32 _origSize;
 	bool _eos;
 
+	ScopedPtr<InflateCheckpoints> _checkpoints;
+
+	uint32 inflateData(byte *dst, uint32 len) {
+		_stream.next_out = dst;
+		_stream.avail_out = len;
+
+		// Keep going while we get no error
+		while (_zlibErr == Z_OK && _stream.avail_out) {
+			if (_stream.avail_in == 0 && !_wrapped->eos()) {
+				// If we are out of input data: Read more data, if available.
+				_stream.next_in = _buf;
+				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
+			}
+			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+		}
+
+		// Update the position counter
+		_pos += len - _stream.avail_out;
+
+		return len - _stream.avail_out;
+	}
+
+	void restoreCheckpoint(const InflateCheckpoints::Checkpoint &checkpoint) {
+		_zlibErr = _checkpoints->restore(checkpoint, &_stream) ? Z_OK : Z_MEM_ERROR;
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		_wrapped->seek(checkpoint.inPos, SEEK_SET);
+		_pos = checkpoint.outPos;
+	}
+
 public:
 
 	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0) : _wrapped(w), _stream() {
@@ -266,6 +365,8 @@ public:
 		w->seek(0, SEEK_SET);
 		_eos = false;
 
+		_checkpoints.reset(new InflateCheckpoints(_origSize));
+
 		// Adding 32 to windowBits indicates to zlib that it is supposed to
 		// automatically detect whether gzip or zlib headers are used for
 		// the compressed file. This feature was added in zlib 1.2.0.4,
@@ -291,26 +392,21 @@ public:
 	}
 
 	uint32 read(void *dataPtr, uint32 dataSize) {
-		_stream.next_out = (byte *)dataPtr;
-		_stream.avail_out = dataSize;
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
 
-		// Keep going while we get no error
-		while (_zlibErr == Z_OK && _stream.avail_out) {
-			if (_stream.avail_in == 0 && !_wrapped->eos()) {
-				// If we are out of input data: Read more data, if available.
-				_stream.next_in = _buf;
-				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
-			}
-			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
-		}
+		while (total < dataSize && _zlibErr == Z_OK) {
+			uint32 len = _checkpoints->limitRead(_pos, dataSize - total);
+			total += inflateData(dst + total, len);
 
-		// Update the position counter
-		_pos += dataSize - _stream.avail_out;
+			if (_zlibErr == Z_OK)
+				_checkpoints->add(_pos, _wrapped->pos() - _stream.avail_in, &_stream);
+		}
 
-		if (_zlibErr == Z_STREAM_END && _stream.avail_out > 0)
+		if (_zlibErr == Z_STREAM_END && total < dataSize)
 			_eos = true;
 
-		return dataSize - _stream.avail_out;
+		return total;
 	}
 
 	bool eos() const {
@@ -341,7 +437,12 @@ public:
 
 		assert(newPos >= 0);
 
-		if ((uint32)newPos < _pos) {
+		const InflateCheckpoints::Checkpoint *checkpoint = _checkpoints->find(_pos, newPos);
+		if (checkpoint) {
+			restoreCheckpoint(*checkpoint);
+			if (_zlibErr != Z_OK)
+				return false; // FIXME: STREAM REWRITE
+		} else if ((uint32)newPos < _pos) {
 			// To search backward, we have to restart the whole decompression
 			// from the start of the file. A rather wasteful operation, best
 			// to avoid it. :/
@@ -367,10 +468,9 @@ public:
 
 		offset = newPos - _pos;
 
-		// Skip the given amount of data (very inefficient if one tries to skip
-		// huge amounts of data, but usually client code will only skip a few
-		// bytes, so this should be fine.
-		byte tmpBuf[1024];
+		// Skip the given amount of data. Past the first checkpoint, this is
+		// at most the distance between two checkpoints.
+		byte tmpBuf[4096];
 		while (!err() && offset > 0) {
 			offset -= read(tmpBuf, MIN((int64)sizeof(tmpBuf), offset));
 		}
@@ -24,6 +24,10 @@
 #define COMMON_ZLIB_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+
+struct z_stream_s;
 
 namespace Common {
 
@@ -117,6 +121,58 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
  */
 bool inflateZlibHeaderless(Common::WriteStream *dst, Common::SeekableReadStream *src);
 
+/**
+ * Saved inflate states of a stream, taken at regular intervals of the
+ * uncompressed data while reading it, so that seeking only has to
+ * decompress from the closest checkpoint rather than from the start of
+ * the stream. Used by the gzip and ZIP member read streams.
+ */
+class InflateCheckpoints : NonCopyable {
+public:
+	struct Checkpoint {
+		uint32 outPos;          ///< Position in the uncompressed data
+		uint32 inPos;           ///< Position in the compressed data
+		z_stream_s *state;
+	};
+
+	/**
+	 * @param size  Size of the uncompressed data. Small streams are cheap
+	 *              to decompress again and never get checkpoints.
+	 */
+	explicit InflateCheckpoints(uint32 size);
+	~InflateCheckpoints();
+
+	/**
+	 * Return how many of len bytes to inflate at pos, stopping at the next
+	 * checkpoint so that add() can save the state there.
+	 */
+	uint32 limitRead(uint32 pos, uint32 len) const;
+
+	/**
+	 * Save the state of the given stream if pos is at the next checkpoint.
+	 * inPos is the position of the first compressed byte zlib has not
+	 * consumed yet.
+	 */
+	void add(uint32 pos, uint32 inPos, z_stream_s *stream);
+
+	/**
+	 * Return the checkpoint to resume from to get from pos to target, or
+	 * nullptr if going on from pos, or rewinding, is cheaper.
+	 */
+	const Checkpoint *find(uint32 pos, uint32 target) const;
+
+	/**
+	 * Replace the state of the given stream by the one of the checkpoint.
+	 * The caller still has to reset the input and seek the compressed data
+	 * to inPos. Returns false if zlib failed.
+	 */
+	bool restore(const Checkpoint &checkpoint, z_stream_s *stream) const;
+
+private:
+	uint32 _interval;               ///< 0 if the stream is not checkpointed
+	Array<Checkpoint> _checkpoints;
+};
+
 #endif
 
 /**
@@ -23,6 +23,7 @@
 #include "ags/console.h"
 #include "ags/ags.h"
 #include "ags/globals.h"
+#include "ags/engine/gfx/ali_3d_scummvm.h"
 #include "ags/shared/ac/sprite_cache.h"
 #include "ags/shared/gfx/allegro_bitmap.h"
 #include "ags/shared/script/cc_options.h"
@@ -36,6 +37,7 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
+	registerCmd("ags_render_stats", WRAP_METHOD(AGSConsole, Cmd_renderStats));
 
 	_logOutputTarget = new LogOutputTarget();
 	_agsDebuggerOutput = _GP(DbgMgr).RegisterOutput("ScummVMLog", _logOutputTarget, AGS3::AGS::Shared::kDbgMsg_None);
@@ -245,6 +247,27 @@ bool AGSConsole::Cmd_dumpSprite(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_renderStats(int argc, const char **argv) {
+	if (argc != 1) {
+		debugPrintf("Usage: %s\n", argv[0]);
+		return true;
+	}
+
+	AGS3::AGS::Engine::ALSW::ScummVMRendererGraphicsDriver *driver =
+		dynamic_cast<AGS3::AGS::Engine::ALSW::ScummVMRendererGraphicsDriver *>(_G(gfxDriver));
+	if (!driver) {
+		debugPrintf("The graphics driver is not initialized\n");
+		return true;
+	}
+
+	const AGS3::AGS::Engine::ALSW::ScummVMRendererGraphicsDriver::RenderStats &stats = driver->GetRenderStats();
+	debugPrintf("Last frame:\n");
+	debugPrintf("  Sprite pixels drawn: %u\n", stats.SpritePixels);
+	debugPrintf("  Sprite batches skipped: %u\n", stats.SkippedBatches);
+	debugPrintf("  Pixels presented: %u in %u rects\n", stats.PresentedPixels, stats.PresentedRects);
+	return true;
+}
+
 LogOutputTarget::LogOutputTarget() {
 }
 
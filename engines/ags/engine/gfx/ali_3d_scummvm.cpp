@@ -60,6 +60,7 @@ ScummVMRendererGraphicsDriver::ScummVMRendererGraphicsDriver() {
 ScummVMRendererGraphicsDriver::~ScummVMRendererGraphicsDriver() {
 	delete _screen;
 	ScummVMRendererGraphicsDriver::UnInit();
+	_presentedScreen.free();
 }
 
 bool ScummVMRendererGraphicsDriver::IsModeSupported(const DisplayMode &mode) {
@@ -121,6 +122,7 @@ bool ScummVMRendererGraphicsDriver::SetDisplayMode(const DisplayMode &mode) {
 
 	OnInit();
 	OnModeSet(mode);
+	InvalidatePresentedScreen();
 	return true;
 }
 
@@ -146,6 +148,7 @@ void ScummVMRendererGraphicsDriver::CreateVirtualScreen() {
 
 	_lastTexPixels = nullptr;
 	_lastTexPitch = -1;
+	InvalidatePresentedScreen();
 }
 
 void ScummVMRendererGraphicsDriver::DestroyVirtualScreen() {
@@ -155,6 +158,9 @@ void ScummVMRendererGraphicsDriver::DestroyVirtualScreen() {
 	_origVirtualScreen.reset();
 	virtualScreen = nullptr;
 	_stageVirtualScreen = nullptr;
+
+	_presentedScreen.free();
+	InvalidatePresentedScreen();
 }
 
 void ScummVMRendererGraphicsDriver::ReleaseDisplayMode() {
@@ -223,6 +229,7 @@ void ScummVMRendererGraphicsDriver::UpdateDDBFromBitmap(IDriverDependantBitmap *
 	ALSoftwareBitmap *alSwBmp = (ALSoftwareBitmap *)bitmapToUpdate;
 	alSwBmp->_bmp = bitmap;
 	alSwBmp->_hasAlpha = hasAlpha;
+	alSwBmp->_version = _nextBitmapVersion++;
 }
 
 void ScummVMRendererGraphicsDriver::DestroyDDB(IDriverDependantBitmap *bitmap) {
@@ -234,6 +241,7 @@ void ScummVMRendererGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBa
 		_spriteBatches.resize(index + 1);
 	ALSpriteBatch &batch = _spriteBatches[index];
 	batch.List.clear();
+	batch.OwnsSurface = false;
 	// TODO: correct offsets to have pre-scale (source) and post-scale (dest) offsets!
 	const int src_w = desc.Viewport.GetWidth() / desc.Transform.ScaleX;
 	const int src_h = desc.Viewport.GetHeight() / desc.Transform.ScaleY;
@@ -262,11 +270,17 @@ void ScummVMRendererGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBa
 		batch.IsVirtualScreen = true;
 	}
 	// No surface prepared and has transformation other than offset
-	else if (!batch.Surface || batch.IsVirtualScreen || batch.Surface->GetWidth() != src_w || batch.Surface->GetHeight() != src_h) {
-		batch.Surface.reset(new Bitmap(src_w, src_h, _srcColorDepth));
-		batch.Opaque = false;
-		batch.IsVirtualScreen = false;
+	else {
+		if (!batch.Surface || batch.IsVirtualScreen || batch.Surface->GetWidth() != src_w || batch.Surface->GetHeight() != src_h) {
+			batch.Surface.reset(new Bitmap(src_w, src_h, _srcColorDepth));
+			batch.Opaque = false;
+			batch.IsVirtualScreen = false;
+			batch.DrawnSpritesValid = false;
+		}
+		batch.OwnsSurface = true;
 	}
+	if (!batch.OwnsSurface)
+		batch.DrawnSpritesValid = false;
 }
 
 void ScummVMRendererGraphicsDriver::ResetAllBatches() {
@@ -304,23 +318,32 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 	// that here would slow things down significantly, so if we ever go that way sprite caching will
 	// be required (similarily to how AGS caches flipped/scaled object sprites now for).
 	//
+	_stats.SpritePixels = 0;
+	_stats.SkippedBatches = 0;
 	for (size_t i = 0; i <= _actSpriteBatch; ++i) {
 		const Rect &viewport = _spriteBatchDesc[i].Viewport;
 		const SpriteTransform &transform = _spriteBatchDesc[i].Transform;
-		const ALSpriteBatch &batch = _spriteBatches[i];
+		ALSpriteBatch &batch = _spriteBatches[i];
 
 		virtualScreen->SetClip(viewport);
 		Bitmap *surface = batch.Surface.get();
 		const int view_offx = viewport.Left;
 		const int view_offy = viewport.Top;
 		if (surface) {
-			if (!batch.Opaque)
-				surface->ClearTransparent();
-			_stageVirtualScreen = surface;
-			RenderSpriteBatch(batch, surface, transform.X, transform.Y);
-			if (!batch.IsVirtualScreen)
+			// A surface of our own still has the sprites of the last frame, which are often the same
+			if (batch.OwnsSurface && UpdateDrawnSprites(batch, transform.X, transform.Y)) {
+				_stats.SkippedBatches++;
+			} else {
+				if (!batch.Opaque)
+					surface->ClearTransparent();
+				_stageVirtualScreen = surface;
+				RenderSpriteBatch(batch, surface, transform.X, transform.Y);
+			}
+			if (!batch.IsVirtualScreen) {
 				virtualScreen->StretchBlt(surface, RectWH(view_offx, view_offy, viewport.GetWidth(), viewport.GetHeight()),
 				                          batch.Opaque ? kBitmap_Copy : kBitmap_Transparency);
+				_stats.SpritePixels += viewport.GetWidth() * viewport.GetHeight();
+			}
 		} else {
 			RenderSpriteBatch(batch, virtualScreen, view_offx + transform.X, view_offy + transform.Y);
 		}
@@ -329,6 +352,41 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 	ClearDrawLists();
 }
 
+bool ScummVMRendererGraphicsDriver::UpdateDrawnSprites(ALSpriteBatch &batch, int surf_offx, int surf_offy) {
+	const std::vector<ALDrawListEntry> &drawlist = batch.List;
+	bool same = batch.DrawnSpritesValid && batch.DrawnSprites.size() == drawlist.size();
+	batch.DrawnSprites.resize(drawlist.size());
+	batch.DrawnSpritesValid = true;
+
+	for (size_t i = 0; i < drawlist.size(); i++) {
+		ALDrawnSprite sprite;
+		sprite.DDB = drawlist[i].bitmap;
+		if (sprite.DDB == nullptr) {
+			// Null sprites are drawn by the engine or plugins, which could draw anything
+			batch.DrawnSpritesValid = false;
+			return false;
+		} else if (sprite.DDB == (ALSoftwareBitmap *)0x1) {
+			// Screen tint
+			sprite.Pixels = nullptr;
+			sprite.Version = 0;
+			sprite.X = _tint_red;
+			sprite.Y = _tint_green;
+			sprite.Transparency = _tint_blue;
+		} else {
+			sprite.Pixels = sprite.DDB->_bmp;
+			sprite.Version = sprite.DDB->_version;
+			sprite.X = drawlist[i].x + surf_offx;
+			sprite.Y = drawlist[i].y + surf_offy;
+			sprite.Transparency = sprite.DDB->_transparency;
+		}
+
+		if (same && batch.DrawnSprites[i] != sprite)
+			same = false;
+		batch.DrawnSprites[i] = sprite;
+	}
+	return same;
+}
+
 void ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch, Shared::Bitmap *surface, int surf_offx, int surf_offy) {
 	const std::vector<ALDrawListEntry> &drawlist = batch.List;
 	for (size_t i = 0; i < drawlist.size(); i++) {
@@ -343,6 +401,7 @@ void ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch
 			// draw screen tint fx
 			set_trans_blender(_tint_red, _tint_green, _tint_blue, 0);
 			surface->LitBlendBlt(surface, 0, 0, 128);
+			_stats.SpritePixels += surface->GetWidth() * surface->GetHeight();
 			continue;
 		}
 
@@ -351,9 +410,13 @@ void ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch
 		int drawAtY = drawlist[i].y + surf_offy;
 
 		if (bitmap->_transparency >= 255) {
-		} // fully transparent, do nothing
-		else if ((bitmap->_opaque) && (bitmap->_bmp == surface) && (bitmap->_transparency == 0)) {
-		} else if (bitmap->_opaque) {
+			continue; // fully transparent, do nothing
+		} else if ((bitmap->_opaque) && (bitmap->_bmp == surface) && (bitmap->_transparency == 0)) {
+			continue;
+		}
+
+		_stats.SpritePixels += bitmap->_bmp->GetWidth() * bitmap->_bmp->GetHeight();
+		if (bitmap->_opaque) {
 			surface->Blit(bitmap->_bmp, 0, 0, drawAtX, drawAtY, bitmap->_bmp->GetWidth(), bitmap->_bmp->GetHeight());
 			// TODO: we need to also support non-masked translucent blend, but...
 			// Allegro 4 **does not have such function ready** :( (only masked blends, where it skips magenta pixels);
@@ -374,36 +437,82 @@ void ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch
 	}
 }
 
-void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bool mode) {
+void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, const Common::Rect &rect, bool mode) {
 	assert(src.w == _screen->w && src.h == _screen->h && src.pitch == _screen->pitch);
-	const uint32 *srcP = (const uint32 *)src.getPixels();
-	uint32 *destP = (uint32 *)_screen->getPixels();
-	uint32 pixel;
-	int x1 = 9999, y1 = 9999, x2 = -1, y2 = -1;
 
-	for (int y = 0; y < src.h; ++y) {
-		for (int x = 0; x < src.w; ++x, ++srcP, ++destP) {
+	for (int y = rect.top; y < rect.bottom; ++y) {
+		const uint32 *srcP = (const uint32 *)src.getBasePtr(rect.left, y);
+		uint32 *destP = (uint32 *)_screen->getBasePtr(rect.left, y);
+
+		for (int x = rect.left; x < rect.right; ++x, ++srcP, ++destP) {
 			if (!mode) {
-				pixel = (*srcP & 0xff00ff00) |
+				*destP = (*srcP & 0xff00ff00) |
 					((*srcP & 0xff) << 16) |
 					((*srcP >> 16) & 0xff);
 			} else {
-				pixel = ((*srcP & 0xffffff) << 8) |
+				*destP = ((*srcP & 0xffffff) << 8) |
 					((*srcP >> 24) & 0xff);
 			}
+		}
+	}
+
+	_screen->addDirtyRect(rect);
+}
+
+void ScummVMRendererGraphicsDriver::AddDamageRect(const Common::Rect &rect) {
+	for (size_t i = 0; i < _damageRects.size(); ++i) {
+		Common::Rect &above = _damageRects[i];
+		if (above.bottom == rect.top && above.left == rect.left && above.right == rect.right) {
+			above.bottom = rect.bottom;
+			return;
+		}
+	}
+	_damageRects.push_back(rect);
+}
+
+void ScummVMRendererGraphicsDriver::FindDamage(const Graphics::Surface &src) {
+	_damageRects.clear();
 
-			if (*destP != pixel) {
-				*destP = pixel;
-				x1 = MIN(x1, x);
-				y1 = MIN(y1, y);
-				x2 = MAX(x2, x);
-				y2 = MAX(y2, y);
+	if (!_presentedScreenValid || _presentedScreen.w != src.w || _presentedScreen.h != src.h || _presentedScreen.format != src.format) {
+		_presentedScreen.free();
+		_presentedScreen.copyFrom(src);
+		_presentedScreenValid = true;
+		_damageRects.push_back(Common::Rect(src.w, src.h));
+		return;
+	}
+
+	// Compare the screen tile by tile, joining the changed tiles of a row of
+	// tiles, and then these rects with the ones they continue vertically
+	const int bpp = src.format.bytesPerPixel;
+	for (int top = 0; top < src.h; top += kDamageTileHeight) {
+		const int bottom = MIN<int>(top + kDamageTileHeight, src.h);
+		Common::Rect run;
+
+		for (int left = 0; left < src.w; left += kDamageTileWidth) {
+			const int right = MIN<int>(left + kDamageTileWidth, src.w);
+			bool changed = false;
+			for (int y = top; y < bottom && !changed; ++y)
+				changed = memcmp(src.getBasePtr(left, y), _presentedScreen.getBasePtr(left, y), (right - left) * bpp) != 0;
+
+			if (changed) {
+				if (run.isEmpty())
+					run = Common::Rect(left, top, right, bottom);
+				else
+					run.right = right;
+			} else if (!run.isEmpty()) {
+				AddDamageRect(run);
+				run = Common::Rect();
 			}
 		}
+		if (!run.isEmpty())
+			AddDamageRect(run);
 	}
 
-	if (x2 != -1)
-		_screen->addDirtyRect(Common::Rect(x1, y1, x2 + 1, y2 + 1));
+	for (size_t i = 0; i < _damageRects.size(); ++i) {
+		const Common::Rect &rect = _damageRects[i];
+		for (int y = rect.top; y < rect.bottom; ++y)
+			memcpy(_presentedScreen.getBasePtr(rect.left, y), src.getBasePtr(rect.left, y), rect.width() * bpp);
+	}
 }
 
 void ScummVMRendererGraphicsDriver::BlitToScreen() {
@@ -437,39 +546,57 @@ void ScummVMRendererGraphicsDriver::BlitToScreen() {
 	if (renderMode != kRenderDirect && !_screen)
 		_screen = new Graphics::Screen();
 
-	switch (renderMode) {
-	case kRenderToABGR:
-		// ARGB to ABGR
-		copySurface(src, false);
-		break;
+	// Only copy what changed since the last frame. Palette based surfaces converted
+	// to another format change along with the palette, so these are copied whole
+	if (renderMode == kRenderOther && src.format.bytesPerPixel == 1) {
+		_damageRects.clear();
+		_damageRects.push_back(Common::Rect(src.w, src.h));
+		InvalidatePresentedScreen();
+	} else {
+		FindDamage(src);
+	}
 
-	case kRenderToRGBA:
-		// ARGB to RGBA
-		copySurface(src, true);
-		break;
+	_stats.PresentedPixels = 0;
+	_stats.PresentedRects = _damageRects.size();
+	for (size_t i = 0; i < _damageRects.size(); ++i) {
+		const Common::Rect &rect = _damageRects[i];
+		_stats.PresentedPixels += rect.width() * rect.height();
+
+		switch (renderMode) {
+		case kRenderToABGR:
+			// ARGB to ABGR
+			copySurface(src, rect, false);
+			break;
+
+		case kRenderToRGBA:
+			// ARGB to RGBA
+			copySurface(src, rect, true);
+			break;
+
+		case kRenderOther: {
+			// Blit the surface to the temporary screen, ignoring the alphas.
+			// This takes care of converting to the screen format
+			Graphics::Surface srcCopy = src;
+			srcCopy.format.aLoss = 8;
+
+			_screen->blitFrom(srcCopy, rect, Common::Point(rect.left, rect.top));
+			break;
+		}
 
-	case kRenderOther: {
-		// Blit the surface to the temporary screen, ignoring the alphas.
-		// This takes care of converting to the screen format
-		Graphics::Surface srcCopy = src;
-		srcCopy.format.aLoss = 8;
+		case kRenderDirect:
+			// Blit the virtual surface directly to the screen
+			g_system->copyRectToScreen(src.getBasePtr(rect.left, rect.top), src.pitch,
+				rect.left, rect.top, rect.width(), rect.height());
+			break;
 
-		_screen->blitFrom(srcCopy);
-		break;
+		default:
+			break;
+		}
 	}
 
-	case kRenderDirect:
-		// Blit the virtual surface directly to the screen
-		g_system->copyRectToScreen(src.getPixels(), src.pitch,
-			0, 0, src.w, src.h);
+	if (renderMode == kRenderDirect)
 		g_system->updateScreen();
-		return;
-
-	default:
-		break;
-	}
-
-	if (_screen)
+	else if (_screen)
 		_screen->update();
 }
 
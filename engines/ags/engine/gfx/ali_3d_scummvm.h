@@ -35,6 +35,8 @@
 #ifndef AGS_ENGINE_GFX_ALI_3D_SCUMMVM_H
 #define AGS_ENGINE_GFX_ALI_3D_SCUMMVM_H
 
+#include "common/rect.h"
+#include "graphics/surface.h"
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/vector.h"
 #include "ags/shared/core/platform.h"
@@ -95,6 +97,8 @@ public:
 	bool _opaque; // no mask color
 	bool _hasAlpha;
 	int _transparency;
+	// Changed each time the bitmap is updated, to tell when sprites must be drawn again
+	uint32_t _version;
 
 	ALSoftwareBitmap(Bitmap *bmp, bool opaque, bool hasAlpha) {
 		_bmp = bmp;
@@ -107,6 +111,7 @@ public:
 		_transparency = 0;
 		_opaque = opaque;
 		_hasAlpha = hasAlpha;
+		_version = 0;
 	}
 
 	int GetWidthToRender() {
@@ -150,6 +155,22 @@ private:
 
 
 typedef SpriteDrawListEntry<ALSoftwareBitmap> ALDrawListEntry;
+// State of a sprite drawn by a batch, as much as it affects the drawn pixels
+struct ALDrawnSprite {
+	ALSoftwareBitmap *DDB;
+	Bitmap           *Pixels;
+	uint32_t          Version;
+	int               X, Y;
+	int               Transparency;
+
+	bool operator==(const ALDrawnSprite &other) const {
+		return DDB == other.DDB && Pixels == other.Pixels && Version == other.Version &&
+		       X == other.X && Y == other.Y && Transparency == other.Transparency;
+	}
+	bool operator!=(const ALDrawnSprite &other) const {
+		return !(*this == other);
+	}
+};
 // Software renderer's sprite batch
 struct ALSpriteBatch {
 	// List of sprites to render
@@ -160,6 +181,11 @@ struct ALSpriteBatch {
 	bool                         IsVirtualScreen;
 	// Tells whether the surface is treated as opaque or transparent
 	bool                         Opaque;
+	// Whether surface is owned by the renderer, and only changes when the batch is rendered on it
+	bool                         OwnsSurface = false;
+	// Sprites that surface currently shows, only valid when it is owned by the renderer
+	std::vector<ALDrawnSprite>   DrawnSprites;
+	bool                         DrawnSpritesValid = false;
 };
 typedef std::vector<ALSpriteBatch> ALSpriteBatches;
 
@@ -227,6 +253,20 @@ public:
 	bool GetStageMatrixes(RenderMatrixes &rm) override {
 		return false; /* not supported */
 	}
+	void InvalidatePresentedScreen() override {
+		_presentedScreenValid = false;
+	}
+
+	// Work done for the last frame
+	struct RenderStats {
+		uint32_t SpritePixels = 0;    // pixels of the sprites and batch surfaces drawn on the virtual screen
+		uint32_t SkippedBatches = 0;  // batches whose surface did not need to be drawn again
+		uint32_t PresentedPixels = 0; // pixels copied to the system screen
+		uint32_t PresentedRects = 0;  // rects copied to the system screen
+	};
+	const RenderStats &GetRenderStats() const {
+		return _stats;
+	}
 
 	typedef std::shared_ptr<ScummVMRendererGfxFilter> PSDLRenderFilter;
 
@@ -264,6 +304,19 @@ private:
 	int _tint_red, _tint_green, _tint_blue;
 
 	ALSpriteBatches _spriteBatches;
+	// Version given to the next updated bitmap
+	uint32_t _nextBitmapVersion = 1;
+
+	// Size of the tiles the virtual screen is compared in, to find the parts
+	// that changed since it was last presented
+	static const int kDamageTileWidth = 64;
+	static const int kDamageTileHeight = 16;
+	// Copy of the virtual screen as it was last presented
+	Graphics::Surface _presentedScreen;
+	bool _presentedScreenValid = false;
+	// Parts of the virtual screen to present for the current frame
+	std::vector<Common::Rect> _damageRects;
+	RenderStats _stats;
 
 	void InitSpriteBatch(size_t index, const SpriteBatchDesc &desc) override;
 	void ResetAllBatches() override;
@@ -275,6 +328,13 @@ private:
 	void ReleaseDisplayMode();
 	// Renders single sprite batch on the precreated surface
 	void RenderSpriteBatch(const ALSpriteBatch &batch, Shared::Bitmap *surface, int surf_offx, int surf_offy);
+	// Tells whether the batch would draw the same sprites its surface already shows,
+	// and records them otherwise
+	bool UpdateDrawnSprites(ALSpriteBatch &batch, int surf_offx, int surf_offy);
+	// Finds the parts of the virtual screen which changed since it was last presented
+	void FindDamage(const Graphics::Surface &src);
+	// Adds a changed rect, joining it with the one it continues vertically if any
+	void AddDamageRect(const Common::Rect &rect);
 
 	void highcolor_fade_in(Bitmap *vs, void(*draw_callback)(), int offx, int offy, int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	void highcolor_fade_out(Bitmap *vs, void(*draw_callback)(), int offx, int offy, int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
@@ -282,7 +342,7 @@ private:
 	void __fade_out_range(int speed, int from, int to, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	// Copy raw screen bitmap pixels to the screen
 	void BlitToScreen();
-	void copySurface(const Graphics::Surface &src, bool mode);
+	void copySurface(const Graphics::Surface &src, const Common::Rect &rect, bool mode);
 	// Render bitmap on screen
 	void Present() { BlitToScreen(); }
 };
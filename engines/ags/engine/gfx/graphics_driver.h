@@ -196,6 +196,9 @@ public:
 	// These matrixes will be filled in accordance to the renderer's compatible format;
 	// returns false if renderer does not use matrixes (not a 3D renderer).
 	virtual bool GetStageMatrixes(RenderMatrixes &rm) = 0;
+	// Tells that the screen was drawn upon bypassing the renderer, so all of it
+	// has to be presented again on the next render
+	virtual void InvalidatePresentedScreen() = 0;
 	virtual bool RequiresFullRedrawEachFrame() = 0;
 	virtual bool HasAcceleratedTransform() = 0;
 	virtual bool UsesMemoryBackBuffer() = 0;
@@ -82,7 +82,9 @@ static bool play_video(Video::VideoDecoder *decoder, const char *name, int skip,
 	}
 
 	update_polled_stuff_if_runtime();
-	 
+
+	// The video is drawn straight on the screen, which has to be redrawn whole afterwards
+	_G(gfxDriver)->InvalidatePresentedScreen();
 	decoder->start();
 	while (!SHOULD_QUIT && !decoder->endOfVideo()) {
 		if (decoder->needsUpdate()) {
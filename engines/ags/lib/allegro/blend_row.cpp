@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "ags/lib/allegro/blend_row.h"
+#include "common/util.h"
+
+namespace AGS3 {
+
+// Row kernels for the blender modes, on 32-bit ARGB pixels. These produce
+// the same results as BITMAP::blendPixel, without unpacking the channels and
+// without branching, so that compilers can vectorize them.
+
+// Same as BITMAP::rgbBlend, for the RGB channels of two packed pixels
+static inline uint32 rgbBlend32(uint32 srcCol, uint32 destCol, uint32 alpha) {
+	if (alpha)
+		alpha++;
+
+	uint32 x = srcCol & 0xFFFFFF;
+	uint32 y = destCol & 0xFFFFFF;
+	uint32 res = ((x & 0xFF00FF) - (y & 0xFF00FF)) * alpha / 256 + y;
+	uint32 g = ((x & 0xFF00) - (y & 0xFF00)) * alpha / 256 + (y & 0xFF00);
+	return (res & 0xFF00FF) | (g & 0xFF00);
+}
+
+template<BlenderMode MODE>
+static inline uint32 blendPixel32(uint32 srcCol, uint32 destCol, uint32 alpha) {
+	switch (MODE) {
+	case kRgbToRgbBlender:
+		return rgbBlend32(srcCol, destCol, alpha);
+	case kAlphaPreservedBlenderMode:
+		return (destCol & 0xFF000000) | rgbBlend32(srcCol, destCol, alpha);
+	case kArgbToRgbBlender:
+		alpha = alpha ? (srcCol >> 24) * ((alpha & 0xff) + 1) / 256 : srcCol >> 24;
+		return rgbBlend32(srcCol, destCol, alpha);
+	case kSourceAlphaBlender:
+		return rgbBlend32(srcCol, destCol, srcCol >> 24);
+	case kOpaqueBlenderMode:
+		return srcCol | 0xFF000000;
+	case kAdditiveBlenderMode:
+		return (srcCol & 0xFFFFFF) | (MIN<uint32>((srcCol >> 24) + (destCol >> 24), 0xff) << 24);
+	default:
+		return destCol;
+	}
+}
+
+template<BlenderMode MODE, bool SKIP_TRANS>
+static void blendRow32(uint32 *destP, const uint32 *srcP, int count, int xDir,
+                       uint32 transColor, uint32 alphaMask, uint32 alpha) {
+	for (int x = 0; x < count; ++x) {
+		const uint32 srcCol = srcP[x * xDir];
+		const uint32 destCol = destP[x];
+		const uint32 blended = blendPixel32<MODE>(srcCol, destCol, alpha);
+		destP[x] = (SKIP_TRANS && (srcCol & alphaMask) == transColor) ? destCol : blended;
+	}
+}
+
+template<BlenderMode MODE>
+static BlendRow32 getBlendRow32(bool skipTrans) {
+	return skipTrans ? &blendRow32<MODE, true> : &blendRow32<MODE, false>;
+}
+
+BlendRow32 getBlendRow32(BlenderMode mode, bool skipTrans) {
+	switch (mode) {
+	case kRgbToRgbBlender:
+		return getBlendRow32<kRgbToRgbBlender>(skipTrans);
+	case kAlphaPreservedBlenderMode:
+		return getBlendRow32<kAlphaPreservedBlenderMode>(skipTrans);
+	case kArgbToRgbBlender:
+		return getBlendRow32<kArgbToRgbBlender>(skipTrans);
+	case kSourceAlphaBlender:
+		return getBlendRow32<kSourceAlphaBlender>(skipTrans);
+	case kOpaqueBlenderMode:
+		return getBlendRow32<kOpaqueBlenderMode>(skipTrans);
+	case kAdditiveBlenderMode:
+		return getBlendRow32<kAdditiveBlenderMode>(skipTrans);
+	default:
+		// The ARGB blenders work in floating point, and the tint ones in HSV
+		return nullptr;
+	}
+}
+
+} // namespace AGS3
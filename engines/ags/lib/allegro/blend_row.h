@@ -0,0 +1,46 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AGS_LIB_ALLEGRO_BLEND_ROW_H
+#define AGS_LIB_ALLEGRO_BLEND_ROW_H
+
+#include "ags/lib/allegro/color.h"
+
+namespace AGS3 {
+
+/**
+ * Blends a row of 32-bit ARGB pixels onto another one. The source is read
+ * backwards when xDir is -1. Source pixels matching transColor once masked
+ * by alphaMask are skipped, if the kernel was requested to skip them.
+ */
+typedef void (*BlendRow32)(uint32 *destP, const uint32 *srcP, int count, int xDir,
+                           uint32 transColor, uint32 alphaMask, uint32 alpha);
+
+/**
+ * Returns the row kernel for the blender mode, or nullptr if it is only
+ * handled by the per pixel blenders of BITMAP
+ */
+extern BlendRow32 getBlendRow32(BlenderMode mode, bool skipTrans);
+
+} // namespace AGS3
+
+#endif
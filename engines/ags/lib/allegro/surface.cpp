@@ -21,6 +21,7 @@
  */
 
 #include "ags/lib/allegro/gfx.h"
+#include "ags/lib/allegro/blend_row.h"
 #include "ags/lib/allegro/color.h"
 #include "ags/lib/allegro/flood.h"
 #include "ags/ags.h"
@@ -167,6 +168,14 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
 	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
 
+	// Blending between 32-bit ARGB bitmaps is done a whole row at a time
+	BlendRow32 blendRow = nullptr;
+	if (sameFormat && srcAlpha != -1 && !useTint &&
+	        format == Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24))
+		blendRow = getBlendRow32(_G(_blender_mode), skipTrans);
+	const int xCtrFirst = MAX(0, -xStart);
+	const int xCtrEnd = MIN<int>(dstRect.width(), destArea.w - xStart);
+
 	for (int destY = yStart, yCtr = 0; yCtr < dstRect.height(); ++destY, ++yCtr) {
 		if (destY < 0 || destY >= destArea.h)
 			continue;
@@ -176,6 +185,13 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 		                       vertFlip ? srcArea.bottom - 1 - yCtr :
 		                       srcArea.top + yCtr);
 
+		if (blendRow) {
+			if (xCtrFirst < xCtrEnd)
+				blendRow((uint32 *)destP + xStart + xCtrFirst, (const uint32 *)srcP + xDir * xCtrFirst,
+				         xCtrEnd - xCtrFirst, xDir, transColor, alphaMask, srcAlpha);
+			continue;
+		}
+
 		// Loop through the pixels of the row
 		for (int destX = xStart, xCtr = 0, xCtrBpp = 0; xCtr < dstRect.width(); ++destX, ++xCtr, xCtrBpp += src.format.bytesPerPixel) {
 			if (destX < 0 || destX >= destArea.w)
@@ -125,15 +125,17 @@ public:
 	}
 
 	private:
+	void blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const;
+
+	public:
 	// True color blender functions
 	// In Allegro all the blender functions are of the form
 	// unsigned int blender_func(unsigned long x, unsigned long y, unsigned long n)
 	// when x is the sprite color, y the destination color, and n an alpha value
+	// These are public so that the row kernels of blend_row.cpp can be
+	// checked against them.
 
-	void blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const;
-
-
-	inline void rgbBlend(uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void rgbBlend(uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Note: the original's handling varies slightly for R & B vs G.
 		// We need to exactly replicate it to ensure Lamplight City's
 		// calendar puzzle works correctly
@@ -153,7 +155,7 @@ public:
 		bDest = res & 0xff;
 	}
 
-	inline void argbBlend(uint32 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest) const {
+	static inline void argbBlend(uint32 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest) {
 		// Original logic has uint32 src and dst colors as ARGB8888
 		// ++src_alpha;
 		// uint32 dst_alpha = geta32(dst);
@@ -178,7 +180,7 @@ public:
 	}
 
 	// kRgbToRgbBlender
-	inline void blendRgbToRgb(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void blendRgbToRgb(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Default mode for set_trans_blender
 		rgbBlend(rSrc, gSrc, bSrc, rDest, gDest, bDest, alpha);
 		// Original doesn't set alpha (so it is 0), but the function is not meant to be used
@@ -187,7 +189,7 @@ public:
 	}
 
 	// kAlphaPreservedBlenderMode
-	inline void blendPreserveAlpha(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void blendPreserveAlpha(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Original blender function: _myblender_alpha_trans24
 		// Like blendRgbToRgb, but result as the same alpha as destColor
 		rgbBlend(rSrc, gSrc, bSrc, rDest, gDest, bDest, alpha);
@@ -195,7 +197,7 @@ public:
 	}
 
 	// kArgbToArgbBlender
-	inline void blendArgbToArgb(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void blendArgbToArgb(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Original blender functions: _argb2argb_blender
 		if (alpha == 0)
 			alpha = aSrc;
@@ -206,7 +208,7 @@ public:
 	}
 
 	// kRgbToArgbBlender
-	inline void blendRgbToArgb(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void blendRgbToArgb(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Original blender function: _rgb2argb_blenders
 		if (alpha == 0 || alpha == 0xff) {
 			aDest = 0xff;
@@ -218,7 +220,7 @@ public:
 	}
 
 	// kArgbToRgbBlender
-	inline void blendArgbToRgb(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void blendArgbToRgb(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Original blender function: _argb2rgb_blender
 		if (alpha == 0)
 			alpha = aSrc;
@@ -231,7 +233,7 @@ public:
 	}
 
 	// kOpaqueBlenderMode
-	inline void blendOpaque(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void blendOpaque(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Original blender function: _opaque_alpha_blender
 		aDest = 0xff;
 		rDest = rSrc;
@@ -240,7 +242,7 @@ public:
 	}
 
 	// kSourceAlphaBlender
-	inline void blendSourceAlpha(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void blendSourceAlpha(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Used after set_alpha_blender
 		// Uses alpha from source. Result is fully opaque
 		rgbBlend(rSrc, gSrc, bSrc, rDest, gDest, bDest, aSrc);
@@ -250,7 +252,7 @@ public:
 	}
 
 	// kAdditiveBlenderMode
-	inline void blendAdditiveAlpha(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+	static inline void blendAdditiveAlpha(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
 		// Original blender function: _additive_alpha_copysrc_blender
 		rDest = rSrc;
 		gDest = gSrc;
@@ -262,6 +264,7 @@ public:
 			aDest = static_cast<uint8>(a);
 	}
 
+	private:
 	// kTintBlenderMode and kTintLightBlenderMode
 	void blendTintSprite(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha, bool light) const;
 
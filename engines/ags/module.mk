@@ -12,6 +12,7 @@ MODULE_OBJS = \
 	lib/aastr-0.1.1/aastr.o \
 	lib/aastr-0.1.1/aautil.o \
 	lib/alfont/alfont.o \
+	lib/allegro/blend_row.o \
 	lib/allegro/color.o \
 	lib/allegro/config.o \
 	lib/allegro/draw.o \
@@ -1144,6 +1144,7 @@ void BladeRunnerEngine::gameTick() {
 	}
 
 	_sliceRenderer->setView(_view);
+	_sliceRenderer->resetStats();
 
 	// Tick and draw all actors in current set
 	int setId = _scene->getSetId();
@@ -1194,6 +1195,10 @@ void BladeRunnerEngine::gameTick() {
 		_debugger->drawDebuggerOverlay();
 	}
 
+	if (_debugger->_showSliceStats) {
+		_debugger->drawSliceStats();
+	}
+
 	if (_debugger->_viewObstacles) {
 		_obstacles->draw();
 	}
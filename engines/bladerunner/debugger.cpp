@@ -45,6 +45,7 @@
 #include "bladerunner/settings.h"
 #include "bladerunner/set.h"
 #include "bladerunner/set_effects.h"
+#include "bladerunner/slice_renderer.h"
 #include "bladerunner/text_resource.h"
 #include "bladerunner/time.h"
 #include "bladerunner/vector.h"
@@ -110,6 +111,7 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 	_showStatsVk = false;
 	_showMazeScore = false;
 	_showMouseClickInfo = false;
+	_showSliceStats = false;
 
 	registerCmd("anim", WRAP_METHOD(Debugger, cmdAnimation));
 	registerCmd("health", WRAP_METHOD(Debugger, cmdHealth));
@@ -137,6 +139,7 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 	registerCmd("region", WRAP_METHOD(Debugger, cmdRegion));
 	registerCmd("click", WRAP_METHOD(Debugger, cmdClick));
 	registerCmd("difficulty", WRAP_METHOD(Debugger, cmdDifficulty));
+	registerCmd("slices", WRAP_METHOD(Debugger, cmdSlices));
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	registerCmd("effect", WRAP_METHOD(Debugger, cmdEffect));
@@ -1884,6 +1887,36 @@ bool Debugger::cmdClick(int argc, const char **argv) {
 	return true;
 }
 
+/**
+* Show the statistics of the slice renderer for the last frame, or toggle showing them on screen
+*/
+bool Debugger::cmdSlices(int argc, const char **argv) {
+	bool invalidSyntax = false;
+
+	if (argc == 1) {
+		const SliceRenderer::Stats &stats = _vm->_sliceRenderer->getStats();
+		debugPrintf("Last frame: %u models, %u slice lines, %u us\n", stats.modelsDrawn, stats.linesDrawn, stats.drawTime);
+	} else if (argc == 2) {
+		Common::String argName = argv[1];
+		argName.toLowercase();
+		if (argName == "toggle") {
+			_showSliceStats = !_showSliceStats;
+			debugPrintf("Showing slice renderer statistics = %s\n", _showSliceStats ? "True":"False");
+		} else {
+			invalidSyntax = true;
+		}
+	} else {
+		invalidSyntax = true;
+	}
+
+	if (invalidSyntax) {
+		debugPrintf("Show the number of models and slice lines drawn in the last frame, and the time taken\n");
+		debugPrintf("or toggle showing them on screen every frame\n");
+		debugPrintf("Usage: %s [toggle]\n", argv[0]);
+	}
+	return true;
+}
+
 /**
 * Auxiliary function to get a descriptive string for a given difficulty value
 */
@@ -2629,6 +2662,12 @@ void Debugger::drawScreenEffects() {
 	}
 }
 
+void Debugger::drawSliceStats() {
+	const SliceRenderer::Stats &stats = _vm->_sliceRenderer->getStats();
+	Common::String text = Common::String::format("Models: %u  Slice lines: %u  Time: %u us", stats.modelsDrawn, stats.linesDrawn, stats.drawTime);
+	_vm->_mainFont->drawString(&_vm->_surfaceFront, text, 4, 4, _vm->_surfaceFront.w, _vm->_surfaceFront.format.RGBToColor(255, 255, 255));
+}
+
 void Debugger::toggleObjectInDbgDrawList(DebuggerDrawnObject &drObj) {
 	if (drObj.type == debuggerObjTypeUndefined || drObj.objId < 0) {
 		return;
@@ -86,6 +86,7 @@ public:
 	bool _showStatsVk;
 	bool _showMazeScore;
 	bool _showMouseClickInfo;
+	bool _showSliceStats;
 
 	Debugger(BladeRunnerEngine *vm);
 	~Debugger() override;
@@ -115,6 +116,7 @@ public:
 	bool cmdRegion(int argc, const char **argv);
 	bool cmdClick(int argc, const char **argv);
 	bool cmdDifficulty(int argc, const char **argv);
+	bool cmdSlices(int argc, const char **argv);
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	bool cmdEffect(int argc, const char **argv);
@@ -133,6 +135,7 @@ public:
 	void drawWaypoints();
 	void drawWalkboxes();
 	void drawScreenEffects();
+	void drawSliceStats();
 
 	bool dbgAttemptToLoadChapterSetScene(int chapterId, int setId, int sceneId);
 
@@ -30,6 +30,7 @@
 
 #include "common/memstream.h"
 #include "common/rect.h"
+#include "common/threadpool.h"
 #include "common/util.h"
 
 namespace BladeRunner {
@@ -62,6 +63,11 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 	_m13               = 0;
 	_m23               = 0;
 
+	_linesSurface = nullptr;
+	_linesZBuffer = nullptr;
+	_pool = new Common::ThreadPool();
+	resetStats();
+
 	_shadowPolygonDefault[ 0] = Vector3( 16.0f,  96.0f, 0.0f);
 	_shadowPolygonDefault[ 1] = Vector3( 16.0f, 160.0f, 0.0f);
 	_shadowPolygonDefault[ 2] = Vector3( 64.0f, 192.0f, 0.0f);
@@ -81,6 +87,7 @@ SliceRenderer::SliceRenderer(BladeRunnerEngine *vm) {
 }
 
 SliceRenderer::~SliceRenderer() {
+	delete _pool;
 }
 
 void SliceRenderer::setScreenEffects(ScreenEffects *screenEffects) {
@@ -412,14 +419,6 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 		&setEffectsColorCoeficient,
 		&setEffectColor);
 
-	_lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
-	_lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
-	_lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
-
-	_setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
-	_setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
-	_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
-
 	setupLookupTable(_m12lookup, sliceLineIterator._sliceMatrix(0, 1));
 	setupLookupTable(_m11lookup, sliceLineIterator._sliceMatrix(0, 0));
 	_m13 = sliceLineIterator._sliceMatrix(0, 2);
@@ -441,13 +440,12 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 		drawShadowInWorld(transparency, surface, zbuffer);
 	}
 
-	int frameY = sliceLineIterator._startY;
+	uint64 startTime = g_system->getMicros();
 
-	uint16 *zBufferLinePtr = zbuffer + 640 * frameY;
+	int frameY = sliceLineIterator._startY;
 
+	_lines.clear();
 	while (sliceLineIterator._currentY <= sliceLineIterator._endY) {
-		_m13 = sliceLineIterator._sliceMatrix(0, 2);
-		_m23 = sliceLineIterator._sliceMatrix(1, 2);
 		sliceLine = sliceLineIterator.line();
 
 		sliceRendererLights.calculateColorSlice(Vector3(_position.x, _position.y, _position.z + _frameBottomZ + sliceLine * _frameSliceHeight));
@@ -460,21 +458,42 @@ void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 pos
 				&setEffectColor);
 		}
 
-		_lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
-		_lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
-		_lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
+		if (frameY >= 0 && frameY < surface.h) {
+			SliceLine line;
+			line.y = frameY;
+			line.slice = (int)sliceLine;
+			line.m13 = sliceLineIterator._sliceMatrix(0, 2);
+			line.m23 = sliceLineIterator._sliceMatrix(1, 2);
 
-		_setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
-		_setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
-		_setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
+			line.lightsColor.r = setEffectsColorCoeficient * sliceRendererLights._finalColor.r * 65536.0f;
+			line.lightsColor.g = setEffectsColorCoeficient * sliceRendererLights._finalColor.g * 65536.0f;
+			line.lightsColor.b = setEffectsColorCoeficient * sliceRendererLights._finalColor.b * 65536.0f;
 
-		if (frameY >= 0 && frameY < surface.h) {
-			drawSlice((int)sliceLine, true, frameY, surface, zBufferLinePtr);
+			line.setEffectColor.r = setEffectColor.r * 31.0f * 65536.0f;
+			line.setEffectColor.g = setEffectColor.g * 31.0f * 65536.0f;
+			line.setEffectColor.b = setEffectColor.b * 31.0f * 65536.0f;
+
+			_lines.push_back(line);
 		}
 
 		sliceLineIterator.advance();
 		++frameY;
-		zBufferLinePtr += 640;
+	}
+
+	// Each line only touches its own row of the surface and of the z-buffer
+	_linesSurface = &surface;
+	_linesZBuffer = zbuffer;
+	Common::Functor2Mem<int, int, void, SliceRenderer> body(this, &SliceRenderer::drawLines);
+	_pool->parallelFor(0, _lines.size(), MAX<int>(32, _lines.size() / (2 * (_pool->getNumWorkers() + 1))), body);
+
+	++_stats.modelsDrawn;
+	_stats.linesDrawn += _lines.size();
+	_stats.drawTime += g_system->getMicros() - startTime;
+}
+
+void SliceRenderer::drawLines(int first, int last) {
+	for (int i = first; i < last; ++i) {
+		drawSlice(_lines[i], true, *_linesSurface, _linesZBuffer + 640 * _lines[i].y);
 	}
 }
 
@@ -528,24 +547,43 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 
 	uint16 lineZbuffer[640];
 
+	SliceLine line;
+	line.m13 = _m13;
+	line.m23 = _m23;
+
 	while (currentSlice < _frameSliceCount) {
 		if (currentY >= 0 && currentY < surface.h) {
 			memset(lineZbuffer, 0xFF, 640 * 2);
-			drawSlice(currentSlice, false, currentY, surface, lineZbuffer);
+			line.y = currentY;
+			line.slice = currentSlice;
+			drawSlice(line, false, surface, lineZbuffer);
 			currentSlice += sliceStep;
 			--currentY;
 		}
 	}
 }
 
-void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
-	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
+/**
+ * Draws the pixels of a span closer than the z-buffer. The loop has no
+ * branches so that the compiler can vectorize it.
+ */
+template<typename T>
+static inline void drawSpan(T *dst, uint16 *zbuffer, int count, uint16 z, T color) {
+	for (int x = 0; x < count; ++x) {
+		const bool visible = z < zbuffer[x];
+		zbuffer[x] = visible ? z : zbuffer[x];
+		dst[x] = visible ? color : dst[x];
+	}
+}
+
+void SliceRenderer::drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine) const {
+	if (line.slice < 0 || (uint32)line.slice >= _frameSliceCount) {
 		return;
 	}
 
-	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
+	const SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
-	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
+	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * line.slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
 
@@ -554,6 +592,10 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 	uint32 polyCount = READ_LE_UINT32(p);
 	p += 4;
 
+	const int y = line.y;
+	byte *dstLine = (byte *)surface.getBasePtr(0, y);
+	const int maxX = MIN<int>(640, surface.w);
+
 	while (polyCount--) {
 		uint32 vertexCount = READ_LE_UINT32(p);
 		p += 4;
@@ -562,15 +604,15 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 			continue;
 
 		uint32 lastVertex = vertexCount - 1;
-		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + _m13) / 65536, 0);
+		int lastVertexX = MAX((_m11lookup[p[3 * lastVertex]] + _m12lookup[p[3 * lastVertex + 1]] + line.m13) / 65536, 0);
 
 		int previousVertexX = lastVertexX;
 
 		while (vertexCount--) {
-			int vertexX = CLIP((_m11lookup[p[0]] + _m12lookup[p[1]] + _m13) / 65536, 0, 640);
+			int vertexX = CLIP((_m11lookup[p[0]] + _m12lookup[p[1]] + line.m13) / 65536, 0, maxX);
 
 			if (vertexX > previousVertexX) {
-				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
+				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + line.m23) / 64;
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
 					uint32 outColor = palette.value[p[2]];
@@ -579,20 +621,26 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
 
 						Color256 color = palette.color[p[2]];
-						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
-						color.g = ((int)(_setEffectColor.g + _lightsColor.g * color.g) / 65536) + aescColor.g;
-						color.b = ((int)(_setEffectColor.b + _lightsColor.b * color.b) / 65536) + aescColor.b;
+						color.r = ((int)(line.setEffectColor.r + line.lightsColor.r * color.r) / 65536) + aescColor.r;
+						color.g = ((int)(line.setEffectColor.g + line.lightsColor.g * color.g) / 65536) + aescColor.g;
+						color.b = ((int)(line.setEffectColor.b + line.lightsColor.b * color.b) / 65536) + aescColor.b;
 						// We need to convert from 5 bits per channel (r,g,b) to 8 bits
 						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
-						if (vertexZ < zbufferLine[x]) {
-							zbufferLine[x] = (uint16)vertexZ;
-
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
-							drawPixel(surface, dstPtr, outColor);
-						}
+					const int count = vertexX - previousVertexX;
+					switch (surface.format.bytesPerPixel) {
+					case 1:
+						drawSpan<uint8>(dstLine + previousVertexX, zbufferLine + previousVertexX, count, vertexZ, outColor);
+						break;
+					case 2:
+						drawSpan<uint16>((uint16 *)dstLine + previousVertexX, zbufferLine + previousVertexX, count, vertexZ, outColor);
+						break;
+					case 4:
+						drawSpan<uint32>((uint32 *)dstLine + previousVertexX, zbufferLine + previousVertexX, count, vertexZ, outColor);
+						break;
+					default:
+						break;
 					}
 				}
 			}
@@ -750,6 +798,12 @@ void SliceRenderer::preload(int animationId) {
 	}
 }
 
+void SliceRenderer::resetStats() {
+	_stats.modelsDrawn = 0;
+	_stats.linesDrawn = 0;
+	_stats.drawTime = 0;
+}
+
 void SliceRenderer::disableShadows(int animationsIdsList[], int listSize) {
 	for (int i = 0; i < listSize; ++i) {
 		_animationsShadowEnabled[animationsIdsList[i]] = false;
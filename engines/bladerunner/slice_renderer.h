@@ -28,12 +28,14 @@
 #include "bladerunner/view.h"
 #include "bladerunner/matrix.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 #include "graphics/surface.h"
 
 namespace Common {
 class MemoryReadStream;
+class ThreadPool;
 }
 
 namespace BladeRunner {
@@ -44,6 +46,29 @@ class Lights;
 class SetEffects;
 
 class SliceRenderer {
+public:
+	struct Stats {
+		uint32 modelsDrawn;
+		uint32 linesDrawn;
+		uint32 drawTime; // in microseconds
+	};
+
+private:
+	/**
+	 * A screen line of a model: the slice drawn on it and its lighting.
+	 * The lines are set up one after the other since the lighting of a
+	 * line depends on the previous ones, and then rasterized in parallel
+	 * since they cover disjoint rows of the screen.
+	 */
+	struct SliceLine {
+		int   y;
+		int   slice;
+		int   m13;
+		int   m23;
+		Color lightsColor;
+		Color setEffectColor;
+	};
+
 	BladeRunnerEngine *_vm;
 
 	int       _animation;
@@ -86,11 +111,15 @@ class SliceRenderer {
 	Vector3 _shadowPolygonDefault[12];
 	Vector3 _shadowPolygonCurrent[12];
 
-	Color _setEffectColor;
-	Color _lightsColor;
-
 	Graphics::PixelFormat _pixelFormat;
 
+	Common::Array<SliceLine> _lines;
+	Graphics::Surface       *_linesSurface;
+	uint16                  *_linesZBuffer;
+	Common::ThreadPool      *_pool;
+
+	Stats _stats;
+
 public:
 	SliceRenderer(BladeRunnerEngine *vm);
 	~SliceRenderer();
@@ -109,12 +138,16 @@ public:
 
 	void disableShadows(int *animationsIdsList, int listSize);
 
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
 private:
 	void calculateBoundingRect();
 	Matrix3x2 calculateFacingRotationMatrix();
 	void loadFrame(int animation, int frame);
 
-	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	void drawLines(int first, int last);
+	void drawSlice(const SliceLine &line, bool advanced, Graphics::Surface &surface, uint16 *zbufferLine) const;
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
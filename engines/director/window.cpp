@@ -169,8 +169,15 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		}
 	}
 
+	if (!forceRedraw && blitTo == _composeSurface && !_dirtyRects.empty()) {
+		// Only the parts of the stage which changed are composited again
+		for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); i++)
+			addDamagedRect(*i);
+	} else {
+		_contentIsDirty = true;
+	}
+
 	_dirtyRects.clear();
-	_contentIsDirty = true;
 
 	return true;
 }
@@ -34,11 +34,13 @@
 #include "graphics/larryScale.h"
 #include "common/config-manager.h"
 #include "common/gui_options.h"
+#include "common/threadpool.h"
 
 namespace Sci {
 #pragma mark CelScaler
 
 CelScaler *CelObj::_scaler = nullptr;
+Common::ThreadPool *CelObj::_renderPool = nullptr;
 
 void CelScaler::activateScaleTables(const Ratio &scaleX, const Ratio &scaleY) {
 	for (int i = 0; i < ARRAYSIZE(_scaleTables); ++i) {
@@ -82,9 +84,121 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 	return _scaleTables[_activeIndex];
 }
 
+#pragma mark -
+#pragma mark DecodedCelCache
+
+bool DecodedCel::hasColorIn(const uint8 first, const uint8 last) const {
+	for (uint color = first; color <= last; ++color) {
+		if (colors[color / 32] & (1 << (color % 32))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+DecodedCelCache::DecodedCelCache(const uint32 budget) :
+	_budget(budget),
+	_size(0),
+	_nextId(1),
+	_hits(0),
+	_misses(0),
+	_evictions(0) {}
+
+DecodedCelCache::~DecodedCelCache() {
+	clear();
+}
+
+const DecodedCel *DecodedCelCache::get(const CelInfo32 &info, const bool count) {
+	CelMap::iterator it = _cels.find(info);
+	if (it == _cels.end()) {
+		if (count) {
+			++_misses;
+		}
+		return nullptr;
+	}
+
+	if (count) {
+		if (it->_value.missPending) {
+			++_misses;
+			it->_value.missPending = false;
+		} else {
+			++_hits;
+		}
+	}
+	it->_value.id = ++_nextId;
+	return &it->_value;
+}
+
+const DecodedCel *DecodedCelCache::peek(const CelInfo32 &info) const {
+	CelMap::const_iterator it = _cels.find(info);
+	return it != _cels.end() ? &it->_value : nullptr;
+}
+
+const DecodedCel *DecodedCelCache::add(const CelInfo32 &info, byte *pixels, const uint32 size, const uint8 skipColor, const bool counted) {
+	if (!fits(size)) {
+		free(pixels);
+		return nullptr;
+	}
+
+	while (_size + size > _budget) {
+		evictOldest();
+	}
+
+	DecodedCel &cel = _cels[info];
+	cel.pixels = pixels;
+	cel.size = size;
+	cel.id = ++_nextId;
+	cel.missPending = !counted;
+	for (uint32 i = 0; i < size; ++i) {
+		const byte pixel = pixels[i];
+		if (pixel == skipColor) {
+			cel.hasSkip = true;
+		} else {
+			cel.colors[pixel / 32] |= 1 << (pixel % 32);
+		}
+	}
+
+	_size += size;
+	return &cel;
+}
+
+void DecodedCelCache::evictOldest() {
+	CelMap::iterator oldest = _cels.begin();
+	for (CelMap::iterator it = _cels.begin(); it != _cels.end(); ++it) {
+		if (it->_value.id < oldest->_value.id) {
+			oldest = it;
+		}
+	}
+
+	_size -= oldest->_value.size;
+	free(oldest->_value.pixels);
+	_cels.erase(oldest);
+	++_evictions;
+}
+
+void DecodedCelCache::clear() {
+	for (CelMap::iterator it = _cels.begin(); it != _cels.end(); ++it) {
+		free(it->_value.pixels);
+	}
+	_cels.clear();
+	_size = 0;
+}
+
 #pragma mark -
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
+DecodedCelCache *CelObj::_decodedCache = nullptr;
+
+/**
+ * The default budget of the decoded cel cache, in kilobytes.
+ */
+static const int kDefaultDecodedCelCacheSize = 8192;
+
+/**
+ * The largest budget of the decoded cel cache, in kilobytes, which keeps the
+ * budget in bytes within 32 bits.
+ */
+static const int kMaxDecodedCelCacheSize = 1024 * 1024;
 
 void CelObj::init() {
 	CelObj::deinit();
@@ -92,6 +206,12 @@ void CelObj::init() {
 	_nextCacheId = 1;
 	_scaler = new CelScaler();
 	_cache = new CelCache(100);
+	_renderPool = new Common::ThreadPool();
+
+	const int decodedCacheSize = ConfMan.hasKey("cel_cache_size") ? ConfMan.getInt("cel_cache_size") : kDefaultDecodedCelCacheSize;
+	if (decodedCacheSize > 0) {
+		_decodedCache = new DecodedCelCache((uint32)MIN(decodedCacheSize, kMaxDecodedCelCacheSize) * 1024);
+	}
 }
 
 void CelObj::deinit() {
@@ -99,6 +219,10 @@ void CelObj::deinit() {
 	_scaler = nullptr;
 	delete _cache;
 	_cache = nullptr;
+	delete _renderPool;
+	_renderPool = nullptr;
+	delete _decodedCache;
+	_decodedCache = nullptr;
 }
 
 #pragma mark -
@@ -106,47 +230,34 @@ void CelObj::deinit() {
 
 template<bool FLIP, typename READER>
 struct SCALER_NoScale {
-#ifndef NDEBUG
-	const byte *_rowEdge;
-#endif
-	const byte *_row;
 	READER _reader;
 	const int16 _lastIndex;
 	const int16 _sourceX;
 	const int16 _sourceY;
 
 	SCALER_NoScale(const CelObj &celObj, const int16 maxWidth, const Common::Point &scaledPosition) :
-	_row(nullptr),
 	_reader(celObj, FLIP ? celObj._width : maxWidth),
 	_lastIndex(celObj._width - 1),
 	_sourceX(scaledPosition.x),
 	_sourceY(scaledPosition.y) {}
 
-	inline void setTarget(const int16 x, const int16 y) {
-		_row = _reader.getRow(y - _sourceY);
-
-		if (FLIP) {
-#ifndef NDEBUG
-			_rowEdge = _row - 1;
-#endif
-			_row += _lastIndex - (x - _sourceX);
-			assert(_row > _rowEdge);
-		} else {
-#ifndef NDEBUG
-			_rowEdge = _row + _lastIndex + 1;
-#endif
-			_row += x - _sourceX;
-			assert(_row < _rowEdge);
-		}
-	}
-
-	inline byte read() {
-		assert(_row != _rowEdge);
+	/**
+	 * Returns the `width` source pixels drawn from target position (x, y).
+	 * `buffer` receives them when they are not contiguous in the source.
+	 */
+	inline const byte *getRow(const int16 x, const int16 y, const int16 width, byte *buffer) {
+		const byte *row = _reader.getRow(y - _sourceY);
 
 		if (FLIP) {
-			return *_row--;
+			const byte *source = row + _lastIndex - (x - _sourceX);
+			assert(source - (width - 1) >= row);
+			for (int16 i = 0; i < width; ++i) {
+				buffer[i] = *source--;
+			}
+			return buffer;
 		} else {
-			return *_row++;
+			assert(x - _sourceX + width - 1 <= _lastIndex);
+			return row + x - _sourceX;
 		}
 	}
 };
@@ -157,17 +268,15 @@ struct SCALER_Scale {
 	int16 _minX;
 	int16 _maxX;
 #endif
-	const byte *_row;
 	READER _reader;
 	// If _sourceBuffer is set, it contains the full (possibly scaled) source
 	// image and takes precedence over _reader.
 	Common::SharedPtr<Buffer> _sourceBuffer;
-	int16 _x;
+	int16 _lastSourceY;
 	static int16 _valuesX[kCelScalerTableSize];
 	static int16 _valuesY[kCelScalerTableSize];
 
 	SCALER_Scale(const CelObj &celObj, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio scaleX, const Ratio scaleY) :
-	_row(nullptr),
 #ifndef NDEBUG
 	_minX(targetRect.left),
 	_maxX(targetRect.right - 1),
@@ -176,7 +285,8 @@ struct SCALER_Scale {
 	// data it requires if downscaling, so just always make the reader
 	// decompress an entire line of source data when scaling
 	_reader(celObj, celObj._width),
-	_sourceBuffer() {
+	_sourceBuffer(),
+	_lastSourceY(-1) {
 #ifndef NDEBUG
 		assert(_minX <= _maxX);
 #endif
@@ -293,17 +403,28 @@ struct SCALER_Scale {
 		}
 	}
 
-	inline void setTarget(const int16 x, const int16 y) {
-		_row = _sourceBuffer
-			? static_cast<const byte *>( _sourceBuffer->getBasePtr(0, _valuesY[y]))
-			: _reader.getRow(_valuesY[y]);
-		_x = x;
-		assert(_x >= _minX && _x <= _maxX);
-	}
+	/**
+	 * Returns the `width` source pixels drawn from target position (x, y),
+	 * gathered into `buffer`. Consecutive target rows reading the same source
+	 * row when upscaling reuse the pixels already in `buffer`.
+	 */
+	inline const byte *getRow(const int16 x, const int16 y, const int16 width, byte *buffer) {
+		assert(x >= _minX && x + width - 1 <= _maxX);
 
-	inline byte read() {
-		assert(_x >= _minX && _x <= _maxX);
-		return _row[_valuesX[_x++]];
+		const int16 sourceY = _valuesY[y];
+		if (sourceY == _lastSourceY) {
+			return buffer;
+		}
+		_lastSourceY = sourceY;
+
+		const byte *row = _sourceBuffer
+			? static_cast<const byte *>(_sourceBuffer->getBasePtr(0, sourceY))
+			: _reader.getRow(sourceY);
+		const int16 *valuesX = _valuesX + x;
+		for (int16 i = 0; i < width; ++i) {
+			buffer[i] = row[valuesX[i]];
+		}
+		return buffer;
 	}
 };
 
@@ -329,6 +450,15 @@ public:
 	_sourceHeight(celObj._height),
 #endif
 	_sourceWidth(celObj._width) {
+		if (celObj._compressionType != kCelCompressionNone) {
+			// RLE cels are only drawn through this reader once decompressed
+			// by CelObj::getDecodedCel
+			const DecodedCel *decodedCel = CelObj::_decodedCache->peek(celObj._info);
+			assert(decodedCel);
+			_pixels = decodedCel->pixels;
+			return;
+		}
+
 		const SciSpan<const byte> resource = celObj.getResPointer();
 		const uint32 pixelsOffset = resource.getUint32SEAt(celObj._celHeaderOffset + 24);
 		const int32 numPixels = MIN<int32>(resource.size() - pixelsOffset, celObj._width * celObj._height);
@@ -435,6 +565,31 @@ public:
 	}
 };
 
+const DecodedCel *CelObj::getDecodedCel(const bool countLookup) const {
+	if (!_decodedCache || _compressionType != kCelCompressionRLE ||
+		(_info.type != kCelTypeView && _info.type != kCelTypePic)) {
+		return nullptr;
+	}
+
+	const DecodedCel *decodedCel = _decodedCache->get(_info, countLookup);
+	if (decodedCel) {
+		return decodedCel;
+	}
+
+	const uint32 size = _width * _height;
+	if (!size || !_decodedCache->fits(size)) {
+		return nullptr;
+	}
+
+	byte *pixels = (byte *)malloc(size);
+	READER_Compressed reader(*this, _width);
+	for (int16 y = 0; y < _height; ++y) {
+		memcpy(pixels + y * _width, reader.getRow(y), _width);
+	}
+
+	return _decodedCache->add(_info, pixels, size, _skipColor, countLookup);
+}
+
 #pragma mark -
 #pragma mark CelObj - Remappers
 
@@ -469,6 +624,34 @@ struct MAPPER_NoMD {
 			*target = translateMacColor(isMacSource, pixel);
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor, const bool isMacSource) const {
+		int16 x = 0;
+		if (!isMacSource) {
+			// Eight pixels are tested at once: runs without any transparent
+			// pixel are copied as a whole, and fully transparent runs skipped
+			const uint64 ones = (uint64)-1 / 0xFF; // 0x0101...01
+			const uint64 skipPattern = skipColor * ones;
+			for (; x + 8 <= width; x += 8) {
+				const uint64 pixels = READ_UINT64(source + x);
+				const uint64 diff = pixels ^ skipPattern;
+				// No byte of diff is zero when no pixel is transparent
+				if (!((diff - ones) & ~diff & (ones << 7))) {
+					WRITE_UINT64(target + x, pixels);
+				} else if (diff) {
+					for (int16 i = x; i < x + 8; ++i) {
+						if (source[i] != skipColor) {
+							target[i] = source[i];
+						}
+					}
+				}
+			}
+		}
+
+		for (; x < width; ++x) {
+			draw(target + x, source[x], skipColor, isMacSource);
+		}
+	}
 };
 
 /**
@@ -479,6 +662,17 @@ struct MAPPER_NoMDNoSkip {
 	inline void draw(byte *target, const byte pixel, const uint8, const bool isMacSource) const {
 		*target = translateMacColor(isMacSource, pixel);
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor, const bool isMacSource) const {
+		if (!isMacSource) {
+			memcpy(target, source, width);
+			return;
+		}
+
+		for (int16 x = 0; x < width; ++x) {
+			draw(target + x, source[x], skipColor, isMacSource);
+		}
+	}
 };
 
 /**
@@ -497,6 +691,12 @@ struct MAPPER_Map {
 			}
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor, const bool isMacSource) const {
+		for (int16 x = 0; x < width; ++x) {
+			draw(target + x, source[x], skipColor, isMacSource);
+		}
+	}
 };
 
 /**
@@ -511,6 +711,15 @@ struct MAPPER_NoMap {
 			*target = translateMacColor(isMacSource, pixel);
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor, const bool isMacSource) const {
+		const uint8 startColor = g_sci->_gfxRemap32->getStartColor();
+		for (int16 x = 0; x < width; ++x) {
+			if (source[x] != skipColor && source[x] < startColor) {
+				target[x] = translateMacColor(isMacSource, source[x]);
+			}
+		}
+	}
 };
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
@@ -519,13 +728,18 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 	const Ratio &scaleY = screenItem._ratioY;
 	_drawBlackLines = screenItem._drawBlackLines;
 
+	// Decompressed RLE cels are drawn like uncompressed ones
+	const DecodedCel *decodedCel = getDecodedCel();
+	const bool uncompressed = _compressionType == kCelCompressionNone || decodedCel;
+	const bool transparent = decodedCel ? decodedCel->hasSkip : _transparent;
+
 	if (_remap) {
 		// In SSCI, this check was `g_Remap_numActiveRemaps && _remap`, but
 		// since we are already in a `_remap` branch, there is no reason to
 		// check that again
 		if (g_sci->_gfxRemap32->getRemapCount()) {
 			if (scaleX.isOne() && scaleY.isOne()) {
-				if (_compressionType == kCelCompressionNone) {
+				if (uncompressed) {
 					if (_drawMirrored) {
 						drawUncompHzFlipMap(target, targetRect, scaledPosition);
 					} else {
@@ -539,7 +753,7 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 					}
 				}
 			} else {
-				if (_compressionType == kCelCompressionNone) {
+				if (uncompressed) {
 					scaleDrawUncompMap(target, scaleX, scaleY, targetRect, scaledPosition);
 				} else {
 					scaleDrawMap(target, scaleX, scaleY, targetRect, scaledPosition);
@@ -547,7 +761,7 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 			}
 		} else {
 			if (scaleX.isOne() && scaleY.isOne()) {
-				if (_compressionType == kCelCompressionNone) {
+				if (uncompressed) {
 					if (_drawMirrored) {
 						drawUncompHzFlip(target, targetRect, scaledPosition);
 					} else {
@@ -561,7 +775,7 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 					}
 				}
 			} else {
-				if (_compressionType == kCelCompressionNone) {
+				if (uncompressed) {
 					scaleDrawUncomp(target, scaleX, scaleY, targetRect, scaledPosition);
 				} else {
 					scaleDraw(target, scaleX, scaleY, targetRect, scaledPosition);
@@ -570,8 +784,8 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 		}
 	} else {
 		if (scaleX.isOne() && scaleY.isOne()) {
-			if (_compressionType == kCelCompressionNone) {
-				if (_transparent) {
+			if (uncompressed) {
+				if (transparent) {
 					if (_drawMirrored) {
 						drawUncompHzFlipNoMD(target, targetRect, scaledPosition);
 					} else {
@@ -592,7 +806,7 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 				}
 			}
 		} else {
-			if (_compressionType == kCelCompressionNone) {
+			if (uncompressed) {
 				scaleDrawUncompNoMD(target, scaleX, scaleY, targetRect, scaledPosition);
 			} else {
 				scaleDrawNoMD(target, scaleX, scaleY, targetRect, scaledPosition);
@@ -615,9 +829,10 @@ void CelObj::draw(Buffer &target, const Common::Rect &targetRect, const Common::
 }
 
 void CelObj::drawTo(Buffer &target, Common::Rect const &targetRect, Common::Point const &scaledPosition, Ratio const &scaleX, Ratio const &scaleY) const {
+	const bool uncompressed = _compressionType == kCelCompressionNone || getDecodedCel();
 	if (_remap) {
 		if (scaleX.isOne() && scaleY.isOne()) {
-			if (_compressionType == kCelCompressionNone) {
+			if (uncompressed) {
 				if (_drawMirrored) {
 					drawUncompHzFlipMap(target, targetRect, scaledPosition);
 				} else {
@@ -631,7 +846,7 @@ void CelObj::drawTo(Buffer &target, Common::Rect const &targetRect, Common::Poin
 				}
 			}
 		} else {
-			if (_compressionType == kCelCompressionNone) {
+			if (uncompressed) {
 				scaleDrawUncompMap(target, scaleX, scaleY, targetRect, scaledPosition);
 			} else {
 				scaleDrawMap(target, scaleX, scaleY, targetRect, scaledPosition);
@@ -639,7 +854,7 @@ void CelObj::drawTo(Buffer &target, Common::Rect const &targetRect, Common::Poin
 		}
 	} else {
 		if (scaleX.isOne() && scaleY.isOne()) {
-			if (_compressionType == kCelCompressionNone) {
+			if (uncompressed) {
 				if (_drawMirrored) {
 					drawUncompHzFlipNoMD(target, targetRect, scaledPosition);
 				} else {
@@ -653,7 +868,7 @@ void CelObj::drawTo(Buffer &target, Common::Rect const &targetRect, Common::Poin
 				}
 			}
 		} else {
-			if (_compressionType == kCelCompressionNone) {
+			if (uncompressed) {
 				scaleDrawUncompNoMD(target, scaleX, scaleY, targetRect, scaledPosition);
 			} else {
 				scaleDrawNoMD(target, scaleX, scaleY, targetRect, scaledPosition);
@@ -731,6 +946,17 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 #pragma mark -
 #pragma mark CelObj - Drawing
 
+/**
+ * Minimum number of pixels of a draw for it to be split into bands of rows
+ * rendered in parallel.
+ */
+static const int kMinParallelRenderArea = 320 * 100;
+
+/**
+ * Minimum number of rows of each band of a draw rendered in parallel.
+ */
+static const int kMinParallelRenderRows = 16;
+
 template<typename MAPPER, typename SCALER, bool DRAW_BLACK_LINES>
 struct RENDERER {
 	MAPPER &_mapper;
@@ -745,27 +971,72 @@ struct RENDERER {
 	_isMacSource(isMacSource) {}
 
 	inline void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
-		byte *targetPixel = (byte *)target.getPixels() + target.w * targetRect.top + targetRect.left;
+		const int16 targetHeight = targetRect.height();
+		Common::ThreadPool *pool = CelObj::_renderPool;
+		int numBands = 1;
+		if (pool && targetRect.width() * targetHeight >= kMinParallelRenderArea) {
+			numBands = MIN<int>(2 * (pool->getNumWorkers() + 1), targetHeight / kMinParallelRenderRows);
+		}
+
+		if (!pool || !pool->getNumWorkers() || numBands < 2) {
+			drawRows(_scaler, target, targetRect, 0, targetHeight);
+			return;
+		}
+
+		// The rows of the target are disjoint, so bands of them are drawn
+		// concurrently, each with its own copy of the scaler since readers
+		// keep the last decompressed row. The copies are made here because
+		// the scaler may hold shared pointers.
+		BAND_RENDERER bands(*this, target, targetRect, (targetHeight + numBands - 1) / numBands);
+		for (int i = 0; i < numBands; ++i) {
+			bands._scalers.push_back(new SCALER(_scaler));
+		}
+
+		Common::Functor2Mem<int, int, void, BAND_RENDERER> body(&bands, &BAND_RENDERER::drawBand);
+		pool->parallelFor(0, targetHeight, bands._rowsPerBand, body);
+
+		for (uint i = 0; i < bands._scalers.size(); ++i) {
+			delete bands._scalers[i];
+		}
+	}
+
+	/**
+	 * Draws rows [firstRow, lastRow) of the target rect.
+	 */
+	inline void drawRows(SCALER &scaler, Buffer &target, const Common::Rect &targetRect, const int16 firstRow, const int16 lastRow) const {
+		byte buffer[kCelScalerTableSize];
+		byte *targetPixel = (byte *)target.getBasePtr(targetRect.left, targetRect.top + firstRow);
 
-		const int16 skipStride = target.w - targetRect.width();
 		const int16 targetWidth = targetRect.width();
-		const int16 targetHeight = targetRect.height();
-		for (int16 y = 0; y < targetHeight; ++y) {
+		for (int16 y = firstRow; y < lastRow; ++y) {
 			if (DRAW_BLACK_LINES && (y % 2) == 0) {
 				memset(targetPixel, 0, targetWidth);
-				targetPixel += targetWidth + skipStride;
-				continue;
+			} else {
+				const byte *source = scaler.getRow(targetRect.left, targetRect.top + y, targetWidth, buffer);
+				_mapper.drawRow(targetPixel, source, targetWidth, _skipColor, _isMacSource);
 			}
 
-			_scaler.setTarget(targetRect.left, targetRect.top + y);
+			targetPixel += target.pitch;
+		}
+	}
 
-			for (int16 x = 0; x < targetWidth; ++x) {
-				_mapper.draw(targetPixel++, _scaler.read(), _skipColor, _isMacSource);
-			}
+	struct BAND_RENDERER {
+		const RENDERER &_renderer;
+		Buffer &_target;
+		const Common::Rect &_targetRect;
+		const int _rowsPerBand;
+		Common::Array<SCALER *> _scalers;
+
+		BAND_RENDERER(const RENDERER &renderer, Buffer &target, const Common::Rect &targetRect, const int rowsPerBand) :
+		_renderer(renderer),
+		_target(target),
+		_targetRect(targetRect),
+		_rowsPerBand(rowsPerBand) {}
 
-			targetPixel += skipStride;
+		void drawBand(int firstRow, int lastRow) {
+			_renderer.drawRows(*_scalers[firstRow / _rowsPerBand], _target, _targetRect, firstRow, lastRow);
 		}
-	}
+	};
 };
 
 template<typename MAPPER, typename SCALER>
@@ -1100,6 +1371,13 @@ bool CelObjView::analyzeUncompressedForRemap() const {
 }
 
 bool CelObjView::analyzeForRemap() const {
+	// The cel is looked up again when it is drawn, which is what the cache
+	// statistics count
+	const DecodedCel *decodedCel = getDecodedCel(false);
+	if (decodedCel) {
+		return decodedCel->hasColorIn(g_sci->_gfxRemap32->getStartColor(), g_sci->_gfxRemap32->getEndColor());
+	}
+
 	READER_Compressed reader(*this, _width);
 	for (int y = 0; y < _height; y++) {
 		const byte *const curRow = reader.getRow(y);
@@ -23,12 +23,17 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
 #include "sci/engine/vm_types.h"
 #include "sci/util.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Sci {
 typedef Common::Rational Ratio;
 
@@ -152,6 +157,134 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+#pragma mark -
+#pragma mark DecodedCelCache
+
+/**
+ * A fully decompressed RLE cel.
+ */
+struct DecodedCel {
+	/**
+	 * The pixels of the cel, `width * height` bytes.
+	 */
+	byte *pixels;
+
+	/**
+	 * The size of `pixels`.
+	 */
+	uint32 size;
+
+	/**
+	 * A monotonically increasing ID used to identify the least recently used
+	 * cel in the cache for eviction.
+	 */
+	int id;
+
+	/**
+	 * Whether any pixel of the cel is the skip color.
+	 */
+	bool hasSkip;
+
+	/**
+	 * A bit set of the colors used by the cel, except for the skip color.
+	 */
+	uint32 colors[8];
+
+	/**
+	 * Whether the cel was decoded for a lookup which was not counted, so that
+	 * the next counted lookup is the miss rather than a hit.
+	 */
+	bool missPending;
+
+	DecodedCel() : pixels(nullptr), size(0), id(0), hasSkip(false), missPending(false) {
+		memset(colors, 0, sizeof(colors));
+	}
+
+	/**
+	 * Returns whether the cel uses any non-skip color in [first, last].
+	 */
+	bool hasColorIn(const uint8 first, const uint8 last) const;
+};
+
+/**
+ * A memory-budgeted cache of decompressed RLE cels from view and pic
+ * resources. Cels in this cache are drawn by the renderers of uncompressed
+ * cels instead of being decompressed again on every draw.
+ */
+class DecodedCelCache {
+public:
+	/**
+	 * @param budget The maximum number of bytes of cached pixels.
+	 */
+	explicit DecodedCelCache(const uint32 budget);
+	~DecodedCelCache();
+
+	/**
+	 * Returns the cached cel for the given cel info, or nullptr, counting a
+	 * hit or a miss if `count` is set.
+	 */
+	const DecodedCel *get(const CelInfo32 &info, const bool count = true);
+
+	/**
+	 * Returns the cached cel for the given cel info, or nullptr, without
+	 * touching the counters.
+	 */
+	const DecodedCel *peek(const CelInfo32 &info) const;
+
+	/**
+	 * Returns whether a cel of the given size may be cached at all.
+	 */
+	bool fits(const uint32 size) const { return size <= _budget / 4; }
+
+	/**
+	 * Adds a decompressed cel to the cache, evicting the least recently used
+	 * cels as needed to stay within the budget. The cache takes ownership of
+	 * `pixels`, which must have been allocated with malloc. `counted` tells
+	 * whether the failed lookup of the cel was counted as a miss.
+	 */
+	const DecodedCel *add(const CelInfo32 &info, byte *pixels, const uint32 size, const uint8 skipColor, const bool counted = true);
+
+	/**
+	 * Frees all cached cels.
+	 */
+	void clear();
+
+	uint32 getBudget() const { return _budget; }
+	uint32 getSize() const { return _size; }
+	uint getNumCels() const { return _cels.size(); }
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getEvictions() const { return _evictions; }
+
+private:
+	struct CelInfoHash {
+		uint operator()(const CelInfo32 &info) const {
+			return (info.type << 28) ^ (info.resourceId << 12) ^ (info.loopNo << 6) ^ info.celNo;
+		}
+	};
+
+	struct CelInfoEqualTo {
+		bool operator()(const CelInfo32 &a, const CelInfo32 &b) const {
+			return a.type == b.type && a.resourceId == b.resourceId && a.loopNo == b.loopNo && a.celNo == b.celNo;
+		}
+	};
+
+	typedef Common::HashMap<CelInfo32, DecodedCel, CelInfoHash, CelInfoEqualTo> CelMap;
+
+	/**
+	 * Evicts the least recently used cel.
+	 */
+	void evictOldest();
+
+	CelMap _cels;
+	const uint32 _budget;
+	uint32 _size;
+	int _nextId;
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _evictions;
+};
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -266,6 +399,18 @@ protected:
 public:
 	static CelScaler *_scaler;
 
+	/**
+	 * Workers drawing the rows of large cels in parallel. Only the drawing
+	 * itself is spread across them; the draw calls stay in order.
+	 */
+	static Common::ThreadPool *_renderPool;
+
+	/**
+	 * The cache of decompressed RLE cels, or nullptr if it is disabled by
+	 * setting `cel_cache_size` to 0.
+	 */
+	static DecodedCelCache *_decodedCache;
+
 	/**
 	 * The basic identifying information for this cel. This information
 	 * effectively acts as a composite key for a cel object, and any cel object
@@ -403,6 +548,13 @@ public:
 	 */
 	virtual const SciSpan<const byte> getResPointer() const = 0;
 
+	/**
+	 * Returns this cel fully decompressed, decompressing it into the decoded
+	 * cel cache if needed, or nullptr if this is not an RLE cel from a
+	 * resource or if it can't be cached.
+	 */
+	const DecodedCel *getDecodedCel(const bool countLookup = true) const;
+
 	/**
 	 * Reads the pixel at the given coordinates. This method is valid only for
 	 * CelObjView and CelObjPic.
@@ -97,6 +97,8 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+
+	registerCmd("dirtystrips",     WRAP_METHOD(ScummDebugger, Cmd_DirtyStrips));
 }
 
 ScummDebugger::~ScummDebugger() {
@@ -845,4 +847,9 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_DirtyStrips(int argc, const char **argv) {
+	debugPrintf("Last frame: %d dirty strips drawn as %d rects\n", _vm->_dirtyStripsDrawn, _vm->_dirtyRectsDrawn);
+	return true;
+}
+
 } // End of namespace Scumm
@@ -69,6 +69,8 @@ private:
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
 
+	bool Cmd_DirtyStrips(int argc, const char **argv);
+
 	void printBox(int box);
 	void drawBox(int box);
 };
@@ -57,6 +57,32 @@ static void clear8Col(byte *dst, int dstPitch, int height, uint8 bitDepth);
 
 static void ditherHerc(byte *src, byte *hercbuf, int srcPitch, int *x, int *y, int *width, int *height);
 
+#ifndef USE_ARM_GFX_ASM
+/**
+ * Compose several text pixels over game pixels at once, the text pixels
+ * being transparent when equal to CHARSET_MASK_TRANSPARENCY.
+ */
+template<typename T>
+static inline T composeText(T text, T src) {
+	const T ones = (T)-1 / 0xFF; // 0x0101...01
+
+	// Generate a byte mask for those text pixels (bytes) with
+	// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
+	// in mask will be either equal to 0x00 or 0xFF.
+	// Doing it this way avoids branches and bytewise operations,
+	// at the cost of readability ;).
+	T mask = text ^ (ones * CHARSET_MASK_TRANSPARENCY);
+	mask = (((mask & (ones * 0x7f)) + ones * 0x7f) | mask) & (ones * 0x80);
+	mask = ((mask >> 7) + ones * 0x7f) ^ (ones * 0x80);
+
+	// The following line is equivalent to this code:
+	//   return (src & mask) | (text & ~mask);
+	// However, some compilers can generate somewhat better
+	// machine code for this equivalent statement:
+	return ((text ^ src) & mask) ^ text;
+}
+#endif
+
 struct StripTable {
 	int offsets[160];
 	int run[160];
@@ -517,6 +543,9 @@ void ScummEngine::markRectAsDirty(VirtScreenNumber virt, int left, int right, in
  * code in the backend is controlled from here.
  */
 void ScummEngine::drawDirtyScreenParts() {
+	_dirtyStripsDrawn = 0;
+	_dirtyRectsDrawn = 0;
+
 	// Update verbs
 	updateDirtyScreen(kVerbVirtScreen);
 
@@ -529,6 +558,8 @@ void ScummEngine::drawDirtyScreenParts() {
 		VirtScreen *vs = &_virtscr[kMainVirtScreen];
 		drawStripToScreen(vs, 0, vs->w, 0, vs->h);
 		vs->setDirtyRange(vs->h, 0);
+		_dirtyStripsDrawn += _gdi->_numStrips;
+		_dirtyRectsDrawn++;
 	} else {
 		updateDirtyScreen(kMainVirtScreen);
 	}
@@ -587,26 +618,57 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
-
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
+	// Neighboring dirty strips are coalesced into one bigger rectangle, as
+	// long as at most a third of it is not dirty: drawing a few more lines
+	// costs less than composing and copying one more rectangle.
+	int start = -1;
+	int top = 0, bottom = 0;
+	int dirtyLines = 0;
+
+	for (int i = 0; i <= _gdi->_numStrips; i++) {
+		int stripTop = 0, stripBottom = 0;
+		if (i < _gdi->_numStrips && vs->bdirty[i]) {
+			stripTop = vs->tdirty[i];
+			stripBottom = vs->bdirty[i];
 			vs->tdirty[i] = vs->h;
 			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
+		}
+
+		if (stripBottom > stripTop) {
+			_dirtyStripsDrawn++;
+
+			if (start < 0) {
+				start = i;
+				top = stripTop;
+				bottom = stripBottom;
+				dirtyLines = stripBottom - stripTop;
+				continue;
+			}
+
+			const int newTop = MIN(top, stripTop);
+			const int newBottom = MAX(bottom, stripBottom);
+			const int newDirtyLines = dirtyLines + stripBottom - stripTop;
+			const int newLines = (i + 1 - start) * (newBottom - newTop);
+			if (newLines - newDirtyLines <= newDirtyLines / 2) {
+				top = newTop;
+				bottom = newBottom;
+				dirtyLines = newDirtyLines;
 				continue;
 			}
-			drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
 		}
-		start = i + 1;
+
+		if (start >= 0) {
+			drawStripToScreen(vs, start * 8, (i - start) * 8, top, bottom);
+			_dirtyRectsDrawn++;
+			start = -1;
+		}
+
+		if (stripBottom > stripTop) {
+			start = i;
+			top = stripTop;
+			bottom = stripBottom;
+			dirtyLines = stripBottom - stripTop;
+		}
 	}
 }
 
@@ -689,17 +751,29 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 			byte *dstPtr = _compositeBuf;
 
 			for (int h = 0; h < height * m; ++h) {
-				for (int w = 0; w < width * m; ++w) {
-					uint16 tmp = *textPtr++;
-					if (tmp == CHARSET_MASK_TRANSPARENCY) {
-						tmp = READ_UINT16(srcPtr);
-						WRITE_UINT16(dstPtr, tmp); dstPtr += 2;
-					} else if (_game.heversion != 0) {
-						error ("16Bit Color HE Game using old charset");
-					} else {
-						WRITE_UINT16(dstPtr, _16BitPalette[tmp]); dstPtr += 2;
+				for (int w = 0; w < width * m; w += 4) {
+					// Most of the text surface is transparent, so check four
+					// pixels at a time, and copy them at once
+					if (READ_UINT32(textPtr) == CHARSET_MASK_TRANSPARENCY_32) {
+						memcpy(dstPtr, srcPtr, 8);
+						textPtr += 4;
+						dstPtr += 8;
+						srcPtr += 8;
+						continue;
+					}
+
+					for (int i = 0; i < 4; ++i) {
+						uint16 tmp = *textPtr++;
+						if (tmp == CHARSET_MASK_TRANSPARENCY) {
+							tmp = READ_UINT16(srcPtr);
+							WRITE_UINT16(dstPtr, tmp); dstPtr += 2;
+						} else if (_game.heversion != 0) {
+							error ("16Bit Color HE Game using old charset");
+						} else {
+							WRITE_UINT16(dstPtr, _16BitPalette[tmp]); dstPtr += 2;
+						}
+						srcPtr += 2;
 					}
-					srcPtr += vs->format.bytesPerPixel;
 				}
 				srcPtr += vsPitch;
 				textPtr += _textSurface.pitch - width * m;
@@ -708,35 +782,24 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
-			// We blit four pixels at a time, for improved performance.
-			const uint32 *src32 = (const uint32 *)src;
-			uint32 *dst32 = (uint32 *)_compositeBuf;
-
-			vsPitch >>= 2;
+			// We blit eight pixels at a time, for improved performance.
+			const byte *src8 = (const byte *)src;
+			const byte *text8 = (const byte *)text;
+			byte *dst8 = _compositeBuf;
 
-			const uint32 *text32 = (const uint32 *)text;
-			const int textPitch = (_textSurface.pitch - width * m) >> 2;
+			const int rowSize = width * m;
 			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
-					uint32 temp = *text32++;
-
-					// Generate a byte mask for those text pixels (bytes) with
-					// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
-					// in mask will be either equal to 0x00 or 0xFF.
-					// Doing it this way avoids branches and bytewise operations,
-					// at the cost of readability ;).
-					uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
-					mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
-					mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
-
-					// The following line is equivalent to this code:
-					//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
-					// However, some compilers can generate somewhat better
-					// machine code for this equivalent statement:
-					*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
-				}
-				src32 += vsPitch;
-				text32 += textPitch;
+				int w = 0;
+				for (; w + 8 <= rowSize; w += 8)
+					WRITE_UINT64(dst8 + w, composeText<uint64>(READ_UINT64(text8 + w), READ_UINT64(src8 + w)));
+
+				// The width is only a multiple of 4 when clipped
+				for (; w < rowSize; w += 4)
+					WRITE_UINT32(dst8 + w, composeText<uint32>(READ_UINT32(text8 + w), READ_UINT32(src8 + w)));
+
+				src8 += rowSize + vsPitch;
+				text8 += _textSurface.pitch;
+				dst8 += rowSize;
 			}
 #endif
 		}
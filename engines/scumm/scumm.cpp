@@ -620,6 +620,8 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 		_compositeBuf = 0;
 
 	_herculesBuf = 0;
+	_dirtyStripsDrawn = 0;
+	_dirtyRectsDrawn = 0;
 	if (_renderMode == Common::kRenderHercA || _renderMode == Common::kRenderHercG) {
 		_herculesBuf = (byte *)malloc(kHercWidth * kHercHeight);
 	}
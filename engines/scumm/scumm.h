@@ -957,6 +957,10 @@ protected:
 	byte *_compositeBuf;
 	byte *_herculesBuf;
 
+	// Dirty strips and rects drawn to the screen by the last drawDirtyScreenParts()
+	uint _dirtyStripsDrawn;
+	uint _dirtyRectsDrawn;
+
 	virtual void drawDirtyScreenParts();
 	void updateDirtyScreen(VirtScreenNumber slot);
 	void drawStripToScreen(VirtScreen *vs, int x, int width, int top, int bottom);
@@ -21,7 +21,17 @@
  */
 
 #include "testbed/misc.h"
+#include "common/memstream.h"
+#include "common/threadpool.h"
 #include "common/timer.h"
+#include "common/zlib.h"
+
+#include "graphics/font.h"
+#include "graphics/fontman.h"
+#include "graphics/managed_surface.h"
+#include "graphics/fonts/ttf.h"
+#include "graphics/macgui/mactext.h"
+#include "graphics/macgui/macwindowmanager.h"
 
 namespace Testbed {
 
@@ -160,6 +170,178 @@ TestExitStatus MiscTests::testMutexes() {
 	return kTestFailed;
 }
 
+namespace {
+
+// Sums the elements of a range into a per-range slot, used by the thread pool tests
+class SumBody : public Common::Functor2<int, int, void> {
+public:
+	SumBody(const Common::Array<uint32> &values, Common::Array<uint32> &sums, int grainSize) :
+		_values(values), _sums(sums), _grainSize(grainSize) {}
+
+	bool isValid() const override { return true; }
+	void operator()(int first, int last) const override {
+		uint32 sum = 0;
+		for (int i = first; i < last; i++) {
+			// Make each element cost a little, so there is something to spread
+			uint32 v = _values[i];
+			for (int j = 0; j < 64; j++)
+				v = v * 1664525 + 1013904223;
+			sum += v;
+		}
+		_sums[first / _grainSize] = sum;
+	}
+
+private:
+	const Common::Array<uint32> &_values;
+	Common::Array<uint32> &_sums;
+	int _grainSize;
+};
+
+class CountTask : public Common::Task {
+public:
+	CountTask(Common::Mutex &mutex, int &counter) : _mutex(mutex), _counter(counter) {}
+	void run() override {
+		Common::StackLock lock(_mutex);
+		_counter++;
+	}
+
+private:
+	Common::Mutex &_mutex;
+	int &_counter;
+};
+
+uint32 sumRanges(Common::ThreadPool &pool, const Common::Array<uint32> &values, int grainSize) {
+	Common::Array<uint32> sums;
+	sums.resize((values.size() + grainSize - 1) / grainSize);
+
+	SumBody body(values, sums, grainSize);
+	pool.parallelFor(0, values.size(), grainSize, body);
+
+	uint32 total = 0;
+	for (uint i = 0; i < sums.size(); i++)
+		total += sums[i];
+	return total;
+}
+
+} // End of anonymous namespace
+
+TestExitStatus MiscTests::testThreadPool() {
+	Common::ThreadPool pool;
+	Testsuite::logDetailedPrintf("Thread pool started with %u workers on %u processors\n", pool.getNumWorkers(), g_system->getNumProcessors());
+
+	Common::Mutex mutex;
+	int counter = 0;
+	{
+		Common::TaskGroup group(pool);
+		for (int i = 0; i < 1000; i++)
+			group.run(new CountTask(mutex, counter));
+		group.wait();
+	}
+	if (counter != 1000) {
+		Testsuite::logDetailedPrintf("Error! Expected 1000 finished tasks, got %d\n", counter);
+		return kTestFailed;
+	}
+
+	Common::Array<uint32> values;
+	for (uint32 i = 0; i < 100000; i++)
+		values.push_back(i);
+
+	Common::ThreadPool serial(0);
+	if (sumRanges(pool, values, 1000) != sumRanges(serial, values, 1000)) {
+		Testsuite::logDetailedPrintf("Error! parallelFor() result differs from the serial one\n");
+		return kTestFailed;
+	}
+
+	return kTestPassed;
+}
+
+TestExitStatus MiscTests::benchmarkThreadPool() {
+	Common::ThreadPool pool;
+	Common::ThreadPool serial(0);
+
+	Common::Array<uint32> values;
+	for (uint32 i = 0; i < 1000000; i++)
+		values.push_back(i);
+
+	static const int grainSizes[] = { 100, 1000, 10000 };
+	for (uint i = 0; i < ARRAYSIZE(grainSizes); i++) {
+		uint32 start = g_system->getMillis();
+		sumRanges(serial, values, grainSizes[i]);
+		uint32 serialTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		sumRanges(pool, values, grainSizes[i]);
+		uint32 parallelTime = g_system->getMillis() - start;
+
+		Testsuite::logPrintf("Info! parallelFor() with grain size %d: %u ms serial, %u ms with %u workers\n",
+			grainSizes[i], serialTime, parallelTime, pool.getNumWorkers());
+	}
+
+	// Scheduling overhead of many tiny tasks
+	Common::Mutex mutex;
+	int counter = 0;
+	uint32 start = g_system->getMillis();
+	{
+		Common::TaskGroup group(pool);
+		for (int i = 0; i < 100000; i++)
+			group.run(new CountTask(mutex, counter));
+	}
+	uint32 taskTime = g_system->getMillis() - start;
+
+	Common::ThreadPool::Stats stats = pool.getStats();
+	Testsuite::logPrintf("Info! 100000 empty tasks: %u ms (%u run by workers, %u stolen, %u run while waiting)\n",
+		taskTime, stats.tasksRun, stats.tasksStolen, stats.tasksHelped);
+
+	return kTestPassed;
+}
+
+TestExitStatus MiscTests::benchmarkGZipSeek() {
+#ifdef USE_ZLIB
+	const uint32 size = 8 * 1024 * 1024;
+	const int numSeeks = 200;
+
+	// Compressible, but not trivially so
+	uint32 seed = 1;
+	Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+	Common::WriteStream *writer = Common::wrapCompressedWriteStream(compressed);
+	byte buf[4096];
+	for (uint32 pos = 0; pos < size; pos += sizeof(buf)) {
+		for (uint32 i = 0; i < sizeof(buf); i++)
+			buf[i] = ((seed = seed * 1103515245 + 12345) >> 16) % 16 + 'a';
+		writer->write(buf, sizeof(buf));
+	}
+	writer->finalize();
+
+	Common::SeekableReadStream *reader = Common::wrapCompressedReadStream(
+		new Common::MemoryReadStream(compressed->getData(), compressed->size(), DisposeAfterUse::YES));
+	delete writer;
+
+	// The first pass also builds the seek index
+	uint32 start = g_system->getMillis();
+	while (reader->read(buf, sizeof(buf)))
+		;
+	uint32 sequentialTime = g_system->getMillis() - start;
+
+	start = g_system->getMillis();
+	for (int i = 0; i < numSeeks; i++) {
+		reader->seek(((seed = seed * 1103515245 + 12345) >> 8) % (size - sizeof(buf)));
+		reader->read(buf, sizeof(buf));
+	}
+	uint32 randomTime = g_system->getMillis() - start;
+
+	bool failed = reader->err();
+	delete reader;
+
+	Testsuite::logPrintf("Info! GZipReadStream over %u MB: %u ms sequential, %u ms for %d random 4 KB reads\n",
+		size / (1024 * 1024), sequentialTime, randomTime, numSeeks);
+
+	return failed ? kTestFailed : kTestPassed;
+#else
+	Testsuite::logPrintf("Info! Skipping test : zlib support is not built in\n");
+	return kTestSkipped;
+#endif
+}
+
 TestExitStatus MiscTests::testOpenUrl() {
 	Common::String info = "Testing openUrl() method.\n"
 		"In this test we'll try to open scummvm.org in your default browser.";
@@ -183,10 +365,133 @@ TestExitStatus MiscTests::testOpenUrl() {
 	return kTestPassed;
 }
 
+namespace {
+
+/** Draw a string one character at a time, like drawString did before batching */
+void drawStringPerChar(const Graphics::Font &font, Graphics::ManagedSurface &dst, const Common::String &str, int x, int y, uint32 color) {
+	uint32 last = 0;
+	for (uint i = 0; i < str.size(); i++) {
+		const uint32 cur = (byte)str[i];
+		x += font.getKerningOffset(last, cur);
+		last = cur;
+		font.drawChar(&dst, cur, x, y, color);
+		x += font.getCharWidth(cur);
+	}
+}
+
+bool benchmarkFont(const char *name, const Graphics::Font &font, const Graphics::PixelFormat &format) {
+	const Common::String text("The quick brown fox jumps over the lazy dog. AVAWAY 0123456789");
+	const int numStrings = 20000;
+	const uint32 color = format.RGBToColor(255, 255, 255);
+
+	Graphics::ManagedSurface batched(640, 480, format);
+	Graphics::ManagedSurface perChar(640, 480, format);
+	batched.fillRect(Common::Rect(640, 480), format.RGBToColor(0, 0, 128));
+	perChar.fillRect(Common::Rect(640, 480), format.RGBToColor(0, 0, 128));
+
+	uint32 start = g_system->getMillis();
+	for (int i = 0; i < numStrings; i++)
+		drawStringPerChar(font, perChar, text, i % 16, (i * 7) % 460, color);
+	uint32 perCharTime = g_system->getMillis() - start;
+
+	start = g_system->getMillis();
+	for (int i = 0; i < numStrings; i++)
+		font.drawString(&batched, text, i % 16, (i * 7) % 460, 624, color);
+	uint32 batchedTime = g_system->getMillis() - start;
+
+	Testsuite::logPrintf("Info! %s, %d bpp: %d strings in %u ms per character, %u ms batched\n",
+		name, format.bytesPerPixel * 8, numStrings, perCharTime, batchedTime);
+
+	for (int y = 0; y < 480; y++) {
+		if (memcmp(batched.getBasePtr(0, y), perChar.getBasePtr(0, y), 640 * format.bytesPerPixel)) {
+			Testsuite::logDetailedPrintf("Error! %s draws differently when batched, at line %d\n", name, y);
+			return false;
+		}
+	}
+	return true;
+}
+
+} // End of anonymous namespace
+
+TestExitStatus MiscTests::benchmarkTextRendering() {
+	static const Graphics::PixelFormat formats[] = {
+		Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+		Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 24)
+	};
+
+	bool passed = true;
+	const Graphics::Font *guiFont = FontMan.getFontByUsage(Graphics::FontManager::kGUIFont);
+	for (uint i = 0; i < ARRAYSIZE(formats); i++)
+		passed &= benchmarkFont("GUI font", *guiFont, formats[i]);
+
+#ifdef USE_FREETYPE2
+	Common::ScopedPtr<Graphics::Font> ttfFont(Graphics::loadTTFFontFromArchive("FreeSans.ttf", 16));
+	if (ttfFont) {
+		for (uint i = 0; i < ARRAYSIZE(formats); i++)
+			passed &= benchmarkFont("FreeSans 16", *ttfFont, formats[i]);
+	} else {
+		Testsuite::logPrintf("Info! FreeSans.ttf is not available, skipping the TTF font\n");
+	}
+#endif
+
+	return passed ? kTestPassed : kTestFailed;
+}
+
+TestExitStatus MiscTests::benchmarkMacTextAppend() {
+	const int numLines = 10000;
+	const int width = 640;
+	const int height = 480;
+
+	Graphics::MacWindowManager wm(Graphics::kWMModeNoDesktop | Graphics::kWMModeManualDrawWidgets | Graphics::kWMMode32bpp);
+	const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kGUIFont);
+	const uint32 black = wm._pixelformat.RGBToColor(0, 0, 0);
+	const uint32 white = wm._pixelformat.RGBToColor(255, 255, 255);
+
+	Common::U32String text;
+	Graphics::MacText appended(Common::U32String(), &wm, font, black, white, width, Graphics::kTextAlignLeft);
+
+	uint32 start = g_system->getMillis();
+	for (int i = 0; i < numLines; i++) {
+		Common::U32String line(Common::String::format("Line %d: The quick brown fox jumps over the lazy dog\n", i));
+		appended.appendTextDefault(line);
+		text += line;
+	}
+	uint32 appendTime = g_system->getMillis() - start;
+
+	// Only the last screen of text is rendered
+	Graphics::ManagedSurface screen(width, height, wm._pixelformat);
+	int lastScreen = appended.getTextHeight() - height;
+
+	start = g_system->getMillis();
+	appended.draw(&screen, 0, lastScreen, width, height, 0, 0);
+	uint32 drawTime = g_system->getMillis() - start;
+
+	Testsuite::logPrintf("Info! MacText: %d lines appended in %u ms, last screen drawn in %u ms\n", numLines, appendTime, drawTime);
+
+	// The text laid out at once must look the same
+	Graphics::MacText whole(Common::U32String(), &wm, font, black, white, width, Graphics::kTextAlignLeft);
+	whole.appendTextDefault(text);
+	Graphics::ManagedSurface expected(width, height, wm._pixelformat);
+	whole.draw(&expected, 0, lastScreen, width, height, 0, 0);
+
+	for (int y = 0; y < height; y++) {
+		if (memcmp(screen.getBasePtr(0, y), expected.getBasePtr(0, y), width * wm._pixelformat.bytesPerPixel)) {
+			Testsuite::logDetailedPrintf("Error! Appended MacText differs at line %d\n", y);
+			return kTestFailed;
+		}
+	}
+	return kTestPassed;
+}
+
 MiscTestSuite::MiscTestSuite() {
 	addTest("Datetime", &MiscTests::testDateTime, false);
 	addTest("Timers", &MiscTests::testTimers, false);
 	addTest("Mutexes", &MiscTests::testMutexes, false);
+	addTest("ThreadPool", &MiscTests::testThreadPool, false);
+	addTest("ThreadPoolBenchmark", &MiscTests::benchmarkThreadPool, false);
+	addTest("GZipSeekBenchmark", &MiscTests::benchmarkGZipSeek, false);
+	addTest("TextRenderingBenchmark", &MiscTests::benchmarkTextRendering, false);
+	addTest("MacTextAppendBenchmark", &MiscTests::benchmarkMacTextAppend, false);
 	addTest("openUrl", &MiscTests::testOpenUrl, true);
 }
 
@@ -51,6 +51,11 @@ void criticalSection(void *arg);
 TestExitStatus testDateTime();
 TestExitStatus testTimers();
 TestExitStatus testMutexes();
+TestExitStatus testThreadPool();
+TestExitStatus benchmarkThreadPool();
+TestExitStatus benchmarkGZipSeek();
+TestExitStatus benchmarkTextRendering();
+TestExitStatus benchmarkMacTextAppend();
 TestExitStatus testOpenUrl();
 // add more here
 
@@ -72,7 +77,7 @@ public:
 		return "Misc";
 	}
 	const char *getDescription() const override {
-		return "Miscellaneous: Timers/Mutexes/Datetime/openUrl";
+		return "Miscellaneous: Timers/Mutexes/Threads/Datetime/openUrl";
 	}
 };
 
@@ -22,6 +22,7 @@
 
 #include "twine/debugger/console.h"
 #include "common/scummsys.h"
+#include "common/system.h"
 #include "common/util.h"
 #include "twine/debugger/debug_grid.h"
 #include "twine/debugger/debug_scene.h"
@@ -66,6 +67,7 @@ TwinEConsole::TwinEConsole(TwinEEngine *engine) : _engine(engine), GUI::Debugger
 	registerCmd("set_holomap_trajectory", WRAP_METHOD(TwinEConsole, doSetHolomapTrajectory));
 	registerCmd("show_holomap_flag", WRAP_METHOD(TwinEConsole, doPrintGameFlag));
 	registerCmd("toggle_scene_patches", WRAP_METHOD(TwinEConsole, doToggleScenePatches));
+	registerCmd("render_benchmark", WRAP_METHOD(TwinEConsole, doRenderBenchmark));
 }
 
 TwinEConsole::~TwinEConsole() {
@@ -300,6 +302,26 @@ bool TwinEConsole::doToggleDebug(int argc, const char **argv) {
 	return true;
 }
 
+bool TwinEConsole::doRenderBenchmark(int argc, const char **argv) {
+	int frames = 100;
+	if (argc >= 2) {
+		frames = atoi(argv[1]);
+	}
+	if (frames <= 0) {
+		debugPrintf("Expected a positive number of frames\n");
+		return true;
+	}
+	// Only the actors are drawn again, over the background of the scene
+	const uint32 start = g_system->getMillis();
+	for (int i = 0; i < frames; ++i) {
+		_engine->_redraw->redrawEngineActions(false);
+	}
+	const uint32 elapsed = g_system->getMillis() - start;
+	debugPrintf("Rendered %i frames of scene %i in %u ms (%.2f ms per frame)\n", frames,
+	            _engine->_scene->_currentSceneIdx, elapsed, (float)elapsed / frames);
+	return true;
+}
+
 bool TwinEConsole::doListMenuText(int argc, const char **argv) {
 	TextBankId textBankId = TextBankId::Inventory_Intro_and_Holomap;
 	if (argc >= 2) {
@@ -295,13 +295,19 @@ void Renderer::applyRotation(IMatrix3x3 *targetMatrix, const IMatrix3x3 *current
 }
 
 void Renderer::applyPointsRotation(const Common::Array<BodyVertex> &vertices, int32 firstPoint, int32 numPoints, I16Vec3 *destPoints, const IMatrix3x3 *rotationMatrix, const IVec3 &destPos) {
-	for (int32 i = 0; i < numPoints; ++i) {
-		const BodyVertex &vertex = vertices[i + firstPoint];
-		destPoints->x = ((rotationMatrix->row1.x * vertex.x + rotationMatrix->row1.y * vertex.y + rotationMatrix->row1.z * vertex.z) / SCENE_SIZE_HALF) + destPos.x;
-		destPoints->y = ((rotationMatrix->row2.x * vertex.x + rotationMatrix->row2.y * vertex.y + rotationMatrix->row2.z * vertex.z) / SCENE_SIZE_HALF) + destPos.y;
-		destPoints->z = ((rotationMatrix->row3.x * vertex.x + rotationMatrix->row3.y * vertex.y + rotationMatrix->row3.z * vertex.z) / SCENE_SIZE_HALF) + destPos.z;
-
-		destPoints++;
+	// Work on local copies, so that the writes to destPoints don't force the
+	// matrix to be reloaded for every vertex
+	const IMatrix3x3 matrix = *rotationMatrix;
+	const IVec3 pos = destPos;
+	const BodyVertex *vertex = &vertices[firstPoint];
+
+	for (int32 i = 0; i < numPoints; ++i, ++vertex, ++destPoints) {
+		const int32 x = vertex->x;
+		const int32 y = vertex->y;
+		const int32 z = vertex->z;
+		destPoints->x = ((matrix.row1.x * x + matrix.row1.y * y + matrix.row1.z * z) / SCENE_SIZE_HALF) + pos.x;
+		destPoints->y = ((matrix.row2.x * x + matrix.row2.y * y + matrix.row2.z * z) / SCENE_SIZE_HALF) + pos.y;
+		destPoints->z = ((matrix.row3.x * x + matrix.row3.y * y + matrix.row3.z * z) / SCENE_SIZE_HALF) + pos.z;
 	}
 }
 
@@ -334,17 +340,19 @@ void Renderer::processRotatedElement(IMatrix3x3 *targetMatrix, const Common::Arr
 }
 
 void Renderer::applyPointsTranslation(const Common::Array<BodyVertex> &vertices, int32 firstPoint, int32 numPoints, I16Vec3 *destPoints, const IMatrix3x3 *translationMatrix, const IVec3 &angleVec, const IVec3 &destPos) {
-	for (int32 i = 0; i < numPoints; ++i) {
-		const BodyVertex &vertex = vertices[i + firstPoint];
-		const int32 tmpX = vertex.x + angleVec.x;
-		const int32 tmpY = vertex.y + angleVec.y;
-		const int32 tmpZ = vertex.z + angleVec.z;
-
-		destPoints->x = ((translationMatrix->row1.x * tmpX + translationMatrix->row1.y * tmpY + translationMatrix->row1.z * tmpZ) / SCENE_SIZE_HALF) + destPos.x;
-		destPoints->y = ((translationMatrix->row2.x * tmpX + translationMatrix->row2.y * tmpY + translationMatrix->row2.z * tmpZ) / SCENE_SIZE_HALF) + destPos.y;
-		destPoints->z = ((translationMatrix->row3.x * tmpX + translationMatrix->row3.y * tmpY + translationMatrix->row3.z * tmpZ) / SCENE_SIZE_HALF) + destPos.z;
-
-		destPoints++;
+	const IMatrix3x3 matrix = *translationMatrix;
+	const IVec3 angle = angleVec;
+	const IVec3 pos = destPos;
+	const BodyVertex *vertex = &vertices[firstPoint];
+
+	for (int32 i = 0; i < numPoints; ++i, ++vertex, ++destPoints) {
+		const int32 tmpX = vertex->x + angle.x;
+		const int32 tmpY = vertex->y + angle.y;
+		const int32 tmpZ = vertex->z + angle.z;
+
+		destPoints->x = ((matrix.row1.x * tmpX + matrix.row1.y * tmpY + matrix.row1.z * tmpZ) / SCENE_SIZE_HALF) + pos.x;
+		destPoints->y = ((matrix.row2.x * tmpX + matrix.row2.y * tmpY + matrix.row2.z * tmpZ) / SCENE_SIZE_HALF) + pos.y;
+		destPoints->z = ((matrix.row3.x * tmpX + matrix.row3.y * tmpY + matrix.row3.z * tmpZ) / SCENE_SIZE_HALF) + pos.z;
 	}
 }
 
@@ -385,6 +393,33 @@ static FORCEINLINE int16 clamp(int16 x, int16 a, int16 b) {
 	return x < a ? a : (x > b ? b : x);
 }
 
+/**
+ * Clips the span [start, stop] of a polygon line to the screen width.
+ * @return false if nothing of the span is visible
+ */
+static FORCEINLINE bool clipSpan(int32 start, int32 stop, int32 screenWidth, int32 &left, int32 &right) {
+	left = MAX<int32>(start, 0);
+	right = MIN<int32>(stop, screenWidth - 1);
+	return left <= right;
+}
+
+/**
+ * Fills the visible part of a span with colors interpolated from startColor,
+ * stepping by colorStep for every pixel. The colors are in 8.8 fixed point.
+ */
+static void fillGouraudSpan(uint8 *out, int32 start, int32 stop, int32 screenWidth, uint16 startColor, int16 colorStep) {
+	int32 left, right;
+	if (!clipSpan(start, stop, screenWidth, left, right)) {
+		return;
+	}
+	// The color is computed from the pixel position rather than accumulated,
+	// so that the loop has no dependency between pixels
+	const uint16 leftColor = startColor + (left - start) * colorStep;
+	for (int32 x = 0; x <= right - left; ++x) {
+		out[left + x] = (uint16)(leftColor + x * colorStep) >> 8;
+	}
+}
+
 void Renderer::computePolygons(int16 polyRenderType, const Vertex *vertices, int32 numVertices) {
 	uint8 vertexParam1 = vertices[numVertices - 1].colorIndex;
 	int16 currentVertexX = vertices[numVertices - 1].x;
@@ -552,14 +587,10 @@ void Renderer::renderPolygonsFlat(int vtop, int32 vsize, uint8 color) const {
 		const int16 start = ptr1[0];
 		const int16 stop = ptr1[screenHeight];
 		ptr1++;
-		const int32 hsize = stop - start;
 
-		if (hsize >= 0) {
-			for (int32 j = start; j <= hsize + start; j++) {
-				if (j >= 0 && j < screenWidth) {
-					out[j] = color;
-				}
-			}
+		int32 left, right;
+		if (clipSpan(start, stop, screenWidth, left, right)) {
+			memset(out + left, color, right - left + 1);
 		}
 		out += screenWidth;
 	}
@@ -785,38 +816,7 @@ void Renderer::renderPolygonsGouraud(int vtop, int32 vsize) const {
 					*(out2) = startColor / 256;
 				}
 			} else {
-				int32 currentXPos = start;
-				colorSize /= hsize;
-				hsize++;
-
-				if (hsize % 2) {
-					hsize /= 2;
-					if (currentXPos >= 0 && currentXPos < screenWidth) {
-						*out2 = startColor >> 8;
-					}
-					out2++;
-					currentXPos++;
-					startColor += colorSize;
-				} else {
-					hsize /= 2;
-				}
-
-				do {
-					if (currentXPos >= 0 && currentXPos < screenWidth) {
-						*out2 = startColor >> 8;
-					}
-
-					currentXPos++;
-					startColor += colorSize;
-
-					if (currentXPos >= 0 && currentXPos < screenWidth) {
-						*(out2 + 1) = startColor >> 8;
-					}
-
-					currentXPos++;
-					out2 += 2;
-					startColor += colorSize;
-				} while (--hsize);
+				fillGouraudSpan(out, start, stop, screenWidth, startColor, colorSize / hsize);
 			}
 		}
 		out += screenWidth;
@@ -400,6 +400,10 @@ void GameMapGump::IncSortOrder(int count) {
 	_displayList->IncSortLimit(count);
 }
 
+void GameMapGump::GetSortStats(uint32 &items, uint32 &overlapTests) const {
+	_displayList->GetSortStats(items, overlapTests);
+}
+
 bool GameMapGump::StartDraggingItem(Item *item, int mx, int my) {
 //	ParentToGump(mx, my);
 
@@ -77,6 +77,9 @@ public:
 
 	void IncSortOrder(int count);
 
+	//! Get the number of items and overlap tests of the last sorted frame
+	void GetSortStats(uint32 &items, uint32 &overlapTests) const;
+
 	bool loadData(Common::ReadStream *rs, uint32 version);
 	void saveData(Common::WriteStream *ws) override;
 
@@ -39,6 +39,7 @@
 #include "ultima/ultima8/gumps/menu_gump.h"
 #include "ultima/ultima8/kernel/kernel.h"
 #include "ultima/ultima8/kernel/object_manager.h"
+#include "ultima/ultima8/misc/direction_util.h"
 #include "ultima/ultima8/misc/id_man.h"
 #include "ultima/ultima8/misc/util.h"
 #include "ultima/ultima8/usecode/uc_machine.h"
@@ -135,6 +136,8 @@ Debugger::Debugger() : Shared::Debugger() {
 	registerCmd("GameMapGump::dumpAllMaps", WRAP_METHOD(Debugger, cmdDumpAllMaps));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::sortStats", WRAP_METHOD(Debugger, cmdSortStats));
+	registerCmd("CurrentMap::benchmarkSweepTest", WRAP_METHOD(Debugger, cmdBenchmarkSweepTest));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
@@ -840,6 +843,65 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdSortStats(int argc, const char **argv) {
+	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (!gump) {
+		debugPrintf("No GameMapGump\n");
+		return true;
+	}
+
+	uint32 items, overlapTests;
+	gump->GetSortStats(items, overlapTests);
+	// Comparing every pair of items would take items * (items - 1) / 2 tests
+	debugPrintf("Sorted %u items with %u overlap tests (up to %u without the grid)\n",
+	            items, overlapTests, items ? items * (items - 1) / 2 : 0);
+	return true;
+}
+
+bool Debugger::cmdBenchmarkSweepTest(int argc, const char **argv) {
+	const MainActor *av = getMainActor();
+	if (!av) {
+		debugPrintf("No avatar\n");
+		return true;
+	}
+
+	const int count = argc > 1 ? strtol(argv[1], 0, 0) : 10000;
+	const int32 distance = argc > 2 ? strtol(argv[2], 0, 0) : 256;
+	if (count <= 0) {
+		debugPrintf("Usage: CurrentMap::benchmarkSweepTest [count] [distance]\n");
+		return true;
+	}
+
+	const CurrentMap *map = World::get_instance()->getCurrentMap();
+	int32 start[3], dims[3];
+	av->getLocation(start[0], start[1], start[2]);
+	av->getFootpadWorld(dims[0], dims[1], dims[2]);
+	const uint32 shapeflags = av->getShapeInfo()->_flags;
+
+	// Sweep the avatar's box from its location in each of the 16 directions
+	uint32 hits = 0;
+	Std::list<CurrentMap::SweepItem> collisions;
+	const uint32 startTime = g_system->getMillis();
+	for (int i = 0; i < count; i++) {
+		const Direction dir = static_cast<Direction>(i % 16);
+		const int32 end[3] = {
+			start[0] + Direction_XFactor(dir) * distance,
+			start[1] + Direction_YFactor(dir) * distance,
+			start[2]
+		};
+		collisions.clear();
+		map->sweepTest(start, end, dims, shapeflags, av->getObjId(), false, &collisions);
+		hits += collisions.size();
+	}
+	const uint32 elapsed = g_system->getMillis() - startTime;
+
+	debugPrintf("%d sweeps of %d units on map %u in %u ms, %u items hit\n",
+	            count, distance, map->getNum(), elapsed, hits);
+	if (elapsed)
+		debugPrintf("%u sweeps per second\n", (uint32)(count * 1000LL / elapsed));
+	return true;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
@@ -0,0 +1,245 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef ULTIMA8_WORLD_CHUNKCELLS_H
+#define ULTIMA8_WORLD_CHUNKCELLS_H
+
+#include "common/array.h"
+#include "common/scummsys.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+/**
+ * Splits the items of a CurrentMap chunk into a grid of cells by their
+ * location, so searches can skip the cells away from the searched area.
+ *
+ * Footpads extend towards -x and -y from the location, so each cell keeps
+ * the largest footpad extent of the items added to it since it was last
+ * empty.
+ *
+ * Each item has a key giving its position in the chunk's item list, and
+ * the items of a cell are sorted by it. Iterating over several cells
+ * merges them by key, so the items are still visited in the order of the
+ * chunk's item list.
+ *
+ * This class is basically private to CurrentMap, but is in a separate
+ * header to enable unit testing.
+ */
+template<class T>
+class ChunkCells {
+public:
+	static const int CELLS_PER_SIDE = 4;
+	static const int NUM_CELLS = CELLS_PER_SIDE * CELLS_PER_SIDE;
+
+	ChunkCells() {
+		clear();
+	}
+
+	void clear() {
+		for (int i = 0; i < NUM_CELLS; i++) {
+			_cells[i]._items.clear();
+			_cells[i]._extent = 0;
+		}
+		_frontKey = _backKey = 0;
+		_size = 0;
+	}
+
+	bool empty() const {
+		return _size == 0;
+	}
+
+	//! Add an item before all others, like item_list::push_front
+	void addToFront(T *item, int cell, int32 extent) {
+		insert(Entry(item, --_frontKey), cell, extent);
+	}
+
+	//! Add an item after all others, like item_list::push_back
+	void addToEnd(T *item, int cell, int32 extent) {
+		insert(Entry(item, ++_backKey), cell, extent);
+	}
+
+	//! Remove an item. oldCell is searched first, then all other cells.
+	//! \return false if the item is not in any cell
+	bool remove(const T *item, int oldCell) {
+		Entry entry;
+		if (!take(item, oldCell, entry))
+			return false;
+
+		if (_size == 0)
+			_frontKey = _backKey = 0;
+		return true;
+	}
+
+	//! Move an item to another cell, keeping its position in the order,
+	//! and grow the extent of its cell to its footpad extent.
+	//! \return false if the item had to be moved but is not in any cell
+	bool update(T *item, int oldCell, int newCell, int32 extent) {
+		if (oldCell == newCell) {
+			_cells[newCell]._extent = MAX(_cells[newCell]._extent, extent);
+			return true;
+		}
+
+		Entry entry;
+		if (!take(item, oldCell, entry))
+			return false;
+		insert(entry, newCell, extent);
+		return true;
+	}
+
+	/**
+	 * Get the cells which can hold items overlapping an area in x and y.
+	 * All coordinates are relative to the top-left corner of the chunk.
+	 * \return a bit mask of the cells, with bit (cy * CELLS_PER_SIDE + cx)
+	 */
+	uint16 getAreaCells(int32 left, int32 top, int32 right, int32 bottom,
+	                    int32 cellSize) const {
+		uint16 cells = 0;
+		for (int cy = 0; cy < CELLS_PER_SIDE; cy++) {
+			const int32 y = cy * cellSize;
+			if (y + cellSize - 1 < top)
+				continue;
+
+			for (int cx = 0; cx < CELLS_PER_SIDE; cx++) {
+				const int32 x = cx * cellSize;
+				if (x + cellSize - 1 < left)
+					continue;
+
+				const Cell &c = _cells[cy * CELLS_PER_SIDE + cx];
+				if (c._items.empty())
+					continue;
+				if (x - c._extent > right || y - c._extent > bottom)
+					continue;
+
+				cells |= 1 << (cy * CELLS_PER_SIDE + cx);
+			}
+		}
+		return cells;
+	}
+
+	/**
+	 * Iterates over the items of some cells in the order they were added
+	 * in. The chunk may be null, and must not be changed while iterating.
+	 */
+	class Iterator {
+	public:
+		Iterator(const ChunkCells *chunk, uint16 cells) : _chunk(chunk), _numCells(0) {
+			for (int i = 0; chunk && i < NUM_CELLS; i++) {
+				if ((cells & (1 << i)) && !chunk->_cells[i]._items.empty()) {
+					_active[_numCells] = i;
+					_pos[_numCells] = 0;
+					_numCells++;
+				}
+			}
+		}
+
+		//! \return the next item, or nullptr when done
+		T *next() {
+			int best = -1;
+			int32 bestKey = 0;
+			for (int i = 0; i < _numCells; i++) {
+				const int32 key = _chunk->_cells[_active[i]]._items[_pos[i]]._key;
+				if (best < 0 || key < bestKey) {
+					best = i;
+					bestKey = key;
+				}
+			}
+			if (best < 0)
+				return nullptr;
+
+			T *item = _chunk->_cells[_active[best]]._items[_pos[best]]._item;
+			if (++_pos[best] == _chunk->_cells[_active[best]]._items.size()) {
+				// This cell is done
+				_numCells--;
+				_active[best] = _active[_numCells];
+				_pos[best] = _pos[_numCells];
+			}
+			return item;
+		}
+
+	private:
+		const ChunkCells *_chunk;
+		int _numCells;
+		int _active[NUM_CELLS];
+		uint _pos[NUM_CELLS];
+	};
+
+private:
+	struct Entry {
+		Entry() : _item(nullptr), _key(0) { }
+		Entry(T *item, int32 key) : _item(item), _key(key) { }
+
+		T *_item;
+		int32 _key;
+	};
+
+	struct Cell {
+		Common::Array<Entry> _items; //!< sorted by key
+		int32 _extent;               //!< largest footpad extent in x or y
+	};
+
+	void insert(const Entry &entry, int cell, int32 extent) {
+		Cell &c = _cells[cell];
+		uint i = c._items.size();
+		while (i > 0 && c._items[i - 1]._key > entry._key)
+			i--;
+		c._items.insert_at(i, entry);
+		c._extent = MAX(c._extent, extent);
+		_size++;
+	}
+
+	bool take(const T *item, int cell, Entry &entry) {
+		if (takeFrom(item, cell, entry))
+			return true;
+
+		// Not in the expected cell, so check the others
+		for (int i = 0; i < NUM_CELLS; i++) {
+			if (i != cell && takeFrom(item, i, entry))
+				return true;
+		}
+		return false;
+	}
+
+	bool takeFrom(const T *item, int cell, Entry &entry) {
+		Cell &c = _cells[cell];
+		for (uint i = 0; i < c._items.size(); i++) {
+			if (c._items[i]._item == item) {
+				entry = c._items.remove_at(i);
+				if (c._items.empty())
+					c._extent = 0;
+				_size--;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	Cell _cells[NUM_CELLS];
+	int32 _frontKey;
+	int32 _backKey;
+	uint _size;
+};
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
+
+#endif
@@ -48,10 +48,20 @@ typedef Std::list<Item *> item_list;
 
 static const int INT_MAX_VALUE = 0x7fffffff;
 
+// The larger of the footpad's x and y sizes, which doesn't change when the
+// item is flipped
+static int32 getItemExtent(const Item *item) {
+	int32 xd, yd, zd;
+	item->getFootpadWorld(xd, yd, zd);
+	return MAX(xd, yd);
+}
+
 CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
 	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1) {
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
+		for (unsigned int j = 0; j < MAP_NUM_CHUNKS; j++)
+			_cells[i][j] = nullptr;
 	}
 
 	if (GAME_IS_U8) {
@@ -70,6 +80,10 @@ CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
 
 CurrentMap::~CurrentMap() {
 //	clear();
+	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
+		for (unsigned int j = 0; j < MAP_NUM_CHUNKS; j++)
+			delete _cells[i][j];
+	}
 }
 
 void CurrentMap::clear() {
@@ -79,6 +93,8 @@ void CurrentMap::clear() {
 			for (iter = _items[i][j].begin(); iter != _items[i][j].end(); ++iter)
 				delete *iter;
 			_items[i][j].clear();
+			if (_cells[i][j])
+				_cells[i][j]->clear();
 		}
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
@@ -147,6 +163,8 @@ void CurrentMap::writeback() {
 				}
 			}
 			_items[i][j].clear();
+			if (_cells[i][j])
+				_cells[i][j]->clear();
 		}
 	}
 
@@ -252,6 +270,9 @@ void CurrentMap::addItem(Item *item) {
 #endif
 
 	_items[cx][cy].push_front(item);
+	if (!_cells[cx][cy])
+		_cells[cx][cy] = new ChunkCells<Item>();
+	_cells[cx][cy]->addToFront(item, getItemCell(ix, iy), getItemExtent(item));
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -292,6 +313,9 @@ void CurrentMap::addItemToEnd(Item *item) {
 #endif
 
 	_items[cx][cy].push_back(item);
+	if (!_cells[cx][cy])
+		_cells[cx][cy] = new ChunkCells<Item>();
+	_cells[cx][cy]->addToEnd(item, getItemCell(ix, iy), getItemExtent(item));
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -406,9 +430,25 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 	int32 cy = oldy / _mapChunkSize;
 
 	_items[cx][cy].remove(item);
+	if (_cells[cx][cy])
+		_cells[cx][cy]->remove(item, getItemCell(oldx, oldy));
 	item->clearExtFlag(Item::EXT_INCURMAP);
 }
 
+void CurrentMap::updateItemCell(Item *item, int32 oldx, int32 oldy) {
+	int32 ix, iy, iz;
+
+	item->getLocation(ix, iy, iz);
+
+	if (ix < 0 || ix >= _mapChunkSize * MAP_NUM_CHUNKS ||
+	        iy < 0 || iy >= _mapChunkSize * MAP_NUM_CHUNKS)
+		return;
+
+	ChunkCells<Item> *cells = _cells[ix / _mapChunkSize][iy / _mapChunkSize];
+	if (cells)
+		cells->update(item, getItemCell(oldx, oldy), getItemCell(ix, iy), getItemExtent(item));
+}
+
 // Check to see if the chunk is on the screen
 static inline bool ChunkOnScreen(int32 cx, int32 cy, int32 sleft, int32 stop, int32 sright, int32 sbot, int mapChunkSize) {
 	int32 scx = (cx * mapChunkSize - cy * mapChunkSize) / 4;
@@ -551,6 +591,38 @@ inline void CurrentMap::clipMapChunks(int &minx, int &maxx, int &miny, int &maxy
 	maxy = CLIP(maxy, 0, MAP_NUM_CHUNKS - 1);
 }
 
+inline void CurrentMap::getAreaChunks(int32 left, int32 top, int32 right, int32 bottom,
+									  int &minx, int &maxx, int &miny, int &maxy) const {
+	// Items are in the chunk of their location, and their footpad extends
+	// towards -x and -y from it. Items in the chunks before the one of
+	// (left, top) end before the area, but items in the chunks after the
+	// one of (right, bottom) can still reach into it.
+	minx = left / _mapChunkSize;
+	maxx = (right / _mapChunkSize) + 1;
+	miny = top / _mapChunkSize;
+	maxy = (bottom / _mapChunkSize) + 1;
+	clipMapChunks(minx, maxx, miny, maxy);
+}
+
+inline int CurrentMap::getItemCell(int32 x, int32 y) const {
+	const int32 cellSize = _mapChunkSize / ChunkCells<Item>::CELLS_PER_SIDE;
+	return ((y % _mapChunkSize) / cellSize) * ChunkCells<Item>::CELLS_PER_SIDE +
+	       (x % _mapChunkSize) / cellSize;
+}
+
+inline ChunkCells<Item>::Iterator CurrentMap::getAreaItems(int cx, int cy, int32 left, int32 top,
+														   int32 right, int32 bottom) const {
+	const ChunkCells<Item> *cells = _cells[cx][cy];
+	if (!cells)
+		return ChunkCells<Item>::Iterator(nullptr, 0);
+
+	const int32 chunkx = cx * _mapChunkSize;
+	const int32 chunky = cy * _mapChunkSize;
+	return ChunkCells<Item>::Iterator(cells, cells->getAreaCells(left - chunkx, top - chunky,
+	                                  right - chunkx, bottom - chunky,
+	                                  _mapChunkSize / ChunkCells<Item>::CELLS_PER_SIDE));
+}
+
 void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 							uint32 scriptsize, const Item *check, uint16 range,
 							bool recurse, int32 x, int32 y) const {
@@ -566,11 +638,9 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 
 	const Rect searchrange(x - xd - range, y - yd - range, x + range, y + range);
 
-	int minx = ((x - xd - range) / _mapChunkSize) - 1;
-	int maxx = ((x + range) / _mapChunkSize) + 1;
-	int miny = ((y - yd - range) / _mapChunkSize) - 1;
-	int maxy = ((y + range) / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getAreaChunks(searchrange.left, searchrange.top, searchrange.right, searchrange.bottom,
+	              minx, maxx, miny, maxy);
 
 	//
 	// NOTE: Iteration order of chunks here is important for
@@ -583,11 +653,9 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 	//
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-
-				const Item *item = *iter;
+			ChunkCells<Item>::Iterator iter = getAreaItems(cx, cy,
+					searchrange.left, searchrange.top, searchrange.right, searchrange.bottom);
+			for (const Item *item = iter.next(); item; item = iter.next()) {
 
 				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
@@ -640,19 +708,15 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 	const Rect searchrange(origin[0] - dims[0], origin[1] - dims[1],
 	                       origin[0], origin[1]);
 
-	int minx = ((origin[0] - dims[0]) / _mapChunkSize) - 1;
-	int maxx = ((origin[0]) / _mapChunkSize) + 1;
-	int miny = ((origin[1] - dims[1]) / _mapChunkSize) - 1;
-	int maxy = ((origin[1]) / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getAreaChunks(searchrange.left, searchrange.top, searchrange.right, searchrange.bottom,
+	              minx, maxx, miny, maxy);
 
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-
-				const Item *item = *iter;
+			ChunkCells<Item>::Iterator iter = getAreaItems(cx, cy,
+					searchrange.left, searchrange.top, searchrange.right, searchrange.bottom);
+			for (const Item *item = iter.next(); item; item = iter.next()) {
 
 				if (item->getObjId() == check)
 					continue;
@@ -767,18 +831,13 @@ bool CurrentMap::isValidPosition(int32 x, int32 y, int32 z,
 	ObjId roof = 0;
 	int32 roofz = INT_MAX_VALUE;
 
-	int minx = ((x - xd) / _mapChunkSize) - 1;
-	int maxx = (x / _mapChunkSize) + 1;
-	int miny = ((y - yd) / _mapChunkSize) - 1;
-	int maxy = (y / _mapChunkSize) + 1;
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getAreaChunks(x - xd, y - yd, x, y, minx, maxx, miny, maxy);
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-				 iter != _items[cx][cy].end(); ++iter) {
-				const Item *item = *iter;
+			ChunkCells<Item>::Iterator iter = getAreaItems(cx, cy, x - xd, y - yd, x, y);
+			for (const Item *item = iter.next(); item; item = iter.next()) {
 				if (item->getObjId() == item_)
 					continue;
 				if (item->hasExtFlags(Item::EXT_SPRITE))
@@ -1033,27 +1092,18 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 						   Std::list<SweepItem> *hit) const {
 	const uint32 blockflagmask = (ShapeInfo::SI_SOLID | ShapeInfo::SI_DAMAGING | ShapeInfo::SI_LAND);
 
-	int minx = ((start[0] - dims[0]) / _mapChunkSize) - 1;
-	int maxx = (start[0] / _mapChunkSize) + 1;
-	int miny = ((start[1] - dims[1]) / _mapChunkSize) - 1;
-	int maxy = (start[1] / _mapChunkSize) + 1;
-
-	{
-		int dminx = ((end[0] - dims[0]) / _mapChunkSize) - 1;
-		int dmaxx = (end[0] / _mapChunkSize) + 1;
-		int dminy = ((end[1] - dims[1]) / _mapChunkSize) - 1;
-		int dmaxy = (end[1] / _mapChunkSize) + 1;
-		if (dminx < minx)
-			minx = dminx;
-		if (dmaxx > maxx)
-			maxx = dmaxx;
-		if (dminy < miny)
-			miny = dminy;
-		if (dmaxy > maxy)
-			maxy = dmaxy;
+	// The hit times below are rounded to 1/0x4000 of the sweep, so an item
+	// up to a unit per 0x4000 of movement away from the swept area can still
+	// be hit at the end of it
+	int32 sweptArea[4];
+	for (int i = 0; i < 2; i++) {
+		const int32 rounding = ABS(end[i] - start[i]) / 0x4000 + 1;
+		sweptArea[i] = MIN(start[i], end[i]) - dims[i] - rounding;
+		sweptArea[i + 2] = MAX(start[i], end[i]);
 	}
 
-	clipMapChunks(minx, maxx, miny, maxy);
+	int minx, maxx, miny, maxy;
+	getAreaChunks(sweptArea[0], sweptArea[1], sweptArea[2], sweptArea[3], minx, maxx, miny, maxy);
 
 	// Get velocity, extents, and centre of item
 	int32 vel[3];
@@ -1077,10 +1127,9 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *other_item = *iter;
+			ChunkCells<Item>::Iterator iter = getAreaItems(cx, cy,
+					sweptArea[0], sweptArea[1], sweptArea[2], sweptArea[3]);
+			for (const Item *other_item = iter.next(); other_item; other_item = iter.next()) {
 				if (other_item->getObjId() == item)
 					continue;
 				if (other_item->hasExtFlags(Item::EXT_SPRITE))
@@ -26,6 +26,7 @@
 #include "ultima/shared/std/containers.h"
 #include "ultima/ultima8/usecode/intrinsics.h"
 #include "ultima/ultima8/misc/direction.h"
+#include "ultima/ultima8/world/chunk_cells.h"
 
 namespace Ultima {
 namespace Ultima8 {
@@ -71,6 +72,10 @@ public:
 	void removeItemFromList(Item *item, int32 oldx, int32 oldy);
 	void removeItem(Item *item);
 
+	//! Update the search cell of an item which moved within its chunk or
+	//! changed its shape. (oldx, oldy) is its location before the change.
+	void updateItemCell(Item *item, int32 oldx, int32 oldy);
+
 	//! Add an item to the list of possible targets (in Crusader)
 	void addTargetItem(const Item *item);
 	//! Remove an item from the list of possible targets (in Crusader)
@@ -223,12 +228,28 @@ private:
 	//! clip the given map chunk numbers to iterate over them safely
 	static void clipMapChunks(int &minx, int &maxx, int &miny, int &maxy);
 
+	//! Get the chunks holding the items which can overlap an area in x and y
+	void getAreaChunks(int32 left, int32 top, int32 right, int32 bottom,
+	                   int &minx, int &maxx, int &miny, int &maxy) const;
+
+	//! Get the cell of a location in its chunk
+	int getItemCell(int32 x, int32 y) const;
+
+	//! Iterate over the items of a chunk which can overlap an area in x and y,
+	//! in the order of the chunk's item list
+	ChunkCells<Item>::Iterator getAreaItems(int cx, int cy, int32 left, int32 top,
+	                                        int32 right, int32 bottom) const;
+
 	Map *_currentMap;
 
 	// item lists. Lots of them :-)
 	// items[x][y]
 	Std::list<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
 
+	// The same items split into cells for searching, allocated when the
+	// first item is added to a chunk
+	ChunkCells<Item> *_cells[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+
 	ProcId _eggHatcher;
 
 	// Fast area bit masks -> fast[ry][rx/32]&(1<<(rx&31));
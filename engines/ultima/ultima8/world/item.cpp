@@ -202,6 +202,9 @@ void Item::move(int32 X, int32 Y, int32 Z) {
 	// Unset all the various _flags that no longer apply
 	_flags &= ~(FLG_CONTAINED | FLG_EQUIPPED | FLG_ETHEREAL);
 
+	const int32 oldX = _x;
+	const int32 oldY = _y;
+
 	// Set the location
 	_x = X;
 	_y = Y;
@@ -215,6 +218,9 @@ void Item::move(int32 X, int32 Y, int32 Z) {
 			map->addItemToEnd(this);
 		else
 			map->addItem(this);
+	} else {
+		// Still in the same chunk, but maybe in another cell of it
+		map->updateItemCell(this, oldX, oldY);
 	}
 
 	// Call just moved
@@ -491,6 +497,10 @@ void Item::setShape(uint32 shape) {
 		_shape = shape;
 		_cachedShapeInfo = nullptr;
 	}
+
+	// The map's search cells need to know about a larger footpad
+	if (_extendedFlags & EXT_INCURMAP)
+		World::get_instance()->getCurrentMap()->updateItemCell(this, _x, _y);
 }
 
 bool Item::overlaps(const Item &item2) const {
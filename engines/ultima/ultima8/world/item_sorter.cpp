@@ -39,12 +39,23 @@
 
 #include "ultima/ultima8/world/sort_item.h"
 
+#include "common/algorithm.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
+// Size of the cells of the screenspace grid, in pixels
+static const int32 GRID_CELL_SIZE = 64;
+
+static bool SortItemListBefore(const SortItem *si1, const SortItem *si2) {
+	return si1->ListBefore(si2);
+}
+
 ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
+	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0),
+	_numItems(0), _sorted(true), _overlapTests(0), _gridLeft(0), _gridTop(0),
+	_gridWidth(0), _gridHeight(0) {
 	int i = 2048;
 	while (i--) _itemsUnused = new SortItem(_itemsUnused);
 }
@@ -83,6 +94,23 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	// Set the RenderSurface, and reset the item list
 	_surf = rs;
 	_orderCounter = 0;
+	_numItems = 0;
+	_sorted = true;
+	_overlapTests = 0;
+
+	// The grid covers the clipping rect. Bounding boxes going past it are
+	// clamped to the border cells, so they still share cells with anything
+	// they overlap.
+	Rect clip;
+	_surf->GetClippingRect(clip);
+	_gridLeft = clip.left;
+	_gridTop = clip.top;
+	_gridWidth = MAX<int32>((clip.right - clip.left + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE, 1);
+	_gridHeight = MAX<int32>((clip.bottom - clip.top + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE, 1);
+	_gridCells.resize(_gridWidth * _gridHeight);
+	for (uint i = 0; i < _gridCells.size(); i++)
+		_gridCells[i] = -1;
+	_gridNodes.resize(0);
 
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	_camSx = (camx - camy) / 4;
@@ -173,23 +201,42 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 
 	si->_occluded = false;
 	si->_order = -1;
+	si->_addOrder = _numItems;
+	si->_gridStamp = -1;
 
 	// We will clear all the vector memory
 	// Stictly speaking the vector will sort of leak memory, since they
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	// Only the items sharing a grid cell with us can overlap. They are
+	// compared in the order of the display list, like when walking it whole.
+	int32 cx1, cy1, cx2, cy2;
+	GetGridCells(si, cx1, cy1, cx2, cy2);
+	_candidates.resize(0);
+	for (int32 cy = cy1; cy <= cy2; cy++) {
+		for (int32 cx = cx1; cx <= cx2; cx++) {
+			for (int32 n = _gridCells[cy * _gridWidth + cx]; n != -1; n = _gridNodes[n]._next) {
+				SortItem *si2 = _gridNodes[n]._item;
+				// Already found in another cell
+				if (si2->_gridStamp == si->_addOrder)
+					continue;
+				si2->_gridStamp = si->_addOrder;
+				_candidates.push_back(si2);
+			}
+		}
+	}
+	Common::sort(_candidates.begin(), _candidates.end(), SortItemListBefore);
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->ListLessThan(si2))
-			addpoint = si2;
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
+
+		if (si2->_occluded)
+			continue;
 
 		// Doesn't overlap
-		if (si2->_occluded || !si->overlap(*si2))
+		_overlapTests++;
+		if (!si->overlap(*si2))
 			continue;
 
 		// Attempt to find which is infront
@@ -213,30 +260,67 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 		}
 	}
 
-	// Add it to the list
+	// Occluded items are skipped by the items added after us
+	if (!si->_occluded) {
+		for (int32 cy = cy1; cy <= cy2; cy++) {
+			for (int32 cx = cx1; cx <= cx2; cx++) {
+				GridNode node;
+				node._item = si;
+				node._next = _gridCells[cy * _gridWidth + cx];
+				_gridCells[cy * _gridWidth + cx] = _gridNodes.size();
+				_gridNodes.push_back(node);
+			}
+		}
+	}
+
+	// Add it to the end of the list, it is sorted before painting
 	_itemsUnused = _itemsUnused->_next;
 
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
+	if (_itemsTail)
+		_itemsTail->_next = si;
+	if (!_items)
+		_items = si;
+	si->_next = nullptr;
+	si->_prev = _itemsTail;
+	_itemsTail = si;
+
+	_numItems++;
+	_sorted = false;
+}
+
+void ItemSorter::GetGridCells(const SortItem *si, int32 &cx1, int32 &cy1, int32 &cx2, int32 &cy2) const {
+	// SortItem::overlap is false unless the items overlap within these
+	// screenspace extents
+	cx1 = CLIP<int32>((si->_sxLeft - _gridLeft) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	cx2 = CLIP<int32>((si->_sxRight - _gridLeft) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	cy1 = CLIP<int32>((si->_syTop - _gridTop) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+	cy2 = CLIP<int32>((si->_syBot - _gridTop) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+}
+
+void ItemSorter::SortDisplayList() {
+	if (_sorted)
+		return;
+
+	_sortBuffer.resize(0);
+	for (SortItem *it = _items; it != nullptr; it = it->_next)
+		_sortBuffer.push_back(it);
+	Common::sort(_sortBuffer.begin(), _sortBuffer.end(), SortItemListBefore);
+
+	SortItem *prev = nullptr;
+	for (uint i = 0; i < _sortBuffer.size(); i++) {
+		SortItem *it = _sortBuffer[i];
+		it->_prev = prev;
+		if (prev)
+			prev->_next = it;
 		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
+			_items = it;
+		prev = it;
 	}
+	if (prev)
+		prev->_next = nullptr;
+	_itemsTail = prev;
+
+	_sorted = true;
 }
 
 void ItemSorter::AddItem(const Item *add) {
@@ -249,6 +333,8 @@ void ItemSorter::AddItem(const Item *add) {
 SortItem *_prev = 0;
 
 void ItemSorter::PaintDisplayList(bool item_highlight) {
+	SortDisplayList();
+
 	_prev = nullptr;
 	SortItem *it = _items;
 	SortItem *end = nullptr;
@@ -394,6 +480,8 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	SortDisplayList();
+
 	if (!_orderCounter) { // If no _orderCounter we need to sort the _items
 		it = _items;
 		_orderCounter = 0;  // Reset the _orderCounter
@@ -510,5 +598,10 @@ void ItemSorter::IncSortLimit(int count) {
 		_sortLimit = 0;
 }
 
+void ItemSorter::GetSortStats(uint32 &items, uint32 &overlapTests) const {
+	items = _numItems;
+	overlapTests = _overlapTests;
+}
+
 } // End of namespace Ultima8
 } // End of namespace Ultima
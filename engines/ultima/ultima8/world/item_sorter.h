@@ -23,6 +23,8 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "ultima/shared/std/containers.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -44,6 +46,24 @@ class ItemSorter {
 
 	int32       _camSx, _camSy;
 
+	int32       _numItems;      // Items added since BeginDisplayList
+	bool        _sorted;        // The list is in painting order
+	uint32      _overlapTests;  // Overlap tests done since BeginDisplayList
+
+	// Screenspace grid of the items' bounding boxes. Only items sharing a
+	// cell are tested for overlap.
+	struct GridNode {
+		SortItem    *_item;
+		int32       _next;      // Next node of the cell, or -1
+	};
+	Std::vector<int32>      _gridCells;     // First node of each cell, or -1
+	Std::vector<GridNode>   _gridNodes;
+	int32       _gridLeft, _gridTop;
+	int32       _gridWidth, _gridHeight;    // In cells
+
+	Std::vector<SortItem *> _candidates;    // Scratch list for AddItem
+	Std::vector<SortItem *> _sortBuffer;    // Scratch list for SortDisplayList
+
 public:
 	ItemSorter();
 	~ItemSorter();
@@ -67,9 +87,18 @@ public:
 
 	void IncSortLimit(int count);
 
+	//! Get the number of items and overlap tests of the current display list
+	void GetSortStats(uint32 &items, uint32 &overlapTests) const;
+
 private:
 	bool PaintSortItem(SortItem *);
 	bool NullPaintSortItem(SortItem *);
+
+	// Get the grid cells covered by the screenspace bounding box of an item
+	void GetGridCells(const SortItem *si, int32 &cx1, int32 &cy1, int32 &cx2, int32 &cy2) const;
+
+	// Put the items in the list in the order they should be painted
+	void SortDisplayList();
 };
 
 } // End of namespace Ultima8
@@ -38,7 +38,7 @@ class Shape;
  * Other code should have no reason to include it.
  */
 struct SortItem {
-	SortItem(SortItem *n) : _next(n), _prev(nullptr), _itemNum(0),
+	SortItem(SortItem *n) : _next(n), _prev(nullptr), _addOrder(0), _gridStamp(-1), _itemNum(0),
 			_shape(nullptr), _order(-1), _depends(), _shapeNum(0),
 			_frame(0), _flags(0), _extFlags(0), _sx(0), _sy(0),
 			_sx2(0), _sy2(0), _x(0), _y(0), _z(0), _xLeft(0),
@@ -52,6 +52,9 @@ struct SortItem {
 	SortItem                *_next;
 	SortItem                *_prev;
 
+	int32                   _addOrder;  // Number of items added to the list before this one
+	int32                   _gridStamp; // _addOrder of the last item tested against this one
+
 	uint16                  _itemNum;   // Owner item number
 
 	const Shape             *_shape;
@@ -233,6 +236,16 @@ struct SortItem {
 		return _z < other->_z || (_z == other->_z && _flat && !other->_flat);
 	}
 
+	// Order of the display list: sorted with ListLessThan, and in the order
+	// the items were added when that doesn't tell them apart
+	inline bool ListBefore(const SortItem *other) const {
+		if (ListLessThan(other))
+			return true;
+		if (other->ListLessThan(this))
+			return false;
+		return _addOrder < other->_addOrder;
+	}
+
 };
 
 inline bool SortItem::overlap(const SortItem &si2) const {
@@ -58,6 +58,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 
 	_symbols = nullptr;
 	_numSymbols = 0;
+	_varCache = nullptr;
 
 	_engine = engine;
 
@@ -189,6 +190,10 @@ bool ScScript::initTables() {
 		_symbols[index] = getString();
 	}
 
+	delete[] _varCache;
+	_varCache = new VarCacheEntry[_numSymbols];
+	clearCaches();
+
 	// load functions table
 	_iP = _header.funcTable;
 
@@ -411,6 +416,10 @@ void ScScript::cleanup() {
 	_symbols = nullptr;
 	_numSymbols = 0;
 
+	delete[] _varCache;
+	_varCache = nullptr;
+	_propCache.clear();
+
 	if (_globals && !_thread) {
 		delete _globals;
 	}
@@ -569,6 +578,7 @@ bool ScScript::executeInstruction() {
 	ScValue *op1;
 	ScValue *op2;
 
+	uint32 instPos = _iP;
 	uint32 inst = getDWORD();
 
 #ifdef ENABLE_FOXTAIL
@@ -577,6 +587,10 @@ bool ScScript::executeInstruction() {
 	}
 #endif
 
+	if (_engine->getIsProfiling()) {
+		_engine->addInstructionCount(inst);
+	}
+
 	preInstHook(inst);
 
 	switch (inst) {
@@ -755,7 +769,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVarCached(getDWORD());
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -766,15 +780,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVarCached(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getVarCached(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -827,7 +840,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVarCached(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -837,7 +850,7 @@ bool ScScript::executeInstruction() {
 
 	case II_PUSH_BY_EXP: {
 		str = _stack->pop()->getString();
-		ScValue *val = _stack->pop()->getProp(str);
+		ScValue *val = getPropCached(instPos, _stack->pop(), str);
 		if (val) {
 			_stack->push(val);
 		} else {
@@ -856,7 +869,7 @@ bool ScScript::executeInstruction() {
 			runtimeError("Script stack corruption detected. Please report this script at WME bug reports forum.");
 			var->setNULL();
 		} else {
-			var->setProp(str, val);
+			setPropCached(instPos, var, str, val);
 		}
 
 		break;
@@ -1228,6 +1241,94 @@ ScValue *ScScript::getVar(char *name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getVarCached(uint32 symbol) {
+	ScValue *scope = _scopeStack->getTop();
+	VarCacheEntry &entry = _varCache[symbol];
+
+	if (entry.matches(scope, _globals, _engine->_globals)) {
+		if (_engine->getIsProfiling()) {
+			_engine->addVarLookup(true);
+		}
+		return entry.value;
+	}
+
+	if (_engine->getIsProfiling()) {
+		_engine->addVarLookup(false);
+	}
+
+	// getVar() may create the variable, so read the layouts afterwards
+	ScValue *ret = getVar(_symbols[symbol]);
+	entry.store(_scopeStack->getTop(), _globals, _engine->_globals, ret);
+
+	return ret;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getPropCached(uint32 instPos, ScValue *var, const char *name) {
+	if (_engine->getIsProfiling()) {
+		_engine->addPropertyAccess(name);
+	}
+
+	ScValue *owner = scCacheableObject(var);
+	if (!owner) {
+		return var->getProp(name);
+	}
+
+	return getOwnPropCached(instPos, owner, name);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScScript::setPropCached(uint32 instPos, ScValue *var, const char *name, ScValue *val) {
+	if (_engine->getIsProfiling()) {
+		_engine->addPropertyAccess(name);
+	}
+
+	// Assigning to an existing property of a plain object is what
+	// ScValue::setProp() would do, minus the hash lookup
+	ScValue *owner = scCacheableObject(var);
+	ScValue *prop = owner ? getOwnPropCached(instPos, owner, name) : nullptr;
+	if (prop) {
+		prop->cleanup();
+		prop->copy(val);
+		prop->_isConstVar = false;
+	} else {
+		var->setProp(name, val);
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getOwnPropCached(uint32 instPos, ScValue *owner, const char *name) {
+	ScPropCacheEntry<ScValue> &entry = _propCache[instPos];
+	if (entry.matches(owner, name)) {
+		if (_engine->getIsProfiling()) {
+			_engine->addPropLookup(true);
+		}
+		return entry.value;
+	}
+
+	if (_engine->getIsProfiling()) {
+		_engine->addPropLookup(false);
+	}
+
+	entry.store(owner, name, owner->getOwnProp(name));
+
+	return entry.value;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScScript::clearCaches() {
+	for (uint32 i = 0; i < _numSymbols; i++) {
+		_varCache[i].clear();
+	}
+	_propCache.clear();
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::waitFor(BaseObject *object) {
 	if (_unbreakable) {
@@ -1322,6 +1423,9 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 			persistMgr->transferSint32(TMEMBER(bufferSize));
 		}
 	} else {
+		delete[] _varCache;
+		_varCache = nullptr;
+		_propCache.clear();
 		persistMgr->transferUint32(TMEMBER(_bufferSize));
 		if (_bufferSize > 0) {
 			_buffer = new byte[_bufferSize];
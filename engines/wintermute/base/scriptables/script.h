@@ -32,8 +32,11 @@
 
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
+#include "engines/wintermute/base/scriptables/script_cache.h"
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/persistent.h"
+#include "common/hashmap.h"
+#include "common/str.h"
 
 namespace Wintermute {
 class BaseScriptHolder;
@@ -165,6 +168,25 @@ private:
 	bool initScript();
 	bool initTables();
 
+	/**
+	 * Inline cache for variable lookups, indexed by symbol. Remembers where
+	 * getVar() found a symbol while the layouts involved are unchanged.
+	 */
+	typedef ScVarCacheEntry<ScValue> VarCacheEntry;
+	VarCacheEntry *_varCache;
+	ScValue *getVarCached(uint32 symbol);
+
+	/**
+	 * Inline cache for II_PUSH_BY_EXP / II_POP_BY_EXP, keyed by the
+	 * position of the instruction in the script buffer.
+	 */
+	typedef Common::HashMap<uint32, ScPropCacheEntry<ScValue> > PropCache;
+	PropCache _propCache;
+	ScValue *getPropCached(uint32 instPos, ScValue *var, const char *name);
+	void setPropCached(uint32 instPos, ScValue *var, const char *name, ScValue *val);
+	ScValue *getOwnPropCached(uint32 instPos, ScValue *owner, const char *name);
+	void clearCaches();
+
 	virtual void preInstHook(uint32 inst);
 	virtual void postInstHook(uint32 inst);
 
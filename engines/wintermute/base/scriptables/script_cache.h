@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef WINTERMUTE_SCRIPT_CACHE_H
+#define WINTERMUTE_SCRIPT_CACHE_H
+
+#include "common/str.h"
+
+#include "engines/wintermute/base/scriptables/dcscript.h"
+
+namespace Wintermute {
+
+/**
+ * Hand out a new layout id for a script value. 0 is never returned, so
+ * cache entries can use it for "no layout".
+ */
+inline uint32 scNextLayoutId() {
+	static uint32 lastId = 0;
+	if (++lastId == 0) {
+		lastId = 1;
+	}
+	return lastId;
+}
+
+/**
+ * Inline cache entry for a variable lookup by symbol. Remembers where the
+ * lookup through the scope, the script globals and the engine globals
+ * ended up; the entry stays valid while the layouts of those are unchanged.
+ */
+template<class VALUE>
+struct ScVarCacheEntry {
+	ScVarCacheEntry() { clear(); }
+
+	void clear() {
+		scopeLayout = globalsLayout = engineGlobalsLayout = 0;
+		value = nullptr;
+	}
+
+	bool matches(const VALUE *scope, const VALUE *globals, const VALUE *engineGlobals) const {
+		return value && scopeLayout == layoutOf(scope) &&
+		       globalsLayout == layoutOf(globals) &&
+		       engineGlobalsLayout == layoutOf(engineGlobals);
+	}
+
+	void store(const VALUE *scope, const VALUE *globals, const VALUE *engineGlobals, VALUE *val) {
+		scopeLayout = layoutOf(scope);
+		globalsLayout = layoutOf(globals);
+		engineGlobalsLayout = layoutOf(engineGlobals);
+		value = val;
+	}
+
+	uint32 scopeLayout;
+	uint32 globalsLayout;
+	uint32 engineGlobalsLayout;
+	VALUE *value;
+
+private:
+	static uint32 layoutOf(const VALUE *val) { return val ? val->getLayoutId() : 0; }
+};
+
+/**
+ * Return the plain object whose own properties an access to a property of
+ * @p var may cache, or nullptr. Values on the stack are fresh copies, and
+ * natives and strings resolve their properties themselves: reading one
+ * returns a scratch value, and writing one must go through their setter.
+ */
+template<class VALUE>
+VALUE *scCacheableObject(VALUE *var) {
+	if (var->_type != VAL_VARIABLE_REF || !var->_valRef || var->_valRef->_type != VAL_OBJECT) {
+		return nullptr;
+	}
+	return var->_valRef;
+}
+
+/**
+ * Inline cache entry for a property lookup on a plain object. The entry
+ * stays valid while the object's layout is unchanged.
+ */
+template<class VALUE>
+struct ScPropCacheEntry {
+	ScPropCacheEntry() : layout(0), value(nullptr) {}
+
+	bool matches(const VALUE *owner, const char *propName) const {
+		return layout == owner->getLayoutId() && name.equals(propName);
+	}
+
+	void store(const VALUE *owner, const char *propName, VALUE *val) {
+		layout = owner->getLayoutId();
+		name = propName;
+		value = val;
+	}
+
+	uint32 layout;
+	Common::String name;
+	VALUE *value;
+};
+
+} // End of namespace Wintermute
+
+#endif
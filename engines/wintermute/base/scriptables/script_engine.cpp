@@ -34,6 +34,7 @@
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/utils/utils.h"
+#include "common/algorithm.h"
 
 namespace Wintermute {
 
@@ -84,6 +85,10 @@ ScEngine::ScEngine(BaseGame *inGame) : BaseClass(inGame) {
 	_isProfiling = false;
 	_profilingStartTime = 0;
 
+	memset(_instructionCounts, 0, sizeof(_instructionCounts));
+	_varCacheHits = _varCacheMisses = 0;
+	_propCacheHits = _propCacheMisses = 0;
+
 	//EnableProfiling();
 }
 
@@ -602,6 +607,10 @@ void ScEngine::enableProfiling() {
 
 	// destroy old data, if any
 	_scriptTimes.clear();
+	_propertyAccesses.clear();
+	memset(_instructionCounts, 0, sizeof(_instructionCounts));
+	_varCacheHits = _varCacheMisses = 0;
+	_propCacheHits = _propCacheMisses = 0;
 
 	_profilingStartTime = g_system->getMillis();
 	_isProfiling = true;
@@ -620,28 +629,118 @@ void ScEngine::disableProfiling() {
 
 
 //////////////////////////////////////////////////////////////////////////
-void ScEngine::dumpStats() {
-	error("DumpStats not ported to ScummVM yet");
-	/*  uint32 totalTime = g_system->getMillis() - _profilingStartTime;
+void ScEngine::addInstructionCount(uint32 inst) {
+	if (inst < kNumInstructions) {
+		_instructionCounts[inst]++;
+	}
+}
 
-	    typedef std::vector <std::pair<uint32, std::string> > TimeVector;
-	    TimeVector times;
 
-	    ScriptTimes::iterator it;
-	    for (it = _scriptTimes.begin(); it != _scriptTimes.end(); ++it) {
-	        times.push_back(std::pair<uint32, std::string> (it->_value, it->_key));
-	    }
-	    std::sort(times.begin(), times.end());
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::addVarLookup(bool cacheHit) {
+	if (cacheHit) {
+		_varCacheHits++;
+	} else {
+		_varCacheMisses++;
+	}
+}
 
 
-	    TimeVector::reverse_iterator tit;
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::addPropLookup(bool cacheHit) {
+	if (cacheHit) {
+		_propCacheHits++;
+	} else {
+		_propCacheMisses++;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::addPropertyAccess(const char *name) {
+	_propertyAccesses[name]++;
+}
 
-	    _gameRef->LOG(0, "***** Script profiling information: *****");
-	    _gameRef->LOG(0, "  %-40s %fs", "Total execution time", (float)totalTime / 1000);
 
-	    for (tit = times.rbegin(); tit != times.rend(); ++tit) {
-	        _gameRef->LOG(0, "  %-40s %fs (%f%%)", tit->second.c_str(), (float)tit->first / 1000, (float)tit->first / (float)totalTime * 100);
-	    }*/
+static const char *const instructionNames[] = {
+	"DEF_VAR", "DEF_GLOB_VAR", "RET", "RET_EVENT", "CALL", "CALL_BY_EXP",
+	"EXTERNAL_CALL", "SCOPE", "CORRECT_STACK", "CREATE_OBJECT", "POP_EMPTY",
+	"PUSH_VAR", "PUSH_VAR_REF", "POP_VAR", "PUSH_VAR_THIS", "PUSH_INT",
+	"PUSH_BOOL", "PUSH_FLOAT", "PUSH_STRING", "PUSH_NULL",
+	"PUSH_THIS_FROM_STACK", "PUSH_THIS", "POP_THIS", "PUSH_BY_EXP",
+	"POP_BY_EXP", "JMP", "JMP_FALSE", "ADD", "SUB", "MUL", "DIV", "MODULO",
+	"NOT", "AND", "OR", "CMP_EQ", "CMP_NE", "CMP_L", "CMP_G", "CMP_LE",
+	"CMP_GE", "CMP_STRICT_EQ", "CMP_STRICT_NE", "DBG_LINE", "POP_REG1",
+	"PUSH_REG1", "DEF_CONST_VAR"
+};
+
+struct StatEntry {
+	StatEntry(uint32 v, const Common::String &n) : value(v), name(n) {}
+	uint32 value;
+	Common::String name;
+};
+
+static bool statEntryGreater(const StatEntry &a, const StatEntry &b) {
+	return a.value > b.value;
+}
+
+static Common::Array<StatEntry> sortedStats(const Common::HashMap<Common::String, uint32> &map) {
+	Common::Array<StatEntry> entries;
+	for (Common::HashMap<Common::String, uint32>::const_iterator it = map.begin(); it != map.end(); ++it) {
+		entries.push_back(StatEntry(it->_value, it->_key));
+	}
+	Common::sort(entries.begin(), entries.end(), statEntryGreater);
+	return entries;
+}
+
+static float hitRate(uint32 hits, uint32 misses) {
+	return hits + misses ? (float)hits / (float)(hits + misses) * 100 : 0.0f;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::getStats(Common::StringArray &lines) const {
+	uint32 totalTime = g_system->getMillis() - _profilingStartTime;
+
+	lines.push_back("***** Script profiling information: *****");
+	lines.push_back(Common::String::format("  %-40s %fs", "Total execution time", (float)totalTime / 1000));
+
+	Common::Array<StatEntry> times = sortedStats(_scriptTimes);
+	for (uint i = 0; i < times.size(); i++) {
+		lines.push_back(Common::String::format("  %-40s %fs (%f%%)", times[i].name.c_str(), (float)times[i].value / 1000, totalTime ? (float)times[i].value / (float)totalTime * 100 : 0.0f));
+	}
+
+	Common::Array<StatEntry> instructions;
+	for (uint32 i = 0; i < kNumInstructions; i++) {
+		if (_instructionCounts[i]) {
+			instructions.push_back(StatEntry(_instructionCounts[i], instructionNames[i]));
+		}
+	}
+	Common::sort(instructions.begin(), instructions.end(), statEntryGreater);
+
+	lines.push_back("***** Executed instructions: *****");
+	for (uint i = 0; i < instructions.size(); i++) {
+		lines.push_back(Common::String::format("  %-40s %u", instructions[i].name.c_str(), instructions[i].value));
+	}
+
+	lines.push_back("***** Property lookups: *****");
+	lines.push_back(Common::String::format("  %-40s %u hits, %u misses (%f%%)", "Variable cache", _varCacheHits, _varCacheMisses, hitRate(_varCacheHits, _varCacheMisses)));
+	lines.push_back(Common::String::format("  %-40s %u hits, %u misses (%f%%)", "Property cache", _propCacheHits, _propCacheMisses, hitRate(_propCacheHits, _propCacheMisses)));
+
+	Common::Array<StatEntry> properties = sortedStats(_propertyAccesses);
+	lines.push_back("***** Most accessed properties: *****");
+	for (uint i = 0; i < properties.size() && i < 20; i++) {
+		lines.push_back(Common::String::format("  %-40s %u", properties[i].name.c_str(), properties[i].value));
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::dumpStats() {
+	Common::StringArray lines;
+	getStats(lines);
+	for (uint i = 0; i < lines.size(); i++) {
+		_gameRef->LOG(0, "%s", lines[i].c_str());
+	}
 }
 
 } // End of namespace Wintermute
@@ -32,6 +32,8 @@
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/base/base.h"
+#include "engines/wintermute/base/scriptables/dcscript.h"
+#include "common/str-array.h"
 
 namespace Wintermute {
 
@@ -104,6 +106,11 @@ public:
 	}
 
 	void addScriptTime(const char *filename, uint32 Time);
+	void addInstructionCount(uint32 inst);
+	void addVarLookup(bool cacheHit);
+	void addPropLookup(bool cacheHit);
+	void addPropertyAccess(const char *name);
+	void getStats(Common::StringArray &lines) const;
 	void dumpStats();
 
 private:
@@ -115,6 +122,16 @@ private:
 	typedef Common::HashMap<Common::String, uint32> ScriptTimes;
 	ScriptTimes _scriptTimes;
 
+	static const uint32 kNumInstructions = II_DEF_CONST_VAR + 1;
+	uint32 _instructionCounts[kNumInstructions];
+	uint32 _varCacheHits;
+	uint32 _varCacheMisses;
+	uint32 _propCacheHits;
+	uint32 _propCacheMisses;
+
+	typedef Common::HashMap<Common::String, uint32> PropertyAccesses;
+	PropertyAccesses _propertyAccesses;
+
 };
 
 } // End of namespace Wintermute
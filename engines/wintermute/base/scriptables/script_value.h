@@ -83,6 +83,17 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	/**
+	 * Look up a property stored in this value, bypassing native and
+	 * string properties. Returns nullptr if there is no such property.
+	 */
+	ScValue *getOwnProp(const char *name);
+	/**
+	 * Identifies the set of properties stored in this value. The id is unique
+	 * among all values and changes whenever a property is added or removed,
+	 * so a property pointer resolved earlier stays valid while it matches.
+	 */
+	uint32 getLayoutId() const { return _layoutId; }
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -90,6 +101,10 @@ private:
 	int32 _valInt;
 	double _valFloat;
 	char *_valString;
+	uint32 _layoutId;
+	void updateLayoutId();
+	Common::HashMap<Common::String, ScValue *> _valObject;
+	Common::HashMap<Common::String, ScValue *>::iterator _valIter;
 public:
 	TValType _type;
 	ScValue(BaseGame *inGame);
@@ -98,8 +113,6 @@ public:
 	ScValue(BaseGame *inGame, double Val);
 	ScValue(BaseGame *inGame, const char *Val);
 	~ScValue() override;
-	Common::HashMap<Common::String, ScValue *> _valObject;
-	Common::HashMap<Common::String, ScValue *>::iterator _valIter;
 
 	bool setProperty(const char *propName, int32 value);
 	bool setProperty(const char *propName, const char *value);
@@ -23,6 +23,8 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/scriptables/script_engine.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -36,6 +38,7 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("script_profile", WRAP_METHOD(Console, Cmd_ScriptProfile));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -308,6 +311,31 @@ bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_ScriptProfile(int argc, const char **argv) {
+	ScEngine *scEngine = _engineRef->_game->_scEngine;
+	Common::String arg = argc == 2 ? argv[1] : "";
+
+	if (arg == "start") {
+		scEngine->enableProfiling();
+	} else if (arg == "stop" || arg == "show") {
+		if (!scEngine->getIsProfiling()) {
+			debugPrintf("Script profiling is not running\n");
+			return true;
+		}
+		Common::StringArray lines;
+		scEngine->getStats(lines);
+		for (uint i = 0; i < lines.size(); i++) {
+			debugPrintf("%s\n", lines[i].c_str());
+		}
+		if (arg == "stop") {
+			scEngine->disableProfiling();
+		}
+	} else {
+		debugPrintf("Usage: %s [start|stop|show]\n", argv[0]);
+	}
+	return true;
+}
+
 bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Usage: %s <file path> <output file name>\n", argv[0]);
@@ -50,6 +50,7 @@ Console::Console(ZVision *engine) : GUI::Debugger(), _engine(engine) {
 	registerCmd("generaterendertable", WRAP_METHOD(Console, cmdGenerateRenderTable));
 	registerCmd("setpanoramafov", WRAP_METHOD(Console, cmdSetPanoramaFoV));
 	registerCmd("setpanoramascale", WRAP_METHOD(Console, cmdSetPanoramaScale));
+	registerCmd("warpbenchmark", WRAP_METHOD(Console, cmdWarpBenchmark));
 	registerCmd("location", WRAP_METHOD(Console, cmdLocation));
 	registerCmd("dumpfile", WRAP_METHOD(Console, cmdDumpFile));
 	registerCmd("dumpfiles", WRAP_METHOD(Console, cmdDumpFiles));
@@ -201,6 +202,63 @@ bool Console::cmdSetPanoramaScale(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdWarpBenchmark(int argc, const char **argv) {
+	int frames = (argc > 1) ? atoi(argv[1]) : 100;
+	if (argc > 2 || frames <= 0) {
+		debugPrintf("Use %s [frames] to time the panorama and tilt warping of a whole frame and of a 64x64 rect\n", argv[0]);
+		return true;
+	}
+
+	static const RenderTable::RenderState states[] = { RenderTable::PANORAMA, RenderTable::TILT };
+	static const char *const stateNames[] = { "panorama", "tilt" };
+
+	// Warp a pattern at the size of the game view, which is what is done for each frame
+	const RenderTable *current = _engine->getRenderManager()->getRenderTable();
+	uint width = current->getWidth();
+	uint height = current->getHeight();
+
+	Graphics::Surface source, dest;
+	source.create(width, height, _engine->_resourcePixelFormat);
+	dest.create(width, height, _engine->_resourcePixelFormat);
+	for (uint y = 0; y < height; y++) {
+		uint16 *row = (uint16 *)source.getBasePtr(0, y);
+		for (uint x = 0; x < width; x++)
+			row[x] = (uint16)((x * 7) ^ (y * 13));
+	}
+
+	const Common::Rect dirtyRect(width / 2 - 32, height / 2 - 32, width / 2 + 32, height / 2 + 32);
+	debugPrintf("Warping %dx%d, %d frames\n", width, height, frames);
+
+	for (uint i = 0; i < ARRAYSIZE(states); i++) {
+		RenderTable table(width, height);
+		table.setRenderState(states[i]);
+		table.generateRenderTable();
+
+		for (int bilinear = 0; bilinear < 2; bilinear++) {
+			table.setBilinear(bilinear);
+
+			uint64 start = g_system->getMicros();
+			for (int frame = 0; frame < frames; frame++)
+				table.mutateImage(&dest, &source);
+			uint64 fullTime = g_system->getMicros() - start;
+
+			Common::Rect warpedRect = table.getWarpedRect(dirtyRect);
+			start = g_system->getMicros();
+			for (int frame = 0; frame < frames; frame++)
+				table.mutateImage(&dest, &source, warpedRect);
+			uint64 dirtyTime = g_system->getMicros() - start;
+
+			debugPrintf("%s%s: %d us per frame, %d us per 64x64 rect (warped to %dx%d)\n",
+			            stateNames[i], bilinear ? " bilinear" : "", (int)(fullTime / frames), (int)(dirtyTime / frames),
+			            warpedRect.width(), warpedRect.height());
+		}
+	}
+
+	source.free();
+	dest.free();
+	return true;
+}
+
 bool Console::cmdLocation(int argc, const char **argv) {
 	Location curLocation = _engine->getScriptManager()->getCurrentLocation();
 	Common::String scrFile = Common::String::format("%c%c%c%c.scr", curLocation.world, curLocation.room, curLocation.node, curLocation.view);
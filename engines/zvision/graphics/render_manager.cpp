@@ -116,9 +116,10 @@ void RenderManager::renderSceneToScreen() {
 	RenderTable::RenderState state = _renderTable.getRenderState();
 	if (state == RenderTable::PANORAMA || state == RenderTable::TILT) {
 		if (!_backgroundSurfaceDirtyRect.isEmpty()) {
-			_renderTable.mutateImage(&_warpedSceneSurface, in);
+			// Only warp again the part of the scene reading from the dirty rect
+			outWndDirtyRect = _renderTable.getWarpedRect(_backgroundSurfaceDirtyRect);
+			_renderTable.mutateImage(&_warpedSceneSurface, in, outWndDirtyRect);
 			out = &_warpedSceneSurface;
-			outWndDirtyRect = Common::Rect(_workingWindow.width(), _workingWindow.height());
 		}
 	} else {
 		out = in;
@@ -782,6 +783,8 @@ void RenderManager::addEffect(GraphicsEffect *_effect) {
 void RenderManager::deleteEffect(uint32 ID) {
 	for (EffectsList::iterator it = _effects.begin(); it != _effects.end(); it++) {
 		if ((*it)->getKey() == ID) {
+			// Redraw the area the effect covered
+			markDirty();
 			delete *it;
 			it = _effects.erase(it);
 		}
@@ -31,17 +31,32 @@ namespace ZVision {
 RenderTable::RenderTable(uint numColumns, uint numRows)
 	: _numRows(numRows),
 	  _numColumns(numColumns),
-	  _renderState(FLAT) {
+	  _renderState(FLAT),
+	  _bilinear(false),
+	  _tableChanged(true) {
 	assert(numRows != 0 && numColumns != 0);
 
-	_internalBuffer = new Common::Point[numRows * numColumns];
+	_sourceOffsets = new uint32[numRows * numColumns];
+	_sourceFractions = new uint16[numRows * numColumns];
+	_rowSpans = new SourceSpan[numRows];
+	_columnSpans = new SourceSpan[numColumns];
+
+	// No warping until a table is generated
+	resetSourceSpans();
+	for (uint y = 0; y < _numRows; y++) {
+		for (uint x = 0; x < _numColumns; x++)
+			setSource(x, y, x, y);
+	}
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
 }
 
 RenderTable::~RenderTable() {
-	delete[] _internalBuffer;
+	delete[] _sourceOffsets;
+	delete[] _sourceFractions;
+	delete[] _rowSpans;
+	delete[] _columnSpans;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -75,59 +90,155 @@ const Common::Point RenderTable::convertWarpedCoordToFlatCoord(const Common::Poi
 		return Common::Point(x, y);
 	}
 
-	uint32 index = point.y * _numColumns + point.x;
+	uint32 offset = _sourceOffsets[point.y * _numColumns + point.x];
+	return Common::Point(offset % _numColumns, offset / _numColumns);
+}
 
-	Common::Point newPoint(point);
-	newPoint.x += _internalBuffer[index].x;
-	newPoint.y += _internalBuffer[index].y;
+namespace {
 
-	return newPoint;
+/**
+ * Spread a 16-bit pixel over 32 bits, with the green channel in the high
+ * word, so that each channel has room for 5 bits of weight above it.
+ */
+inline uint32 expandPixel(uint16 color, uint32 mask) {
+	return (color | ((uint32)color << 16)) & mask;
 }
 
+/** Blend two expanded pixels, with a weight for the second one in 32ths */
+inline uint32 lerpExpanded(uint32 first, uint32 second, uint weight, uint32 mask) {
+	return ((first * (32 - weight) + second * weight) >> 5) & mask;
+}
+
+} // End of anonymous namespace
+
 void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect) {
 	uint32 destOffset = 0;
 
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
+		const uint32 *offsets = _sourceOffsets + y * _numColumns;
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-		}
+		for (int16 x = subRect.left; x < subRect.right; ++x)
+			destBuffer[destOffset + x - subRect.left] = sourceBuffer[offsets[x]];
 
 		destOffset += destWidth;
 	}
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
+	mutateImage(dstBuf, srcBuf, Common::Rect(_numColumns, _numRows));
+}
+
+void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf, const Common::Rect &dstRect) {
+	Common::Rect rect(dstRect);
+	rect.clip(Common::Rect(_numColumns, _numRows));
+	if (rect.isEmpty())
+		return;
+
+	if (rect.width() == (int16)_numColumns && rect.height() == (int16)_numRows)
+		_tableChanged = false;
+
+	uint32 blendMask = 0;
+	if (_bilinear) {
+		if (srcBuf->format == Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0))
+			blendMask = 0x03E07C1F;
+		else if (srcBuf->format == Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0))
+			blendMask = 0x07E0F81F;
+	}
+
+	const uint16 *sourceBuffer = (const uint16 *)srcBuf->getPixels();
 
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
-	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
+	for (int16 y = rect.top; y < rect.bottom; ++y) {
+		const uint32 *offsets = _sourceOffsets + y * _numColumns;
+		uint16 *destBuffer = (uint16 *)dstBuf->getBasePtr(0, y);
 
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+		if (!blendMask) {
+			// A plain gather, which the compiler can vectorize
+			for (int16 x = rect.left; x < rect.right; ++x)
+				destBuffer[x] = sourceBuffer[offsets[x]];
+			continue;
+		}
+
+		const uint16 *fractions = _sourceFractions + y * _numColumns;
+		for (int16 x = rect.left; x < rect.right; ++x) {
+			const uint16 *source = sourceBuffer + offsets[x];
+			uint fractionX = fractions[x] & 0xFF;
+			uint fractionY = fractions[x] >> 8;
+
+			// The fractions are zero on the last column and row, so nothing past them is read
+			uint32 nextX = fractionX ? 1 : 0;
+			uint32 nextY = fractionY ? _numColumns : 0;
+
+			uint32 top = lerpExpanded(expandPixel(source[0], blendMask), expandPixel(source[nextX], blendMask), fractionX, blendMask);
+			uint32 bottom = lerpExpanded(expandPixel(source[nextY], blendMask), expandPixel(source[nextY + nextX], blendMask), fractionX, blendMask);
+			uint32 color = lerpExpanded(top, bottom, fractionY, blendMask);
+			destBuffer[x] = (uint16)(color | (color >> 16));
+		}
+	}
+}
 
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+Common::Rect RenderTable::getWarpedRect(const Common::Rect &sourceRect) const {
+	if (_tableChanged)
+		return Common::Rect(_numColumns, _numRows);
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+	// A warped pixel can only read from sourceRect if both its row and its column do
+	int16 left = _numColumns, right = 0;
+	for (uint x = 0; x < _numColumns; ++x) {
+		if (_columnSpans[x].max >= sourceRect.left && _columnSpans[x].min < sourceRect.right) {
+			left = MIN<int16>(left, x);
+			right = x + 1;
+		}
+	}
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
+	int16 top = _numRows, bottom = 0;
+	for (uint y = 0; y < _numRows; ++y) {
+		if (_rowSpans[y].max >= sourceRect.top && _rowSpans[y].min < sourceRect.bottom) {
+			top = MIN<int16>(top, y);
+			bottom = y + 1;
 		}
 	}
+
+	if (left >= right || top >= bottom)
+		return Common::Rect();
+
+	return Common::Rect(left, top, right, bottom);
+}
+
+void RenderTable::setSource(uint x, uint y, float sourceX, float sourceY) {
+	float floorX = floor(sourceX);
+	float floorY = floor(sourceY);
+	int32 sx = CLIP<int32>((int32)floorX, 0, _numColumns - 1);
+	int32 sy = CLIP<int32>((int32)floorY, 0, _numRows - 1);
+
+	// Store the fractions in 32ths, for blending with the next pixels when there are some
+	uint16 fractionX = (sx == (int32)floorX && sx < (int32)_numColumns - 1) ? (uint16)((sourceX - floorX) * 32.0f) : 0;
+	uint16 fractionY = (sy == (int32)floorY && sy < (int32)_numRows - 1) ? (uint16)((sourceY - floorY) * 32.0f) : 0;
+
+	uint32 index = y * _numColumns + x;
+	_sourceOffsets[index] = sy * _numColumns + sx;
+	_sourceFractions[index] = fractionX | (fractionY << 8);
+
+	int16 maxX = sx + (fractionX ? 1 : 0);
+	int16 maxY = sy + (fractionY ? 1 : 0);
+	_columnSpans[x].min = MIN<int16>(_columnSpans[x].min, sx);
+	_columnSpans[x].max = MAX<int16>(_columnSpans[x].max, maxX);
+	_rowSpans[y].min = MIN<int16>(_rowSpans[y].min, sy);
+	_rowSpans[y].max = MAX<int16>(_rowSpans[y].max, maxY);
+}
+
+void RenderTable::resetSourceSpans() {
+	for (uint x = 0; x < _numColumns; ++x) {
+		_columnSpans[x].min = _numColumns;
+		_columnSpans[x].max = -1;
+	}
+	for (uint y = 0; y < _numRows; ++y) {
+		_rowSpans[y].min = _numRows;
+		_rowSpans[y].max = -1;
+	}
 }
 
 void RenderTable::generateRenderTable() {
+	_tableChanged = true;
+
 	switch (_renderState) {
 	case ZVision::RenderTable::PANORAMA:
 		generatePanoramaLookupTable();
@@ -144,13 +255,7 @@ void RenderTable::generateRenderTable() {
 }
 
 void RenderTable::generatePanoramaLookupTable() {
-	for (uint y = 0; y < _numRows; y++) {
-		for (uint x = 0; x < _numColumns; x++) {
-			uint32 index = y * _numColumns + x;
-			_internalBuffer[index].x = 0;
-			_internalBuffer[index].y = 0;
-		}
-	}
+	resetSourceSpans();
 
 	float halfWidth = (float)_numColumns / 2.0f;
 	float halfHeight = (float)_numRows / 2.0f;
@@ -165,25 +270,23 @@ void RenderTable::generatePanoramaLookupTable() {
 
 		// To get x in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _panoramaOptions.linearScale
-		int32 xInCylinderCoords = int32(floor((cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth));
+		float xInCylinderCoords = (cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth;
 
 		float cosAlpha = cos(alpha);
 
 		for (uint y = 0; y < _numRows; ++y) {
 			// To calculate y in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 yInCylinderCoords = int32(floor(halfHeight + ((float)y - halfHeight) * cosAlpha));
-
-			uint32 index = y * _numColumns + x;
+			float yInCylinderCoords = halfHeight + ((float)y - halfHeight) * cosAlpha;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSource(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
 
 void RenderTable::generateTiltLookupTable() {
+	resetSourceSpans();
+
 	float halfWidth = (float)_numColumns / 2.0f;
 	float halfHeight = (float)_numRows / 2.0f;
 
@@ -199,21 +302,16 @@ void RenderTable::generateTiltLookupTable() {
 
 		// To get y in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _tiltOptions.linearScale
-		int32 yInCylinderCoords = int32(floor((cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight));
+		float yInCylinderCoords = (cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight;
 
 		float cosAlpha = cos(alpha);
-		uint32 columnIndex = y * _numColumns;
 
 		for (uint x = 0; x < _numColumns; ++x) {
 			// To calculate x in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 xInCylinderCoords = int32(floor(halfWidth + ((float)x - halfWidth) * cosAlpha));
-
-			uint32 index = columnIndex + x;
+			float xInCylinderCoords = halfWidth + ((float)x - halfWidth) * cosAlpha;
 
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			setSource(x, y, xInCylinderCoords, yInCylinderCoords);
 		}
 	}
 }
@@ -41,9 +41,25 @@ public:
 	};
 
 private:
+	/** Range of source coordinates read by a row or a column of the table */
+	struct SourceSpan {
+		int16 min, max;
+	};
+
 	uint _numColumns, _numRows;
-	Common::Point *_internalBuffer;
+	/** Index in the source image of each pixel of the warped image */
+	uint32 *_sourceOffsets;
+	/**
+	 * Fractional part of the source coordinates of each pixel, in 32ths:
+	 * the x fraction is in the low byte, and the y fraction in the high byte
+	 */
+	uint16 *_sourceFractions;
+	SourceSpan *_rowSpans;
+	SourceSpan *_columnSpans;
 	RenderState _renderState;
+	bool _bilinear;
+	/** Set when the table changed since the whole image was last warped */
+	bool _tableChanged;
 
 	struct {
 		float fieldOfView;
@@ -68,8 +84,24 @@ public:
 
 	const Common::Point convertWarpedCoordToFlatCoord(const Common::Point &point);
 
+	uint getWidth() const { return _numColumns; }
+	uint getHeight() const { return _numRows; }
+
+	/** Blend the four source pixels around each warped pixel, instead of picking the nearest one */
+	void setBilinear(bool bilinear) { _bilinear = bilinear; }
+	bool getBilinear() const { return _bilinear; }
+
 	void mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect);
 	void mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf);
+	/** Warp the pixels of dstRect only, leaving the rest of dstBuf untouched */
+	void mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf, const Common::Rect &dstRect);
+
+	/**
+	 * Return the area of the warped image which reads from sourceRect, or
+	 * the whole image if the table changed since it was last warped.
+	 */
+	Common::Rect getWarpedRect(const Common::Rect &sourceRect) const;
+
 	void generateRenderTable();
 
 	void setPanoramaFoV(float fov);
@@ -90,6 +122,8 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+	void setSource(uint x, uint y, float sourceX, float sourceY);
+	void resetSourceSpans();
 };
 
 } // End of namespace ZVision
@@ -478,6 +478,15 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Sets up the renderer with the colors and settings of a draw step,
+	 * as drawStep() does, without drawing anything.
+	 *
+	 * This is used when the result of the step is already known, to leave
+	 * the renderer in the same state as if the step had been drawn.
+	 */
+	void applyStepSettings(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
@@ -426,8 +426,10 @@ namespace Graphics {
 /**
  * Fills several pixels in a row with a given color.
  *
- * This is a replacement function for Common::fill, using an unrolled
- * loop to maximize performance on most architectures.
+ * This is a replacement function for Common::fill, filling the row with
+ * 64-bit stores of several pixels at once. The fixed size memcpy() calls
+ * compile to single stores, which compilers can also merge into vector
+ * stores, and avoid aliasing the surface with another type.
  * This function may (and should) be overloaded in any child renderers
  * for portable platforms with platform-specific assembly code.
  *
@@ -441,23 +443,26 @@ namespace Graphics {
  */
 template<typename PixelType>
 void colorFill(PixelType *first, PixelType *last, PixelType color) {
-	int count = (last - first);
-	if (!count)
-		return;
-	int n = (count + 7) >> 3;
-	switch (count % 8) {
-	default:
-	case 0:	do {
-	       		*first++ = color; // fall through
-	case 7:		*first++ = color; // fall through
-	case 6:		*first++ = color; // fall through
-	case 5:		*first++ = color; // fall through
-	case 4:		*first++ = color; // fall through
-	case 3:		*first++ = color; // fall through
-	case 2:		*first++ = color; // fall through
-	case 1:		*first++ = color;
-	       	} while (--n > 0);
-	}
+	// Align the row on 8 bytes first. The pixels are always aligned on
+	// their own size, so this takes less than 8 bytes.
+	while (first < last && ((uintptr)first & 7))
+		*first++ = color;
+
+	uint64 pattern = color;
+	for (uint i = sizeof(PixelType); i < sizeof(pattern); i <<= 1)
+		pattern |= pattern << (i * 8);
+
+	const uint pixelsPerStore = sizeof(pattern) / sizeof(PixelType);
+	while (last - first >= (int)(4 * pixelsPerStore)) {
+		memcpy(first, &pattern, sizeof(pattern));
+		memcpy(first + pixelsPerStore, &pattern, sizeof(pattern));
+		memcpy(first + 2 * pixelsPerStore, &pattern, sizeof(pattern));
+		memcpy(first + 3 * pixelsPerStore, &pattern, sizeof(pattern));
+		first += 4 * pixelsPerStore;
+	}
+
+	while (first < last)
+		*first++ = color;
 }
 
 template<typename PixelType>
@@ -482,23 +487,10 @@ void colorFillClip(PixelType *first, PixelType *last, PixelType color, int realX
 		count -= diff;
 	}
 
-	if (!count)
+	if (count <= 0)
 		return;
 
-	int n = (count + 7) >> 3;
-	switch (count % 8) {
-	default:
-	case 0:	do {
-	       		*first++ = color; // fall through
-	case 7:		*first++ = color; // fall through
-	case 6:		*first++ = color; // fall through
-	case 5:		*first++ = color; // fall through
-	case 4:		*first++ = color; // fall through
-	case 3:		*first++ = color; // fall through
-	case 2:		*first++ = color; // fall through
-	case 1:		*first++ = color;
-	       	} while (--n > 0);
-	}
+	colorFill<PixelType>(first, first + count, color);
 }
 
 /**
@@ -681,16 +673,19 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
+		// The pattern only depends on the parity of the column
+		PixelType colors[2];
+		for (int oy = 0; oy < 2; oy++) {
 			if ((ox && oy) ||
 				((grad == 2 || grad == 3) && ox && !oy) ||
 				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
+				colors[oy] = _gradCache[curGrad + 1];
 			else
-				*ptr = _gradCache[curGrad];
+				colors[oy] = _gradCache[curGrad];
 		}
+
+		for (int j = x; j < x + width; j++, ptr++)
+			*ptr = colors[j & 1];
 	}
 }
 
@@ -723,17 +718,22 @@ gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY)
 	} else if (grad == 3 && ox) {
 		colorFillClip<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1], realX, realY, _clippingArea);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
+		// The pattern only depends on the parity of the column
+		PixelType colors[2];
+		for (int oy = 0; oy < 2; oy++) {
 			if ((ox && oy) ||
 				((grad == 2 || grad == 3) && ox && !oy) ||
 				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
+				colors[oy] = _gradCache[curGrad + 1];
 			else
-				*ptr = _gradCache[curGrad];
+				colors[oy] = _gradCache[curGrad];
 		}
+
+		int start = MAX<int>(x, x + _clippingArea.left - realX);
+		int end = MIN<int>(x + width, x + _clippingArea.right - realX);
+		ptr += start - x;
+		for (int j = start; j < end; j++, ptr++)
+			*ptr = colors[j & 1];
 	}
 }
 
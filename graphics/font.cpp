@@ -98,14 +98,41 @@ int getStringWidthImpl(const Font &font, const StringType &str) {
 	return space;
 }
 
+/** Number of characters drawString places without allocating memory */
+const uint kPlacedCharsOnStack = 256;
+
 template<class SurfaceType, class StringType>
 void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) {
 	// The logic in getBoundingImpl is the same as we use here. In case we
 	// ever change something here we will need to change it there too.
 	assert(dst != 0);
 
+	Font::PlacedChar stackChars[kPlacedCharsOnStack];
+	Common::Array<Font::PlacedChar> heapChars;
+	Font::PlacedChar *chars = stackChars;
+	if (str.size() > kPlacedCharsOnStack) {
+		heapChars.resize(str.size());
+		chars = heapChars.data();
+	}
+
+	// Place the characters first, which gives the width of the string
+	// without querying the kerning and the widths twice
+	int width = 0;
+	uint count = 0;
+	typename StringType::unsigned_type last = 0;
+	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
+		const typename StringType::unsigned_type cur = *i;
+		width += font.getKerningOffset(last, cur);
+		last = cur;
+
+		chars[count].chr = cur;
+		chars[count].x = width;
+		count++;
+
+		width += font.getCharWidth(cur);
+	}
+
 	const int leftX = x, rightX = x + w + 1;
-	int width = font.getStringWidth(str);
 
 	if (align == kTextAlignCenter)
 		x = x + (w - width)/2;
@@ -113,20 +140,21 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		x = x + w - width;
 	x += deltax;
 
-	typename StringType::unsigned_type last = 0;
-	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
-		const typename StringType::unsigned_type cur = *i;
-		x += font.getKerningOffset(last, cur);
-		last = cur;
-
-		Common::Rect charBox = font.getBoundingBox(cur);
-		if (x + charBox.right > rightX)
+	uint drawn = 0;
+	for (uint i = 0; i < count; i++) {
+		const int charX = x + chars[i].x;
+		Common::Rect charBox = font.getBoundingBox(chars[i].chr);
+		if (charX + charBox.right > rightX)
 			break;
-		if (x + charBox.right >= leftX)
-			font.drawChar(dst, cur, x, y, color);
-
-		x += font.getCharWidth(cur);
+		if (charX + charBox.right >= leftX) {
+			chars[drawn].chr = chars[i].chr;
+			chars[drawn].x = charX;
+			drawn++;
+		}
 	}
+
+	if (drawn)
+		font.drawChars(dst, chars, drawn, y, color);
 }
 
 template<class StringType>
@@ -454,6 +482,16 @@ void Font::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color)
 	dst->addDirtyRect(charBox);
 }
 
+void Font::drawChars(Surface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const {
+	for (uint i = 0; i < count; i++)
+		drawChar(dst, chars[i].chr, chars[i].x, y, color);
+}
+
+void Font::drawChars(ManagedSurface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const {
+	for (uint i = 0; i < count; i++)
+		drawChar(dst, chars[i].chr, chars[i].x, y, color);
+}
+
 void Font::drawString(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) const {
 	Common::String renderStr = useEllipsis ? handleEllipsis(*this, str, w) : str;
 	drawStringImpl(*this, dst, renderStr, x, y, w, color, align, deltax);
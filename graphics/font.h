@@ -190,6 +190,31 @@ public:
 	virtual void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const = 0;
 	virtual void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const;
 
+	/** A character placed on a line by drawString. */
+	struct PlacedChar {
+		uint32 chr; ///< The character.
+		int x;      ///< The x coordinate where to draw the character.
+	};
+
+	/**
+	 * Draw a line of characters placed by drawString.
+	 *
+	 * drawString computes the position of all characters of a string, with
+	 * the kerning, before drawing them with a single call to this function.
+	 * The default implementation calls drawChar for each character. Fonts
+	 * can override it to look up their glyphs and set up the drawing for the
+	 * surface format once per string.
+	 *
+	 * @param dst    The surface to draw on.
+	 * @param chars  The characters to draw.
+	 * @param count  The number of characters.
+	 * @param y      The y coordinate where to draw the characters.
+	 * @param color  The color of the characters.
+	 */
+	virtual void drawChars(Surface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const;
+	/** @overload */
+	virtual void drawChars(ManagedSurface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const;
+
 	/** @overload */
 
 	/**
@@ -162,6 +162,9 @@ public:
 	virtual void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const;
 	virtual void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const;
 
+	virtual void drawChars(Surface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const;
+	virtual void drawChars(ManagedSurface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const;
+
 private:
 	bool _initialized;
 	FT_Face _face;
@@ -190,7 +193,7 @@ private:
 	int computePointSize(int size, TTFSizeMode sizeMode) const;
 	int readPointSizeFromVDMXTable(int height) const;
 	int computePointSizeFromHeaders(int height) const;
-	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color,
+	Common::Rect drawChars(Surface *dst, const PlacedChar *chars, uint count, int y, uint32 color,
 		const uint32 *transparentColor) const;
 
 	FT_Int32 _loadFlags;
@@ -605,12 +608,18 @@ Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
 
 namespace {
 
+/** The color of a string, converted once for all its glyphs */
+struct GlyphColor {
+	uint32 color;
+	uint8 r, g, b;
+	bool opaqueFormat; ///< The destination has no alpha channel
+};
+
 template<typename ColorType>
-static void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
-		const int srcPitch, const int w, const int h, ColorType color,
+void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
+		const int srcPitch, const int w, const int h, const GlyphColor &color,
 		const PixelFormat &dstFormat, const uint32 *transparentColor) {
-	uint8 sA, sR, sG, sB;
-	dstFormat.colorToRGB(color, sR, sG, sB);
+	const ColorType fullColor = (ColorType)color.color;
 
 	for (int y = 0; y < h; ++y) {
 		ColorType *rDst = (ColorType *)dstPos;
@@ -618,9 +627,20 @@ static void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
 
 		for (int x = 0; x < w; ++x) {
 			if (*src == 255) {
-				*rDst = color;
+				*rDst = fullColor;
+			} else if (*src && color.opaqueFormat && !(transparentColor && *rDst == *transparentColor)) {
+				// Blending over an opaque pixel only needs integer math
+				const uint sA = *src;
+				uint8 dR, dG, dB;
+				dstFormat.colorToRGB(*rDst, dR, dG, dB);
+
+				dR = (color.r * sA + dR * (255 - sA)) / 255;
+				dG = (color.g * sA + dG * (255 - sA)) / 255;
+				dB = (color.b * sA + dB * (255 - sA)) / 255;
+
+				*rDst = dstFormat.RGBToColor(dR, dG, dB);
 			} else if (*src) {
-				sA = *src;
+				const uint8 sA = *src;
 
 				uint8 dA, dR, dG, dB;
 				if (transparentColor && *rDst == *transparentColor) {
@@ -633,9 +653,9 @@ static void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
 				double dAn = (double)dA / 255.0;
 				double oAn = sAn + dAn * (1.0 - sAn);
 
-				dR = static_cast<uint8>(sR * sAn + dR * dAn * (1.0 - sAn) / oAn);
-				dG = static_cast<uint8>(sG * sAn + dG * dAn * (1.0 - sAn) / oAn);
-				dB = static_cast<uint8>(sB * sAn + dB * dAn * (1.0 - sAn) / oAn);
+				dR = static_cast<uint8>(color.r * sAn + dR * dAn * (1.0 - sAn) / oAn);
+				dG = static_cast<uint8>(color.g * sAn + dG * dAn * (1.0 - sAn) / oAn);
+				dB = static_cast<uint8>(color.b * sAn + dB * dAn * (1.0 - sAn) / oAn);
 				dA = static_cast<uint8>(oAn * 255.0);
 
 				*rDst = dstFormat.ARGBToColor(dA, dR, dG, dB);
@@ -653,94 +673,123 @@ static void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	drawChar(dst, chr, x, y, color, nullptr);
+	PlacedChar placed = { chr, x };
+	drawChars(dst, &placed, 1, y, color, nullptr);
 }
 
 void TTFFont::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const {
+	PlacedChar placed = { chr, x };
+	drawChars(dst, &placed, 1, y, color);
+}
+
+void TTFFont::drawChars(Surface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const {
+	drawChars(dst, chars, count, y, color, nullptr);
+}
+
+void TTFFont::drawChars(ManagedSurface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const {
+	Common::Rect dirty;
 	if (dst->hasTransparentColor()) {
 		uint32 transColor = dst->getTransparentColor();
-		drawChar(dst->surfacePtr(), chr, x, y, color, &transColor);
+		dirty = drawChars(dst->surfacePtr(), chars, count, y, color, &transColor);
 	} else {
-		drawChar(dst->surfacePtr(), chr, x, y, color, nullptr);
+		dirty = drawChars(dst->surfacePtr(), chars, count, y, color, nullptr);
 	}
 
-	Common::Rect charBox = getBoundingBox(chr);
-	charBox.translate(x, y);
-	dst->addDirtyRect(charBox);
+	if (!dirty.isEmpty())
+		dst->addDirtyRect(dirty);
 }
 
-void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
+Common::Rect TTFFont::drawChars(Surface *dst, const PlacedChar *chars, uint count, int y, uint32 color,
 		const uint32 *transparentColor) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return;
+	GlyphColor glyphColor;
+	glyphColor.color = color;
+	glyphColor.opaqueFormat = (dst->format.aBits() == 0);
+	if (dst->format.bytesPerPixel != 1)
+		dst->format.colorToRGB(color, glyphColor.r, glyphColor.g, glyphColor.b);
+
+	Common::Rect drawnArea;
+
+	for (uint i = 0; i < count; i++) {
+		assureCached(chars[i].chr);
+		GlyphCache::const_iterator glyphEntry = _glyphs.find(chars[i].chr);
+		if (glyphEntry == _glyphs.end())
+			continue;
 
-	const Glyph &glyph = glyphEntry->_value;
+		const Glyph &glyph = glyphEntry->_value;
 
-	x += glyph.xOffset;
-	y += glyph.yOffset;
+		int x = chars[i].x + glyph.xOffset;
+		int glyphY = y + glyph.yOffset;
 
-	if (x > dst->w)
-		return;
-	if (y > dst->h)
-		return;
+		// The dirty area covers the whole glyphs, like getBoundingBox() does
+		Common::Rect glyphBox(x, glyphY, x + glyph.image.w, glyphY + glyph.image.h);
+		if (drawnArea.isEmpty())
+			drawnArea = glyphBox;
+		else
+			drawnArea.extend(glyphBox);
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+		if (x > dst->w)
+			continue;
+		if (glyphY > dst->h)
+			continue;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+		int w = glyph.image.w;
+		int h = glyph.image.h;
 
-	// Make sure we are not drawing outside the screen bounds
-	if (x < 0) {
-		srcPos -= x;
-		w += x;
-		x = 0;
-	}
+		const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
 
-	if (x + w > dst->w)
-		w = dst->w - x;
+		// Make sure we are not drawing outside the screen bounds
+		if (x < 0) {
+			srcPos -= x;
+			w += x;
+			x = 0;
+		}
 
-	if (w <= 0)
-		return;
+		if (x + w > dst->w)
+			w = dst->w - x;
 
-	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
-		h += y;
-		y = 0;
-	}
+		if (w <= 0)
+			continue;
+
+		if (glyphY < 0) {
+			srcPos -= glyphY * glyph.image.pitch;
+			h += glyphY;
+			glyphY = 0;
+		}
 
-	if (y + h > dst->h)
-		h = dst->h - y;
+		if (glyphY + h > dst->h)
+			h = dst->h - glyphY;
 
-	if (h <= 0)
-		return;
+		if (h <= 0)
+			continue;
 
-	uint8 *dstPos = (uint8 *)dst->getBasePtr(x, y);
+		uint8 *dstPos = (uint8 *)dst->getBasePtr(x, glyphY);
 
-	if (dst->format.bytesPerPixel == 1) {
-		for (int cy = 0; cy < h; ++cy) {
-			uint8 *rDst = dstPos;
-			const uint8 *src = srcPos;
+		if (dst->format.bytesPerPixel == 1) {
+			for (int cy = 0; cy < h; ++cy) {
+				uint8 *rDst = dstPos;
+				const uint8 *src = srcPos;
 
-			for (int cx = 0; cx < w; ++cx) {
-				// We assume a 1Bpp mode is a color indexed mode, thus we can
-				// not take advantage of anti-aliasing here.
-				if (*src >= 0x80)
-					*rDst = color;
+				for (int cx = 0; cx < w; ++cx) {
+					// We assume a 1Bpp mode is a color indexed mode, thus we can
+					// not take advantage of anti-aliasing here.
+					if (*src >= 0x80)
+						*rDst = color;
 
-				++rDst;
-				++src;
-			}
+					++rDst;
+					++src;
+				}
 
-			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+				dstPos += dst->pitch;
+				srcPos += glyph.image.pitch;
+			}
+		} else if (dst->format.bytesPerPixel == 2) {
+			renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, glyphColor, dst->format, transparentColor);
+		} else if (dst->format.bytesPerPixel == 4) {
+			renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, glyphColor, dst->format, transparentColor);
 		}
-	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
-	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
 	}
+
+	return drawnArea;
 }
 
 bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
@@ -37,7 +37,10 @@ namespace Graphics {
 enum {
 	kConScrollStep = 12,
 
-	kCursorMaxHeight = 100
+	kCursorMaxHeight = 100,
+
+	// Rows of text kept rendered, taller texts are rendered around the drawn area
+	kMaxSurfaceHeight = 2048
 };
 
 static void cursorTimerHandler(void *refCon);
@@ -187,6 +190,8 @@ void MacText::init() {
 	_textMaxHeight = 0;
 	_surface = nullptr;
 	_shadowSurface = nullptr;
+	_surfaceTop = 0;
+	_hasPendingLines = false;
 
 	if (!_fixedDims) {
 		int right = _dims.right;
@@ -841,18 +846,28 @@ void MacText::reallocSurface() {
 	//TODO: work out why this rounding doesn't correctly fill the entire width
 	//int requiredH = (_text.size() + (_text.size() * 10 + 9) / 10) * lineH
 
+	// Long texts are only rendered around the drawn area
+	int height = MIN<int>(_textMaxHeight, kMaxSurfaceHeight);
+
 	if (!_surface) {
-		_surface = new ManagedSurface(_maxWidth, _textMaxHeight, _wm->_pixelformat);
+		_surface = new ManagedSurface(_maxWidth, height, _wm->_pixelformat);
 
 		if (_textShadow)
-			_shadowSurface = new ManagedSurface(_maxWidth, _textMaxHeight, _wm->_pixelformat);
+			_shadowSurface = new ManagedSurface(_maxWidth, height, _wm->_pixelformat);
 
+		_surfaceTop = 0;
 		return;
 	}
 
-	if (_surface->w < _maxWidth || _surface->h < _textMaxHeight) {
+	if (_surface->w < _maxWidth || _surface->h < height) {
+		// Text is usually appended line by line, so leave room for more lines
+		// instead of copying the whole surface for each of them
+		if (_surface->h < height)
+			height = MIN<int>(MAX(height, _surface->h + _surface->h / 2), kMaxSurfaceHeight);
+		height = MAX<int>(height, _surface->h);
+
 		// realloc surface and copy old content
-		ManagedSurface *n = new ManagedSurface(_maxWidth, _textMaxHeight, _wm->_pixelformat);
+		ManagedSurface *n = new ManagedSurface(_maxWidth, height, _wm->_pixelformat);
 		n->clear(_bgcolor);
 		n->blitFrom(*_surface, Common::Point(0, 0));
 
@@ -861,7 +876,7 @@ void MacText::reallocSurface() {
 
 		// same as shadow surface
 		if (_textShadow) {
-			ManagedSurface *newShadowSurface = new ManagedSurface(_maxWidth, _textMaxHeight, _wm->_pixelformat);
+			ManagedSurface *newShadowSurface = new ManagedSurface(_maxWidth, height, _wm->_pixelformat);
 			newShadowSurface->clear(_bgcolor);
 			newShadowSurface->blitFrom(*_shadowSurface, Common::Point(0, 0));
 
@@ -871,18 +886,139 @@ void MacText::reallocSurface() {
 	}
 }
 
+Common::Rect MacText::getSurfaceArea(int top, int bottom) const {
+	return Common::Rect(0, CLIP<int>(top - _surfaceTop, 0, _surface->h), _surface->w, CLIP<int>(bottom - _surfaceTop, 0, _surface->h));
+}
+
+void MacText::moveSurface(int top, int bottom) {
+	int height = MAX<int>(bottom - top, MIN<int>(_textMaxHeight, kMaxSurfaceHeight));
+
+	// Cover as much text as possible, the next draws being usually nearby
+	_surfaceTop = MAX(0, MIN(top, _textMaxHeight - height));
+
+	if (_surface->w < _maxWidth || _surface->h < height) {
+		int width = MAX<int>(_surface->w, _maxWidth);
+
+		delete _surface;
+		_surface = new ManagedSurface(width, height, _wm->_pixelformat);
+
+		if (_textShadow) {
+			delete _shadowSurface;
+			_shadowSurface = new ManagedSurface(width, height, _wm->_pixelformat);
+		}
+	}
+
+	_surface->clear(_bgcolor);
+	if (_textShadow)
+		_shadowSurface->clear(_bgcolor);
+
+	for (uint i = 0; i < _textLines.size(); i++)
+		_textLines[i].renderPending = true;
+
+	_hasPendingLines = true;
+}
+
 void MacText::render() {
 	if (_fullRefresh) {
 		_surface->clear(_bgcolor);
 		if (_textShadow)
 			_shadowSurface->clear(_bgcolor);
 
-		render(0, _textLines.size());
+		// The lines are rendered when they are drawn
+		invalidateLines(0, _textLines.size() - 1);
 
 		_fullRefresh = false;
 	}
 }
 
+Graphics::ManagedSurface *MacText::getSurface() {
+	if (_surface)
+		renderPendingLines(_surfaceTop, _surfaceTop + _surface->h);
+
+	return _surface;
+}
+
+void MacText::invalidateLines(int from, int to) {
+	if (_textLines.empty())
+		return;
+
+	reallocSurface();
+
+	from = MAX<int>(0, from);
+	to = MIN<int>(to, _textLines.size() - 1);
+
+	if (from > to)
+		return;
+
+	int bottom = (to == (int)_textLines.size() - 1) ? _surfaceTop + _surface->h : _textLines[to + 1].y;
+	Common::Rect area = getSurfaceArea(_textLines[from].y, bottom);
+
+	_surface->fillRect(area, _bgcolor);
+	if (_textShadow)
+		_shadowSurface->fillRect(area, _bgcolor);
+
+	for (int i = from; i <= to; i++)
+		_textLines[i].renderPending = true;
+
+	_hasPendingLines = true;
+}
+
+void MacText::renderPendingLines(int top, int bottom) {
+	if (_textLines.empty())
+		return;
+
+	reallocSurface();
+
+	top = MAX(top, 0);
+	bottom = MIN(bottom, _textMaxHeight);
+	if (top >= bottom)
+		return;
+
+	if (top < _surfaceTop || bottom > _surfaceTop + _surface->h)
+		moveSurface(top, bottom);
+
+	if (!_hasPendingLines)
+		return;
+
+	// Find the first visible line, the lines being sorted by position
+	int first = 0;
+	int last = _textLines.size() - 1;
+	while (first < last) {
+		int mid = (first + last + 1) / 2;
+		if (_textLines[mid].y <= top)
+			first = mid;
+		else
+			last = mid - 1;
+	}
+
+	for (int i = first; i < (int)_textLines.size() && _textLines[i].y < bottom; i++) {
+		if (!_textLines[i].renderPending)
+			continue;
+
+		int end = i;
+		while (end + 1 < (int)_textLines.size() && _textLines[end + 1].renderPending && _textLines[end + 1].y < bottom)
+			end++;
+
+		render(i, end);
+		i = end;
+	}
+
+	if (top <= _surfaceTop && bottom >= MIN(_textMaxHeight, _surfaceTop + _surface->h))
+		_hasPendingLines = false;
+}
+
+void MacText::updateLines(int from, int to, uint oldLineCount) {
+	int oldHeight = _textMaxHeight;
+
+	recalcDims(from, to);
+
+	// The following lines did not move if the text kept its height
+	if (_textLines.size() == oldLineCount && _textMaxHeight == oldHeight)
+		invalidateLines(from, to);
+	else
+		invalidateLines(from, _textLines.size() - 1);
+}
+
 void MacText::render(int from, int to, int shadow) {
 	int w = MIN(_maxWidth, _textMaxWidth);
 	ManagedSurface *surface = shadow ? _shadowSurface : _surface;
@@ -899,10 +1035,11 @@ void MacText::render(int from, int to, int shadow) {
 
 		// TODO: _textMaxWidth, when -1, was not rendering ANY text.
 		for (uint j = 0; j < _textLines[i].chunks.size(); j++) {
-			debug(9, "MacText::render: line %d[%d] h:%d at %d,%d (%s) fontid: %d on %dx%d, fgcolor: %d bgcolor: %d, font: %p",
-				  i, j, _textLines[i].height, xOffset, _textLines[i].y, _textLines[i].chunks[j].text.encode().c_str(),
-				  _textLines[i].chunks[j].fontId, _surface->w, _surface->h, _textLines[i].chunks[j].fgcolor, _bgcolor,
-				  (const void *)_textLines[i].chunks[j].getFont());
+			if (debugLevelSet(9))
+				debug(9, "MacText::render: line %d[%d] h:%d at %d,%d (%s) fontid: %d on %dx%d, fgcolor: %d bgcolor: %d, font: %p",
+					i, j, _textLines[i].height, xOffset, _textLines[i].y, _textLines[i].chunks[j].text.encode().c_str(),
+					_textLines[i].chunks[j].fontId, _surface->w, _surface->h, _textLines[i].chunks[j].fgcolor, _bgcolor,
+					(const void *)_textLines[i].chunks[j].getFont());
 
 			if (_textLines[i].chunks[j].text.empty())
 				continue;
@@ -914,10 +1051,10 @@ void MacText::render(int from, int to, int shadow) {
 
 			if (_textLines[i].chunks[j].plainByteMode()) {
 				Common::String str = _textLines[i].chunks[j].getEncodedText();
-				_textLines[i].chunks[j].getFont()->drawString(surface, str, xOffset, _textLines[i].y + yOffset, w, shadow ? _wm->_colorBlack : _textLines[i].chunks[j].fgcolor, Graphics::kTextAlignLeft, 0, true);
+				_textLines[i].chunks[j].getFont()->drawString(surface, str, xOffset, _textLines[i].y - _surfaceTop + yOffset, w, shadow ? _wm->_colorBlack : _textLines[i].chunks[j].fgcolor, Graphics::kTextAlignLeft, 0, true);
 				xOffset += _textLines[i].chunks[j].getFont()->getStringWidth(str);
 			} else {
-				_textLines[i].chunks[j].getFont()->drawString(surface, convertBiDiU32String(_textLines[i].chunks[j].text), xOffset, _textLines[i].y + yOffset, w, shadow ? _wm->_colorBlack : _textLines[i].chunks[j].fgcolor, Graphics::kTextAlignLeft, 0, true);
+				_textLines[i].chunks[j].getFont()->drawString(surface, convertBiDiU32String(_textLines[i].chunks[j].text), xOffset, _textLines[i].y - _surfaceTop + yOffset, w, shadow ? _wm->_colorBlack : _textLines[i].chunks[j].fgcolor, Graphics::kTextAlignLeft, 0, true);
 				xOffset += _textLines[i].chunks[j].getFont()->getStringWidth(_textLines[i].chunks[j].text);
 			}
 		}
@@ -934,7 +1071,7 @@ void MacText::render(int from, int to) {
 	to = MIN<int>(to, _textLines.size() - 1);
 
 	// Clear the screen
-	_surface->fillRect(Common::Rect(0, _textLines[from].y, _surface->w, _textLines[to].y + getLineHeight(to)), _bgcolor);
+	_surface->fillRect(getSurfaceArea(_textLines[from].y, _textLines[to].y + getLineHeight(to)), _bgcolor);
 
 	// render the shadow surface;
 	if (_textShadow)
@@ -942,6 +1079,13 @@ void MacText::render(int from, int to) {
 
 	render(from, to, 0);
 
+	for (int i = from; i <= to; i++)
+		_textLines[i].renderPending = false;
+
+	// Dumping the whole text for each rendered line is too slow for long texts
+	if (!debugLevelSet(9))
+		return;
+
 	for (uint i = 0; i < _textLines.size(); i++) {
 		debugN(9, "MacText::render: %2d ", i);
 
@@ -1045,18 +1189,30 @@ void MacText::setInterLinear(int interLinear) {
 }
 
 void MacText::recalcDims() {
+	recalcDims(0, _textLines.size() - 1);
+}
+
+void MacText::recalcDims(int from, int to) {
 	if (_textLines.empty())
 		return;
 
-	int y = 0;
+	from = CLIP<int>(from, 0, _textLines.size() - 1);
+	to = CLIP<int>(to, from, _textLines.size() - 1);
+
 	_textMaxWidth = 0;
 
-	for (uint i = 0; i < _textLines.size(); i++) {
+	// The lines before are unchanged, so their cached dimensions are valid
+	for (int i = 0; i < from; i++)
+		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i));
+
+	int y = from ? _textLines[from - 1].y + MAX(getLineHeight(from - 1), _interLinear) : 0;
+
+	for (uint i = from; i < _textLines.size(); i++) {
 		_textLines[i].y = y;
 
 		// We must calculate width first, because it enforces
 		// the computation. Calling Height() will return cached value!
-		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, true));
+		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, (int)i <= to));
 		y += MAX(getLineHeight(i), _interLinear);
 	}
 
@@ -1204,9 +1360,9 @@ void MacText::appendText(const Common::U32String &str, const Font *font, uint16
 
 void MacText::appendText_(const Common::U32String &strWithFont, uint oldLen) {
 	splitString(strWithFont);
-	recalcDims();
+	recalcDims(oldLen - 1, _textLines.size() - 1);
 
-	render(oldLen - 1, _textLines.size());
+	invalidateLines(oldLen - 1, _textLines.size() - 1);
 
 	_contentIsDirty = true;
 
@@ -1230,9 +1386,9 @@ void MacText::appendTextDefault(const Common::U32String &str, bool skipAdd) {
 		_str += strWithFont;
 	}
 	splitString(strWithFont);
-	recalcDims();
+	recalcDims(oldLen - 1, _textLines.size() - 1);
 
-	render(oldLen - 1, _textLines.size());
+	invalidateLines(oldLen - 1, _textLines.size() - 1);
 }
 
 void MacText::appendTextDefault(const Common::String &str, bool skipAdd) {
@@ -1242,10 +1398,12 @@ void MacText::appendTextDefault(const Common::String &str, bool skipAdd) {
 void MacText::clearText() {
 	_contentIsDirty = true;
 	_textLines.clear();
+	_hasPendingLines = false;
 	_str.clear();
 
 	if (_surface)
 		_surface->clear(_bgcolor);
+	_surfaceTop = 0;
 
 	recalcDims();
 
@@ -1259,7 +1417,7 @@ void MacText::removeLastLine() {
 
 	int h = getLineHeight(_textLines.size() - 1) + _interLinear;
 
-	_surface->fillRect(Common::Rect(0, _textMaxHeight - h, _surface->w, _textMaxHeight), _bgcolor);
+	_surface->fillRect(getSurfaceArea(_textMaxHeight - h, _textMaxHeight), _bgcolor);
 
 	_textLines.pop_back();
 	_textMaxHeight -= h;
@@ -1271,14 +1429,25 @@ void MacText::draw(ManagedSurface *g, int x, int y, int w, int h, int xoff, int
 
 	render();
 
-	if (x + w < _surface->w || y + h < _surface->h)
-		g->fillRect(Common::Rect(x + xoff, y + yoff, x + w + xoff, y + h + yoff), _bgcolor);
+	// Only the rows landing on the target are rendered
+	int bottom = y + MAX(0, MIN(h, g->h - yoff));
+	renderPendingLines(y, bottom);
+
+	if (x + w < _surface->w || y + h < _textMaxHeight) {
+		// Clipped first, as long texts are taller than a Rect can hold
+		Common::Rect area(MIN<int>(x + xoff, g->w), MIN<int>(y + yoff, g->h), MIN<int>(x + w + xoff, g->w), MIN<int>(y + h + yoff, g->h));
+		g->fillRect(area, _bgcolor);
+	}
+
+	Common::Rect srcRect = getSurfaceArea(y, MIN(MIN(y + h, bottom), _textMaxHeight));
+	srcRect.left = MIN<int>(_surface->w, x);
+	srcRect.right = MIN<int>(_surface->w, x + w);
 
 	// blit shadow surface first
 	if (_textShadow)
-		g->blitFrom(*_shadowSurface, Common::Rect(MIN<int>(_surface->w, x), MIN<int>(_surface->h, y), MIN<int>(_surface->w, x + w), MIN<int>(_surface->h, y + h)), Common::Point(xoff + _textShadow, yoff + _textShadow));
+		g->blitFrom(*_shadowSurface, srcRect, Common::Point(xoff + _textShadow, yoff + _textShadow));
 
-	g->transBlitFrom(*_surface, Common::Rect(MIN<int>(_surface->w, x), MIN<int>(_surface->h, y), MIN<int>(_surface->w, x + w), MIN<int>(_surface->h, y + h)), Common::Point(xoff, yoff), _bgcolor);
+	g->transBlitFrom(*_surface, srcRect, Common::Point(xoff, yoff), _bgcolor);
 
 	_contentIsDirty = false;
 	_cursorDirty = false;
@@ -1349,11 +1518,15 @@ void MacText::drawToPoint(ManagedSurface *g, Common::Rect srcRect, Common::Point
 
 	render();
 
-	srcRect.clip(_surface->getBounds());
+	// The text may be taller than a Rect can hold
+	srcRect.clip(Common::Rect(_surface->w, MIN<int>(_textMaxHeight, srcRect.bottom)));
 
 	if (srcRect.isEmpty())
 		return;
 
+	renderPendingLines(srcRect.top, srcRect.bottom);
+
+	srcRect.translate(0, -_surfaceTop);
 	g->blitFrom(*_surface, srcRect, dstPoint);
 }
 
@@ -1361,9 +1534,7 @@ void MacText::drawToPoint(ManagedSurface *g, Common::Point dstPoint) {
 	if (_textLines.empty())
 		return;
 
-	render();
-
-	g->blitFrom(*_surface, dstPoint);
+	drawToPoint(g, Common::Rect(_surface->w, MIN<int>(_textMaxHeight, g->h)), dstPoint);
 }
 
 // Count newline characters in String
@@ -2269,14 +2440,14 @@ void MacText::insertChar(byte c, int *row, int *col) {
 
 	(*col)++;
 
+	uint oldLineCount = _textLines.size();
+
 	if (getLineWidth(*row) - oldw + chunkw > _maxWidth) { // Needs reshuffle
-		reshuffleParagraph(row, col);
-		_fullRefresh = true;
-		recalcDims();
-		render();
+		int startRow, endRow;
+		reshuffleParagraph(row, col, &startRow, &endRow);
+		updateLines(startRow, endRow, oldLineCount);
 	} else {
-		recalcDims();
-		render(*row, *row);
+		updateLines(*row, *row, oldLineCount);
 	}
 	for (int i = 0; i < (int)_textLines.size(); i++) {
 		D(9, "**insertChar line %d isEnd %d", i, _textLines[i].paragraphEnd);
@@ -2303,6 +2474,7 @@ void MacText::deleteSelection() {
 	}
 
 	int row = s.endRow, col = s.endCol;
+	uint oldLineCount = _textLines.size();
 
 	while (row != s.startRow || col != s.startCol) {
 		if (row == 0 && col == 0)
@@ -2310,11 +2482,9 @@ void MacText::deleteSelection() {
 		deletePreviousCharInternal(&row, &col);
 	}
 
-	reshuffleParagraph(&row, &col);
-
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	int startRow, endRow;
+	reshuffleParagraph(&row, &col, &startRow, &endRow);
+	updateLines(startRow, endRow, oldLineCount);
 
 	// update cursor position
 	_cursorRow = row;
@@ -2360,6 +2530,8 @@ void MacText::deletePreviousCharInternal(int *row, int *col) {
 void MacText::deletePreviousChar(int *row, int *col) {
 	if (*col == 0 && *row == 0) // nothing to do
 		return;
+
+	uint oldLineCount = _textLines.size();
 	deletePreviousCharInternal(row, col);
 
 	for (int i = 0; i < (int)_textLines.size(); i++) {
@@ -2370,11 +2542,9 @@ void MacText::deletePreviousChar(int *row, int *col) {
 	}
 	D(9, "**deleteChar cursor row %d col %d", _cursorRow, _cursorCol);
 
-	reshuffleParagraph(row, col);
-
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	int startRow, endRow;
+	reshuffleParagraph(row, col, &startRow, &endRow);
+	updateLines(startRow, endRow, oldLineCount);
 }
 
 void MacText::addNewLine(int *row, int *col) {
@@ -2409,12 +2579,16 @@ void MacText::addNewLine(int *row, int *col) {
 
 	_textLines[*row].width = -1; // flush the cache
 
+	uint oldLineCount = _textLines.size();
+	int splitRow = *row;
+
 	_textLines.insert_at(*row + 1, newline);
 
 	(*row)++;
 	*col = 0;
 
-	reshuffleParagraph(row, col);
+	int startRow, endRow;
+	reshuffleParagraph(row, col, &startRow, &endRow);
 
 	for (int i = 0; i < (int)_textLines.size(); i++) {
 		D(9, "** addNewLine line %d", i);
@@ -2424,12 +2598,11 @@ void MacText::addNewLine(int *row, int *col) {
 	}
 	D(9, "** addNewLine cursor row %d col %d", _cursorRow, _cursorCol);
 
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	// The split line ends the previous paragraph now
+	updateLines(MIN(splitRow, startRow), endRow, oldLineCount);
 }
 
-void MacText::reshuffleParagraph(int *row, int *col) {
+void MacText::reshuffleParagraph(int *row, int *col, int *startRow, int *endRow) {
 	// First, we looking for the paragraph start and end
 	int start = *row, end = *row;
 
@@ -2455,10 +2628,17 @@ void MacText::reshuffleParagraph(int *row, int *col) {
 		_textLines.remove_at(start);
 	}
 
+	uint otherLines = _textLines.size();
+
 	// And now read it
 	D(9, "start %d end %d", start, end);
 	splitString(paragraph, start);
 
+	if (startRow)
+		*startRow = start;
+	if (endRow)
+		*endRow = start + (int)(_textLines.size() - otherLines) - 1;
+
 	// Find new pos within paragraph after reshuffling
 	*row = start;
 
@@ -106,6 +106,7 @@ struct MacTextLine {
 	int y;
 	int charwidth;
 	bool paragraphEnd;
+	bool renderPending;
 
 	Common::Array<MacFontRun> chunks;
 
@@ -113,6 +114,7 @@ struct MacTextLine {
 		width = height = charwidth = -1;
 		y = 0;
 		paragraphEnd = false;
+		renderPending = false;
 	}
 
 	MacFontRun &firstChunk() { return chunks[0]; }
@@ -171,7 +173,12 @@ public:
 	void drawToPoint(ManagedSurface *g, Common::Rect srcRect, Common::Point dstPoint);
 	void drawToPoint(ManagedSurface *g, Common::Point dstPoint);
 
-	Graphics::ManagedSurface *getSurface() { return _surface; }
+	/**
+	 * Return the rendered text. Texts taller than the surface are only
+	 * rendered around the area drawn last, from getSurfaceTop().
+	 */
+	Graphics::ManagedSurface *getSurface();
+	int getSurfaceTop() { return _surfaceTop; }
 	int getInterLinear() { return _interLinear; }
 	void setInterLinear(int interLinear);
 	void setMaxWidth(int maxWidth);
@@ -295,17 +302,46 @@ private:
 	/**
 	 * Rewraps paragraph containing given text row.
 	 * When text is modified, we redo whole thing again without touching
-	 * other paragraphs. Also, cursor position is returned in the arguments
+	 * other paragraphs. Also, cursor position is returned in the arguments,
+	 * and the rows of the rewrapped paragraph in startRow and endRow
 	 */
-	void reshuffleParagraph(int *row, int *col);
+	void reshuffleParagraph(int *row, int *col, int *startRow = nullptr, int *endRow = nullptr);
 
 	void chopChunk(const Common::U32String &str, int *curLine);
 	void splitString(const Common::U32String &str, int curLine = -1);
 	void render(int from, int to, int shadow);
 	void render(int from, int to);
 	void recalcDims();
+
+	/**
+	 * Recalculate the dimensions after the lines from @p from to @p to
+	 * were modified. Lines before them are kept, lines after them may only
+	 * have moved.
+	 */
+	void recalcDims(int from, int to);
 	void reallocSurface();
 
+	/** Return the area of the surface showing the text from @p top to @p bottom. */
+	Common::Rect getSurfaceArea(int top, int bottom) const;
+
+	/** Move the surface to cover the text from @p top to @p bottom, and render it again. */
+	void moveSurface(int top, int bottom);
+
+	/**
+	 * Clear the given lines, which are rendered again the next time they
+	 * are drawn. Clearing the last line also clears the surface below it.
+	 */
+	void invalidateLines(int from, int to);
+
+	/** Render the invalidated lines visible between @p top and @p bottom. */
+	void renderPendingLines(int top, int bottom);
+
+	/**
+	 * Lay out again the lines from @p from to @p to after an edit, and
+	 * invalidate all the lines which changed or moved.
+	 */
+	void updateLines(int from, int to, uint oldLineCount);
+
 	void scroll(int delta);
 
 	void drawSelection(int xoff, int yoff);
@@ -346,10 +382,12 @@ protected:
 
 	ManagedSurface *_surface;
 	ManagedSurface *_shadowSurface;
+	int _surfaceTop;
 
 	TextAlign _textAlignment;
 
 	Common::Array<MacTextLine> _textLines;
+	bool _hasPendingLines;
 	MacFontRun _defaultFormatting;
 	MacFontRun _currentFormatting;
 
@@ -41,6 +41,8 @@ public:
 	virtual bool draw(ManagedSurface *g, bool forceRedraw = false);
 	virtual bool draw(bool forceRedraw = false);
 	virtual void blit(ManagedSurface *g, Common::Rect &dest);
+	// The text window is always drawn as a whole
+	virtual bool getDamagedRects(Common::Array<Common::Rect> &rects) { return false; }
 
 	void setTextWindowFont(const MacFont *macFont);
 	const MacFont *getTextWindowFont();
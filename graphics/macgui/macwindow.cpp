@@ -147,7 +147,7 @@ void MacWindow::setBackgroundPattern(int pattern) {
 }
 
 bool MacWindow::draw(bool forceRedraw) {
-	if (!_borderIsDirty && !_contentIsDirty && !forceRedraw)
+	if (!_borderIsDirty && !_contentIsDirty && _damagedRects.empty() && !forceRedraw)
 		return false;
 
 	if (_borderIsDirty || forceRedraw)
@@ -159,13 +159,33 @@ bool MacWindow::draw(bool forceRedraw) {
 }
 
 bool MacWindow::draw(ManagedSurface *g, bool forceRedraw) {
+	bool partial = !forceRedraw && !_borderIsDirty && !_contentIsDirty;
+
 	if (!draw(forceRedraw))
 		return false;
 
-	g->blitFrom(*_composeSurface, Common::Rect(0, 0, _composeSurface->w, _composeSurface->h), Common::Point(_innerDims.left, _innerDims.top));
-
 	uint32 transcolor = (_wm->_pixelformat.bytesPerPixel == 1) ? _wm->_colorGreen : 0;
 
+	if (partial) {
+		for (uint i = 0; i < _damagedRects.size(); i++) {
+			const Common::Rect &r = _damagedRects[i];
+			g->blitFrom(*_composeSurface, r, Common::Point(_innerDims.left + r.left, _innerDims.top + r.top));
+
+			Common::Rect border(r);
+			border.translate(_innerDims.left - _dims.left, _innerDims.top - _dims.top);
+			border.clip(Common::Rect(_borderSurface.w, _borderSurface.h));
+			if (!border.isEmpty())
+				g->transBlitFrom(_borderSurface, border, Common::Point(_dims.left + border.left, _dims.top + border.top), transcolor);
+		}
+
+		_damagedRects.clear();
+		return true;
+	}
+
+	_damagedRects.clear();
+
+	g->blitFrom(*_composeSurface, Common::Rect(0, 0, _composeSurface->w, _composeSurface->h), Common::Point(_innerDims.left, _innerDims.top));
+
 	g->transBlitFrom(_borderSurface, Common::Rect(0, 0, _borderSurface.w, _borderSurface.h), Common::Point(_dims.left, _dims.top), transcolor);
 
 	return true;
@@ -557,6 +577,38 @@ void MacWindow::addDirtyRect(const Common::Rect &r) {
 		_dirtyRects.push_back(bounds);
 }
 
+void MacWindow::addDamagedRect(const Common::Rect &r) {
+	Common::Rect bounds = r;
+	bounds.clip(Common::Rect(_composeSurface->w, _composeSurface->h));
+
+	if (bounds.isEmpty())
+		return;
+
+	// Drop the parts already covered, a window usually changing in few places
+	for (uint i = 0; i < _damagedRects.size(); i++) {
+		if (_damagedRects[i].contains(bounds))
+			return;
+
+		if (bounds.contains(_damagedRects[i]))
+			_damagedRects.remove_at(i--);
+	}
+
+	_damagedRects.push_back(bounds);
+}
+
+bool MacWindow::getDamagedRects(Common::Array<Common::Rect> &rects) {
+	if (_borderIsDirty || _contentIsDirty || _damagedRects.empty())
+		return false;
+
+	for (uint i = 0; i < _damagedRects.size(); i++) {
+		Common::Rect r = _damagedRects[i];
+		r.translate(_innerDims.left, _innerDims.top);
+		rects.push_back(r);
+	}
+
+	return true;
+}
+
 void MacWindow::markAllDirty() {
 	_dirtyRects.clear();
 	_dirtyRects.push_back(Common::Rect(_composeSurface->w, _composeSurface->h));
@@ -165,6 +165,14 @@ public:
 	 */
 	virtual bool isDirty() = 0;
 
+	/**
+	 * Method called by the WM before drawing the window, to only compose the
+	 * parts of the screen which changed.
+	 * @param rects Parts of the screen covered by the window which changed.
+	 * @return false if the whole window has to be drawn.
+	 */
+	virtual bool getDamagedRects(Common::Array<Common::Rect> &rects) { return false; }
+
 	/**
 	 * Set the callback that will be used when an event needs to be processed.
 	 * @param callback A function pointer to a function that accepts:
@@ -344,7 +352,15 @@ public:
 	void markAllDirty();
 	void mergeDirtyRects();
 
-	virtual bool isDirty() override { return _borderIsDirty || _contentIsDirty; }
+	/**
+	 * Mark a part of the window surface as changed. As long as the window
+	 * is not dirty otherwise, only these parts are drawn to the screen.
+	 * @param r Changed part, relative to the window surface.
+	 */
+	void addDamagedRect(const Common::Rect &r);
+	virtual bool getDamagedRects(Common::Array<Common::Rect> &rects) override;
+
+	virtual bool isDirty() override { return _borderIsDirty || _contentIsDirty || !_damagedRects.empty(); }
 
 	void setBorderDirty(bool dirty) { _borderIsDirty = true; }
 	void resizeBorderSurface();
@@ -376,6 +392,7 @@ protected:
 	Common::Rect _innerDims;
 
 	Common::List<Common::Rect> _dirtyRects;
+	Common::Array<Common::Rect> _damagedRects;
 	bool _hasScrollBar;
 
 	uint32 _mode;
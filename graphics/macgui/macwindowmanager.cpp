@@ -189,6 +189,7 @@ MacWindowManager::MacWindowManager(uint32 mode, MacPatterns *patterns, Common::L
 	_colorGreen2 = kColorGreen2;
 
 	_fullRefresh = true;
+	memset(&_drawStats, 0, sizeof(_drawStats));
 	_inEditableArea = false;
 
 	_hilitingWidget = false;
@@ -823,10 +824,35 @@ void MacWindowManager::drawDesktop() {
 	}
 }
 
+static bool isOccluded(Common::List<BaseMacWindow *>::const_iterator it, Common::List<BaseMacWindow *>::const_iterator end, const Common::Rect &area) {
+	// The content of the windows is opaque, while their borders may not be
+	for (it++; it != end; it++) {
+		if ((*it)->isVisible() && (*it)->getInnerDimensions().contains(area))
+			return true;
+	}
+	return false;
+}
+
+static void mergeRects(Common::Array<Common::Rect> &rects) {
+	for (uint i = 0; i < rects.size(); i++) {
+		for (uint j = i + 1; j < rects.size(); j++) {
+			if (rects[i].intersects(rects[j])) {
+				rects[i].extend(rects[j]);
+				rects.remove_at(j);
+				// The grown rect may intersect the ones already checked
+				j = i;
+			}
+		}
+	}
+}
+
 void MacWindowManager::draw() {
 	removeMarked();
 
 	Common::Rect bounds = getScreenBounds();
+	bool screenCopied = false;
+
+	memset(&_drawStats, 0, sizeof(_drawStats));
 
 	if (_fullRefresh) {
 		if (!(_mode & kWMModeNoDesktop)) {
@@ -838,11 +864,13 @@ void MacWindowManager::draw() {
 			}
 
 			if (_screen) {
+				// The screen is copied at once, once the windows are drawn
 				_screen->blitFrom(*_desktop, Common::Point(0, 0));
-				g_system->copyRectToScreen(_screen->getPixels(), _screen->pitch, 0, 0, _screen->w, _screen->h);
+				screenCopied = true;
 			} else {
 				_screenCopyPauseToken = new PauseToken(pauseEngine());
 				g_system->copyRectToScreen(_desktop->getPixels(), _desktop->pitch, 0, 0, _desktop->w, _desktop->h);
+				_drawStats.pixelsCopied += _desktop->w * _desktop->h;
 			}
 		}
 		if (_redrawEngineCallback != nullptr)
@@ -850,6 +878,7 @@ void MacWindowManager::draw() {
 	}
 
 	Common::Array<Common::Rect> dirtyRects;
+	Common::Array<Common::Rect> damagedRects;
 	for (Common::List<BaseMacWindow *>::const_iterator it = _windowStack.begin(); it != _windowStack.end(); it++) {
 		BaseMacWindow *w = *it;
 		if (!w->isVisible())
@@ -867,6 +896,11 @@ void MacWindowManager::draw() {
 		if (clip.isEmpty())
 			continue;
 
+		if (isOccluded(it, _windowStack.end(), clip)) {
+			_drawStats.windowsOccluded++;
+			continue;
+		}
+
 		bool forceRedraw = _fullRefresh;
 		if (!forceRedraw && dirtyRects.size()) {
 			for (Common::Array<Common::Rect>::iterator dirty = dirtyRects.begin(); dirty != dirtyRects.end(); dirty++) {
@@ -912,6 +946,9 @@ void MacWindowManager::draw() {
 				g_system->copyRectToScreen(w->getWindowSurface()->getBasePtr(MAX(clip.left - innerDims.left, 0), MAX(clip.top - innerDims.top, 0)), w->getWindowSurface()->pitch,MAX(innerDims.left, (int16)0), MAX(innerDims.top, (int16)0), adjWidth, adjHeight);
 
 				dirtyRects.push_back(clip);
+				_drawStats.windowsDrawn++;
+				_drawStats.pixelsComposited += clip.width() * clip.height();
+				_drawStats.pixelsCopied += clip.width() * clip.height();
 			}
 
 			if (_screenCopyPauseToken) {
@@ -919,30 +956,69 @@ void MacWindowManager::draw() {
 				delete _screenCopyPauseToken;
 				_screenCopyPauseToken = nullptr;
 			}
-		} else if (w->draw(_screen, forceRedraw)) {
-			w->setDirty(false);
-			g_system->copyRectToScreen(_screen->getBasePtr(clip.left, clip.top), _screen->pitch, clip.left, clip.top, clip.width(), clip.height());
-			dirtyRects.push_back(clip);
+		} else {
+			// Windows redrawn as a whole damage all of their area, while
+			// the others only damage the parts of their content that changed
+			damagedRects.clear();
+			if (forceRedraw || !w->getDamagedRects(damagedRects))
+				damagedRects.push_back(clip);
+
+			if (w->draw(_screen, forceRedraw)) {
+				w->setDirty(false);
+				_drawStats.windowsDrawn++;
+
+				for (uint i = 0; i < damagedRects.size(); i++) {
+					Common::Rect r = damagedRects[i];
+					r.clip(clip);
+					if (r.isEmpty())
+						continue;
+
+					dirtyRects.push_back(r);
+					_drawStats.pixelsComposited += r.width() * r.height();
+				}
+			}
 		}
 	}
 
 	// Menu is drawn on top of everything and always
 	if (_menu && !(_mode & kWMModeFullscreen)) {
-		if (_fullRefresh)
-			_menu->draw(_screen, _fullRefresh);
-		else {
+		bool menuRedraw = _fullRefresh;
+		if (!menuRedraw) {
 			// add intersection check with menu
-			bool menuRedraw = false;
 			for (Common::Array<Common::Rect>::iterator dirty = dirtyRects.begin(); dirty != dirtyRects.end(); dirty++) {
 				if (_menu->checkIntersects(*dirty)) {
 					menuRedraw = true;
 					break;
 				}
 			}
-			_menu->draw(_screen, menuRedraw);
+		}
+
+		// Outside of the modal mode, the menu copies the whole screen itself
+		if (_menu->draw(_screen, menuRedraw) && _screen && !(_mode & kWMModalMenuMode)) {
+			_drawStats.pixelsCopied += _screen->w * _screen->h;
+			screenCopied = false;
+			dirtyRects.clear();
+		}
+	}
+
+	if (_screen) {
+		if (screenCopied) {
+			g_system->copyRectToScreen(_screen->getPixels(), _screen->pitch, 0, 0, _screen->w, _screen->h);
+			_drawStats.pixelsCopied += _screen->w * _screen->h;
+		} else {
+			mergeRects(dirtyRects);
+			for (uint i = 0; i < dirtyRects.size(); i++) {
+				const Common::Rect &r = dirtyRects[i];
+				g_system->copyRectToScreen(_screen->getBasePtr(r.left, r.top), _screen->pitch, r.left, r.top, r.width(), r.height());
+				_drawStats.pixelsCopied += r.width() * r.height();
+			}
 		}
 	}
 
+	if (_drawStats.windowsDrawn)
+		debug(9, "MacWindowManager::draw(): %d windows drawn, %d occluded, %d pixels composited, %d copied",
+			_drawStats.windowsDrawn, _drawStats.windowsOccluded, _drawStats.pixelsComposited, _drawStats.pixelsCopied);
+
 	_fullRefresh = false;
 }
 
@@ -244,6 +244,16 @@ public:
 	 */
 	void draw();
 
+	/** Counters of the last call to draw(). */
+	struct DrawStats {
+		uint windowsDrawn;      ///< Windows composed onto the screen
+		uint windowsOccluded;   ///< Windows skipped, as other windows cover them
+		uint32 pixelsComposited; ///< Pixels of the windows composed onto the screen
+		uint32 pixelsCopied;     ///< Pixels copied to the backend
+	};
+
+	const DrawStats &getDrawStats() const { return _drawStats; }
+
 	/**
 	 * Method to process the events from the engine.
 	 * Most often this method will be called from the engine's GUI, and
@@ -408,6 +418,7 @@ private:
 	int _activeWindow;
 
 	bool _fullRefresh;
+	DrawStats _drawStats;
 
 	bool _inEditableArea;
 
@@ -32,6 +32,7 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "common/debug-channels.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/mixer/mixer.h"
+#include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/md5.h"
 #include "gui/gui-manager.h"
@@ -96,6 +97,10 @@ EventRecorder::EventRecorder() {
 	_lastScreenshotTime = 0;
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
+	_benchmark = false;
+	_benchmarkStart = 0;
+	_lastFrameTime = 0;
+	_mixerTime = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -106,6 +111,9 @@ void EventRecorder::deinit() {
 	if (!_initialized) {
 		return;
 	}
+	if (_benchmark) {
+		printBenchmarkReport();
+	}
 	setFileHeader();
 	_needRedraw = false;
 	_initialized = false;
@@ -152,7 +160,7 @@ void EventRecorder::processTimeAndDate(TimeDate &td, bool skipRecord) {
 		td = _lastTimeDate;
 		debug(3, "timedate event");
 
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextEvent();
 		break;
 	case kRecorderPlaybackPause:
 		td = _lastTimeDate;
@@ -205,7 +213,7 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 		debug(3, "millis event: %u", millis);
 
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextEvent();
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -222,6 +230,44 @@ bool EventRecorder::processDelayMillis() {
 	return _fastPlayback;
 }
 
+Common::RecorderEvent EventRecorder::getNextEvent() {
+	// The playback file quits once it runs out of events
+	if (_benchmark && !_playbackFile->hasNextEvent())
+		printBenchmarkReport();
+
+	return _playbackFile->getNextEvent();
+}
+
+void EventRecorder::recordBenchmarkFrame() {
+	uint64 now = g_system->getMicros();
+	_frameTimes.push_back((uint32)(now - _lastFrameTime));
+	_lastFrameTime = now;
+}
+
+void EventRecorder::printBenchmarkReport() {
+	_benchmark = false;
+
+	uint64 totalTime = g_system->getMicros() - _benchmarkStart;
+	uint numFrames = _frameTimes.size();
+	if (!numFrames) {
+		debug("benchmark:target=%s frames=0", ConfMan.getActiveDomainName().c_str());
+		return;
+	}
+
+	Common::sort(_frameTimes.begin(), _frameTimes.end());
+
+	uint64 frameTotal = 0;
+	for (uint i = 0; i < numFrames; i++)
+		frameTotal += _frameTimes[i];
+
+	debug("benchmark:target=%s engine=%s frames=%u playback_ms=%u wall_ms=%u mixer_ms=%u "
+	      "avg_us=%u p50_us=%u p90_us=%u p99_us=%u max_us=%u",
+	      ConfMan.getActiveDomainName().c_str(), ConfMan.get("engineid").c_str(), numFrames,
+	      (uint32)_fakeTimer, (uint32)(totalTime / 1000), (uint32)(_mixerTime / 1000),
+	      (uint32)(frameTotal / numFrames), _frameTimes[numFrames / 2],
+	      _frameTimes[numFrames * 9 / 10], _frameTimes[numFrames * 99 / 100], _frameTimes[numFrames - 1]);
+}
+
 void EventRecorder::checkForKeyCode(const Common::Event &event) {
 	if ((event.type == Common::EVENT_KEYDOWN) && (event.kbd.flags & Common::KBD_CTRL) && (event.kbd.keycode == Common::KEYCODE_p) && (!event.kbdRepeat)) {
 		togglePause();
@@ -239,7 +285,7 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 	}
 
 	ev = _nextEvent;
-	_nextEvent = _playbackFile->getNextEvent();
+	_nextEvent = getNextEvent();
 	switch (ev.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -324,6 +370,14 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 		DebugMan.enableDebugChannel("EventRec");
 		gDebugLevel = 1;
 	}
+	_benchmark = (_recordMode == kRecorderPlayback) && ConfMan.getBool("benchmark");
+	if (_benchmark) {
+		// Replay as fast as possible, skipping all delays
+		_fastPlayback = true;
+		_frameTimes.clear();
+		_mixerTime = 0;
+		_benchmarkStart = _lastFrameTime = g_system->getMicros();
+	}
 	if (_recordMode == kRecorderPlayback) {
 		debugC(1, kDebugLevelEventRec, "playback:action=\"Load file\" filename=%s", recordFileName.c_str());
 		Common::EventDispatcher *eventDispater = g_system->getEventManager()->getEventDispatcher();
@@ -346,7 +400,7 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	}
 	if (_recordMode == kRecorderPlayback) {
 		applyPlaybackSettings();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextEvent();
 	}
 	if (_recordMode == kRecorderRecord) {
 		getConfig();
@@ -485,7 +539,13 @@ void EventRecorder::updateSubsystems() {
 	}
 	RecordMode oldRecordMode = _recordMode;
 	_recordMode = kPassthrough;
-	_fakeMixerManager->update();
+	if (_benchmark) {
+		uint64 start = g_system->getMicros();
+		_fakeMixerManager->update();
+		_mixerTime += g_system->getMicros() - start;
+	} else {
+		_fakeMixerManager->update();
+	}
 	_recordMode = oldRecordMode;
 }
 
@@ -602,6 +662,11 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark) {
+		// No control panel in headless benchmarks, the screen updates mark the frames
+		recordBenchmarkFrame();
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -619,6 +684,9 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark) {
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -233,6 +233,17 @@ private:
 	bool _fastPlayback;
 	bool _needRedraw;
 	bool _processingMillis;
+
+	Common::RecorderEvent getNextEvent();
+
+	/** Headless benchmark mode, see the --benchmark option */
+	void recordBenchmarkFrame();
+	void printBenchmarkReport();
+	bool _benchmark;
+	uint64 _benchmarkStart;
+	uint64 _lastFrameTime;
+	uint64 _mixerTime;
+	Common::Array<uint32> _frameTimes;
 };
 
 } // End of namespace GUI
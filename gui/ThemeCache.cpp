@@ -0,0 +1,323 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "gui/ThemeCache.h"
+
+#include "common/debug.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/textconsole.h"
+
+#include "graphics/managed_surface.h"
+
+namespace GUI {
+
+namespace {
+
+const uint32 kCacheTag = MKTAG('S', 'T', 'X', 'C');
+
+/** Version of the cache format, and of the compiled STX format */
+const uint32 kCacheVersion = 1;
+
+#ifdef SCUMM_BIG_ENDIAN
+const byte kCacheEndianness = 1;
+#else
+const byte kCacheEndianness = 0;
+#endif
+
+void writeFormat(Common::WriteStream &stream, const Graphics::PixelFormat &format) {
+	stream.writeByte(format.bytesPerPixel);
+	stream.writeByte(format.rLoss);
+	stream.writeByte(format.gLoss);
+	stream.writeByte(format.bLoss);
+	stream.writeByte(format.aLoss);
+	stream.writeByte(format.rShift);
+	stream.writeByte(format.gShift);
+	stream.writeByte(format.bShift);
+	stream.writeByte(format.aShift);
+}
+
+Graphics::PixelFormat readFormat(Common::ReadStream &stream) {
+	Graphics::PixelFormat format;
+	format.bytesPerPixel = stream.readByte();
+	format.rLoss = stream.readByte();
+	format.gLoss = stream.readByte();
+	format.bLoss = stream.readByte();
+	format.aLoss = stream.readByte();
+	format.rShift = stream.readByte();
+	format.gShift = stream.readByte();
+	format.bShift = stream.readByte();
+	format.aShift = stream.readByte();
+	return format;
+}
+
+} // End of anonymous namespace
+
+ThemeCache::ThemeCache(const Common::FSNode &file) : _file(file), _compiledSTX(nullptr), _compiledSTXSize(0), _dirty(false) {
+	memset(_sourceHash, 0, sizeof(_sourceHash));
+}
+
+ThemeCache::~ThemeCache() {
+	clear();
+}
+
+ThemeCache *ThemeCache::createForTheme(const Common::String &themeFile) {
+	if (themeFile.empty())
+		return nullptr;
+
+	Common::FSNode theme(themeFile);
+	if (!theme.exists())
+		return nullptr;
+
+	Common::FSNode dir = theme.getParent();
+	if (!dir.isWritable())
+		return nullptr;
+
+	Common::String name = theme.getName();
+	if (name.hasSuffixIgnoreCase(".zip"))
+		name.erase(name.size() - 4);
+
+	return new ThemeCache(dir.getChild(name + ".cache"));
+}
+
+void ThemeCache::computeHash(Common::SeekableReadStream &stream, byte hash[kHashSize]) {
+	Common::computeStreamMD5(stream, hash);
+	stream.seek(0);
+}
+
+void ThemeCache::clear() {
+	free(_compiledSTX);
+	_compiledSTX = nullptr;
+	_compiledSTXSize = 0;
+
+	for (uint i = 0; i < _bitmaps.size(); i++)
+		free(_bitmaps[i].pixels);
+	_bitmaps.clear();
+}
+
+void ThemeCache::load(const byte sourceHash[kHashSize]) {
+	clear();
+	memcpy(_sourceHash, sourceHash, kHashSize);
+	_dirty = false;
+
+	if (!_file.exists())
+		return;
+
+	Common::ScopedPtr<Common::SeekableReadStream> stream(_file.createReadStream());
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() != kCacheTag || stream->readUint32LE() != kCacheVersion || stream->readByte() != kCacheEndianness) {
+		debug(1, "ThemeCache: Ignoring '%s' written by another version", _file.getName().c_str());
+		return;
+	}
+
+	byte hash[kHashSize];
+	stream->read(hash, kHashSize);
+	bool sourcesMatch = !memcmp(hash, sourceHash, kHashSize);
+
+	uint32 size = stream->readUint32LE();
+	if (size > stream->size() - stream->pos())
+		return;
+
+	if (sourcesMatch && size) {
+		_compiledSTX = (byte *)malloc(size);
+		_compiledSTXSize = size;
+		stream->read(_compiledSTX, size);
+	} else {
+		// The bitmaps are checked one by one, so they may still be used
+		stream->skip(size);
+		_dirty = true;
+	}
+
+	uint32 numBitmaps = stream->readUint32LE();
+	for (uint32 i = 0; i < numBitmaps && !stream->eos(); i++) {
+		Bitmap bitmap;
+		uint32 nameSize = stream->readUint32LE();
+		if (nameSize > 1024)
+			break;
+
+		char name[1024];
+		stream->read(name, nameSize);
+		bitmap.name = Common::String(name, nameSize);
+		stream->read(bitmap.fileHash, kHashSize);
+		bitmap.overlayFormat = readFormat(*stream);
+		bitmap.scale = stream->readUint32LE();
+		bitmap.format = readFormat(*stream);
+		bitmap.width = stream->readUint16LE();
+		bitmap.height = stream->readUint16LE();
+
+		uint32 pixelsSize = bitmap.width * bitmap.height * bitmap.format.bytesPerPixel;
+		if (!pixelsSize || pixelsSize > stream->size() - stream->pos())
+			break;
+
+		bitmap.used = false;
+		bitmap.pixels = (byte *)malloc(pixelsSize);
+		if (stream->read(bitmap.pixels, pixelsSize) != pixelsSize) {
+			free(bitmap.pixels);
+			break;
+		}
+		_bitmaps.push_back(bitmap);
+	}
+
+	if (stream->err()) {
+		warning("ThemeCache: Failed to read '%s'", _file.getName().c_str());
+		clear();
+		_dirty = true;
+	}
+}
+
+void ThemeCache::save() {
+	for (uint i = 0; i < _bitmaps.size();) {
+		if (_bitmaps[i].used) {
+			i++;
+			continue;
+		}
+
+		free(_bitmaps[i].pixels);
+		_bitmaps.remove_at(i);
+		_dirty = true;
+	}
+
+	if (!_dirty)
+		return;
+
+	Common::ScopedPtr<Common::WriteStream> stream(_file.createWriteStream());
+	if (!stream) {
+		debug(1, "ThemeCache: Can't write '%s'", _file.getName().c_str());
+		return;
+	}
+
+	stream->writeUint32BE(kCacheTag);
+	stream->writeUint32LE(kCacheVersion);
+	stream->writeByte(kCacheEndianness);
+	stream->write(_sourceHash, kHashSize);
+
+	stream->writeUint32LE(_compiledSTXSize);
+	stream->write(_compiledSTX, _compiledSTXSize);
+
+	stream->writeUint32LE(_bitmaps.size());
+	for (uint i = 0; i < _bitmaps.size(); i++) {
+		const Bitmap &bitmap = _bitmaps[i];
+		stream->writeUint32LE(bitmap.name.size());
+		stream->writeString(bitmap.name);
+		stream->write(bitmap.fileHash, kHashSize);
+		writeFormat(*stream, bitmap.overlayFormat);
+		stream->writeUint32LE(bitmap.scale);
+		writeFormat(*stream, bitmap.format);
+		stream->writeUint16LE(bitmap.width);
+		stream->writeUint16LE(bitmap.height);
+		stream->write(bitmap.pixels, bitmap.width * bitmap.height * bitmap.format.bytesPerPixel);
+	}
+
+	stream->finalize();
+	if (stream->err())
+		warning("ThemeCache: Failed to write '%s'", _file.getName().c_str());
+
+	_dirty = false;
+}
+
+void ThemeCache::resetUsage() {
+	for (uint i = 0; i < _bitmaps.size(); i++)
+		_bitmaps[i].used = false;
+}
+
+Common::SeekableReadStream *ThemeCache::getCompiledSTX() const {
+	if (!_compiledSTX)
+		return nullptr;
+
+	return new Common::MemoryReadStream(_compiledSTX, _compiledSTXSize);
+}
+
+void ThemeCache::setCompiledSTX(const byte *data, uint32 size) {
+	free(_compiledSTX);
+	_compiledSTX = nullptr;
+	_compiledSTXSize = 0;
+
+	if (size) {
+		_compiledSTX = (byte *)malloc(size);
+		_compiledSTXSize = size;
+		memcpy(_compiledSTX, data, size);
+	}
+	_dirty = true;
+}
+
+int ThemeCache::findBitmap(const Common::String &name, const byte fileHash[kHashSize],
+                           const Graphics::PixelFormat &overlayFormat, uint32 scale) const {
+	for (uint i = 0; i < _bitmaps.size(); i++) {
+		const Bitmap &bitmap = _bitmaps[i];
+		if (bitmap.name == name && bitmap.overlayFormat == overlayFormat && bitmap.scale == scale &&
+		    !memcmp(bitmap.fileHash, fileHash, kHashSize))
+			return i;
+	}
+	return -1;
+}
+
+Graphics::ManagedSurface *ThemeCache::getBitmap(const Common::String &name, const byte fileHash[kHashSize],
+                                                const Graphics::PixelFormat &overlayFormat, uint32 scale) {
+	int index = findBitmap(name, fileHash, overlayFormat, scale);
+	if (index < 0)
+		return nullptr;
+
+	Bitmap &bitmap = _bitmaps[index];
+	bitmap.used = true;
+	Graphics::ManagedSurface *surface = new Graphics::ManagedSurface(bitmap.width, bitmap.height, bitmap.format);
+	uint rowSize = bitmap.width * bitmap.format.bytesPerPixel;
+	for (uint y = 0; y < bitmap.height; y++)
+		memcpy(surface->getBasePtr(0, y), bitmap.pixels + y * rowSize, rowSize);
+
+	return surface;
+}
+
+void ThemeCache::addBitmap(const Common::String &name, const byte fileHash[kHashSize],
+                           const Graphics::PixelFormat &overlayFormat, uint32 scale,
+                           const Graphics::ManagedSurface &surface) {
+	// Drop the bitmap decoded from an older version of the file
+	for (uint i = 0; i < _bitmaps.size(); i++) {
+		if (_bitmaps[i].name == name && _bitmaps[i].overlayFormat == overlayFormat && _bitmaps[i].scale == scale) {
+			free(_bitmaps[i].pixels);
+			_bitmaps.remove_at(i);
+			break;
+		}
+	}
+
+	Bitmap bitmap;
+	bitmap.name = name;
+	memcpy(bitmap.fileHash, fileHash, kHashSize);
+	bitmap.overlayFormat = overlayFormat;
+	bitmap.scale = scale;
+	bitmap.format = surface.format;
+	bitmap.width = surface.w;
+	bitmap.height = surface.h;
+	bitmap.used = true;
+
+	uint rowSize = bitmap.width * bitmap.format.bytesPerPixel;
+	bitmap.pixels = (byte *)malloc(rowSize * bitmap.height);
+	for (uint y = 0; y < bitmap.height; y++)
+		memcpy(bitmap.pixels + y * rowSize, surface.getBasePtr(0, y), rowSize);
+
+	_bitmaps.push_back(bitmap);
+	_dirty = true;
+}
+
+} // End of namespace GUI
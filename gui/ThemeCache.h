@@ -0,0 +1,144 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GUI_THEME_CACHE_H
+#define GUI_THEME_CACHE_H
+
+#include "common/array.h"
+#include "common/fs.h"
+#include "common/str.h"
+
+#include "graphics/pixelformat.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Graphics {
+class ManagedSurface;
+}
+
+namespace GUI {
+
+/**
+ * Binary cache of a theme, stored next to the theme file.
+ *
+ * It holds the STX files of the theme compiled by Common::XMLParser, which
+ * are valid as long as the hash of the STX sources matches, and the decoded
+ * bitmaps of the theme, which are valid as long as the hash of their file,
+ * their pixel format and their scaling match.
+ */
+class ThemeCache {
+public:
+	enum {
+		kHashSize = 16
+	};
+
+	/**
+	 * @param file  Cache file. Nothing is read nor written before load()
+	 *              and save() are called.
+	 */
+	explicit ThemeCache(const Common::FSNode &file);
+	~ThemeCache();
+
+	/**
+	 * Return the cache to use for the given theme file, or nullptr if the
+	 * cache can't be written next to it.
+	 */
+	static ThemeCache *createForTheme(const Common::String &themeFile);
+
+	/** Compute the hash of a stream, and rewind it. */
+	static void computeHash(Common::SeekableReadStream &stream, byte hash[kHashSize]);
+
+	/**
+	 * Read the cache file. The compiled STX files are discarded if they were
+	 * compiled from sources with another hash.
+	 */
+	void load(const byte sourceHash[kHashSize]);
+
+	/**
+	 * Write the cache file, if anything changed since it was loaded. Bitmaps
+	 * which have not been used since load() or resetUsage() are dropped, so
+	 * the ones for other scales, pixel formats and sizes don't pile up.
+	 */
+	void save();
+
+	/** Consider all bitmaps unused, before the theme is loaded again. */
+	void resetUsage();
+
+	/**
+	 * Return the compiled STX files, or nullptr if they are not cached. The
+	 * stream is only valid until the next change to the cache.
+	 */
+	Common::SeekableReadStream *getCompiledSTX() const;
+
+	/**
+	 * Store the STX files compiled from the sources with the hash given to
+	 * load(). An empty buffer discards them.
+	 */
+	void setCompiledSTX(const byte *data, uint32 size);
+
+	/**
+	 * Return a copy of a cached bitmap, or nullptr if it isn't cached. The
+	 * bitmap is marked as used.
+	 *
+	 * @param name           Name of the bitmap in the theme.
+	 * @param fileHash       Hash of the image file it was decoded from.
+	 * @param overlayFormat  Overlay format the bitmap was decoded for.
+	 * @param scale          Scaling applied to the bitmap, in thousandths.
+	 */
+	Graphics::ManagedSurface *getBitmap(const Common::String &name, const byte fileHash[kHashSize],
+	                                    const Graphics::PixelFormat &overlayFormat, uint32 scale);
+
+	/** Store a copy of a decoded bitmap. The arguments are the same as for getBitmap(). */
+	void addBitmap(const Common::String &name, const byte fileHash[kHashSize],
+	               const Graphics::PixelFormat &overlayFormat, uint32 scale,
+	               const Graphics::ManagedSurface &surface);
+
+private:
+	struct Bitmap {
+		Common::String name;
+		byte fileHash[kHashSize];
+		Graphics::PixelFormat overlayFormat;
+		uint32 scale;
+		Graphics::PixelFormat format;
+		uint16 width;
+		uint16 height;
+		byte *pixels;
+		bool used;
+	};
+
+	int findBitmap(const Common::String &name, const byte fileHash[kHashSize],
+	               const Graphics::PixelFormat &overlayFormat, uint32 scale) const;
+	void clear();
+
+	Common::FSNode _file;
+	byte _sourceHash[kHashSize];
+	byte *_compiledSTX;
+	uint32 _compiledSTXSize;
+	Common::Array<Bitmap> _bitmaps;
+	bool _dirty;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -0,0 +1,149 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "gui/ThemeDrawCache.h"
+
+#include "common/debug.h"
+
+#include "graphics/managed_surface.h"
+
+namespace GUI {
+
+ThemeDrawCache::ThemeDrawCache(uint32 budget) : _budget(budget), _size(0), _hits(0), _misses(0) {
+	_pending.background = nullptr;
+	_pending.pixels = nullptr;
+}
+
+ThemeDrawCache::~ThemeDrawCache() {
+	clear();
+}
+
+void ThemeDrawCache::clear() {
+	if (_hits || _misses)
+		debug(5, "ThemeDrawCache: %d hits, %d misses", _hits, _misses);
+
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		freeEntry(*i);
+	_entries.clear();
+	_size = 0;
+
+	freeEntry(_pending);
+	_hits = _misses = 0;
+}
+
+void ThemeDrawCache::freeEntry(Entry &entry) {
+	free(entry.background);
+	free(entry.pixels);
+	entry.background = nullptr;
+	entry.pixels = nullptr;
+}
+
+ThemeDrawCache::EntryList::iterator ThemeDrawCache::find(uint32 id, uint32 dynamic, const Common::Rect &r) {
+	byte phase = getPhase(r);
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		if (i->id == id && i->dynamic == dynamic && i->width == r.width() && i->height == r.height() && i->phase == phase)
+			return i;
+	}
+	return _entries.end();
+}
+
+bool ThemeDrawCache::draw(uint32 id, uint32 dynamic, const Common::Rect &r, Graphics::ManagedSurface &surface) {
+	EntryList::iterator i = find(id, dynamic, r);
+	if (i == _entries.end()) {
+		_misses++;
+		return false;
+	}
+
+	const Entry &entry = *i;
+	for (int y = 0; y < entry.height; y++) {
+		if (memcmp(surface.getBasePtr(r.left, r.top + y), entry.background + y * entry.rowSize, entry.rowSize)) {
+			_misses++;
+			return false;
+		}
+	}
+
+	for (int y = 0; y < entry.height; y++)
+		memcpy(surface.getBasePtr(r.left, r.top + y), entry.pixels + y * entry.rowSize, entry.rowSize);
+
+	// Keep the most recently used elements at the front
+	if (i != _entries.begin()) {
+		_entries.push_front(entry);
+		_entries.erase(i);
+	}
+
+	_hits++;
+	return true;
+}
+
+void ThemeDrawCache::begin(uint32 id, uint32 dynamic, const Common::Rect &r, const Graphics::ManagedSurface &surface) {
+	freeEntry(_pending);
+
+	uint32 rowSize = r.width() * surface.format.bytesPerPixel;
+
+	// Large elements such as dialog backgrounds would evict everything else
+	if (r.isEmpty() || 2 * rowSize * r.height() > _budget / 8)
+		return;
+
+	_pending.id = id;
+	_pending.dynamic = dynamic;
+	_pending.width = r.width();
+	_pending.height = r.height();
+	_pending.phase = getPhase(r);
+	_pending.rowSize = rowSize;
+	_pending.background = (byte *)malloc(rowSize * r.height());
+	_pendingRect = r;
+
+	for (int y = 0; y < r.height(); y++)
+		memcpy(_pending.background + y * rowSize, surface.getBasePtr(r.left, r.top + y), rowSize);
+}
+
+void ThemeDrawCache::end(const Graphics::ManagedSurface &surface) {
+	if (!_pending.background)
+		return;
+
+	const Common::Rect &r = _pendingRect;
+	_pending.pixels = (byte *)malloc(_pending.rowSize * r.height());
+	for (int y = 0; y < r.height(); y++)
+		memcpy(_pending.pixels + y * _pending.rowSize, surface.getBasePtr(r.left, r.top + y), _pending.rowSize);
+
+	// The element is drawn over another background than the cached one
+	EntryList::iterator i = find(_pending.id, _pending.dynamic, r);
+	if (i != _entries.end()) {
+		_size -= 2 * i->rowSize * i->height;
+		freeEntry(*i);
+		_entries.erase(i);
+	}
+
+	_entries.push_front(_pending);
+	_size += 2 * _pending.rowSize * _pending.height;
+	_pending.background = nullptr;
+	_pending.pixels = nullptr;
+
+	while (_size > _budget) {
+		Entry &last = _entries.back();
+		_size -= 2 * last.rowSize * last.height;
+		freeEntry(last);
+		_entries.pop_back();
+	}
+}
+
+} // End of namespace GUI
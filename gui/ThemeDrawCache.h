@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GUI_THEME_DRAW_CACHE_H
+#define GUI_THEME_DRAW_CACHE_H
+
+#include "common/list.h"
+#include "common/rect.h"
+
+namespace Graphics {
+class ManagedSurface;
+}
+
+namespace GUI {
+
+/**
+ * Memory cache of the elements drawn by the ThemeEngine.
+ *
+ * The draw steps of an element only depend on its size, on the parity of
+ * its position for the dithering, on its dynamic data and on the pixels
+ * already beneath it. An element drawn again with all of these unchanged
+ * is copied from the cache instead, which is the common case of the many
+ * identical buttons and list rows redrawn when scrolling.
+ *
+ * The least recently used elements are dropped to stay within the budget.
+ */
+class ThemeDrawCache {
+public:
+	enum {
+		kDefaultBudget = 2 * 1024 * 1024
+	};
+
+	/**
+	 * @param budget  Number of bytes the pixels of the cached elements may take.
+	 */
+	explicit ThemeDrawCache(uint32 budget = kDefaultBudget);
+	~ThemeDrawCache();
+
+	/** Drop all the cached elements, e.g. when the theme changes. */
+	void clear();
+
+	/**
+	 * Copy a cached element to the surface, if it was drawn in the same
+	 * conditions before.
+	 *
+	 * @param id       Identifier of the element, e.g. its DrawData.
+	 * @param dynamic  Dynamic data the element is drawn with.
+	 * @param r        Part of the surface covered by the element.
+	 * @param surface  Surface the element is drawn to.
+	 * @return true if the element was copied.
+	 */
+	bool draw(uint32 id, uint32 dynamic, const Common::Rect &r, Graphics::ManagedSurface &surface);
+
+	/**
+	 * Start caching an element which is about to be drawn. The arguments
+	 * are the same as for draw(), and end() must be called once drawn.
+	 */
+	void begin(uint32 id, uint32 dynamic, const Common::Rect &r, const Graphics::ManagedSurface &surface);
+
+	/** Store the element drawn since begin(). */
+	void end(const Graphics::ManagedSurface &surface);
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+
+private:
+	struct Entry {
+		uint32 id;
+		uint32 dynamic;
+		int16 width;
+		int16 height;
+		byte phase;
+		uint32 rowSize;
+		byte *background; ///< Pixels beneath the element
+		byte *pixels;     ///< Pixels once the element is drawn
+	};
+
+	typedef Common::List<Entry> EntryList;
+
+	static byte getPhase(const Common::Rect &r) { return (r.left & 1) | ((r.top & 1) << 1); }
+
+	EntryList::iterator find(uint32 id, uint32 dynamic, const Common::Rect &r);
+	void freeEntry(Entry &entry);
+
+	/** The most recently used elements come first */
+	EntryList _entries;
+	uint32 _budget;
+	uint32 _size;
+
+	Entry _pending;
+	Common::Rect _pendingRect;
+
+	uint32 _hits;
+	uint32 _misses;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -24,6 +24,8 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -42,6 +44,8 @@
 #include "image/png.h"
 
 #include "gui/widget.h"
+#include "gui/ThemeCache.h"
+#include "gui/ThemeDrawCache.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeParser.h"
@@ -89,6 +93,9 @@ struct WidgetDrawData {
 
 	DrawLayer _layer;
 
+	/** Whether the drawing only depends on the widget area, so it can be cached */
+	bool _cacheable;
+
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -96,6 +103,7 @@ struct WidgetDrawData {
 	 * called in order to calculate if such draw steps would be drawn outside of
 	 * the actual widget drawing zone (e.g. shadows). If this is the case, a constant
 	 * value will be added when restoring the background of the widget.
+	 * It also checks whether the draw steps can be cached.
 	 */
 	void calcBackgroundOffset();
 };
@@ -190,7 +198,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(nullptr), _vectorRenderer(nullptr),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(nullptr), _scaleFactor(1.0f) {
+	_cursor(nullptr), _scaleFactor(1.0f), _cache(nullptr), _drawCache(nullptr) {
 
 	_baseWidth = 640;	// Default sane values
 	_baseHeight = 480;
@@ -198,6 +206,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system = g_system;
 	_parser = new ThemeParser(this);
 	_themeEval = new GUI::ThemeEval();
+	_drawCache = new ThemeDrawCache();
 	_themeEval->setScaleFactor(_scaleFactor);
 
 	_useCursor = false;
@@ -259,6 +268,12 @@ ThemeEngine::~ThemeEngine() {
 	}
 	_bitmaps.clear();
 
+	// Keep the bitmaps decoded since the theme was loaded
+	if (_cache)
+		_cache->save();
+	delete _cache;
+	delete _drawCache;
+
 	delete _parser;
 	delete _themeEval;
 	delete[] _cursor;
@@ -458,6 +473,7 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
+	_drawCache->clear();
 
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
@@ -468,8 +484,13 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 
 void WidgetDrawData::calcBackgroundOffset() {
 	uint maxShadow = 0, maxBevel = 0;
+	_cacheable = true;
 	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
 	        step != _steps.end(); ++step) {
+		// The whole surface is filled, not only the widget area
+		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE)
+			_cacheable = false;
+
 		if ((step->autoWidth || step->autoHeight) && step->shadow > maxShadow)
 			maxShadow = step->shadow;
 
@@ -681,84 +702,73 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 		_bitmaps.erase(filename);
 	}
 
-	if (!scalablefile.empty()) {
-		Graphics::SVGBitmap *image = nullptr;
-		Common::ArchiveMemberList members;
-		_themeFiles.listMatchingMembers(members, scalablefile);
-		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
-			Common::SeekableReadStream *stream = (*i)->createReadStream();
-			if (stream) {
-				image = new Graphics::SVGBitmap(stream);
-				break;
-			}
+	// Read the image file first, as the cached bitmap is checked against it
+	Common::ScopedPtr<Common::SeekableReadStream> stream;
+	Common::ArchiveMemberList members;
+	_themeFiles.listMatchingMembers(members, scalablefile.empty() ? filename : scalablefile);
+	for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end && !stream; ++i)
+		stream.reset((*i)->createReadStream());
+
+	byte hash[ThemeCache::kHashSize];
+	uint32 scale = (uint32)(_scaleFactor * 1000 + 0.5f);
+	// Scalable bitmaps are also identified by the size they are rendered at
+	Common::String cacheName = scalablefile.empty() ? filename : Common::String::format("%s@%dx%d", filename.c_str(), width, height);
+
+	if (stream && _cache) {
+		ThemeCache::computeHash(*stream, hash);
+		surf = _cache->getBitmap(cacheName, hash, _overlayFormat, scale);
+		if (surf) {
+			_bitmaps[filename] = surf;
+			return true;
 		}
+	}
 
-		if (image) {
-			_bitmaps[filename] = new Graphics::ManagedSurface(width * _scaleFactor, height * _scaleFactor, *image->getPixelFormat());
-			image->render(*_bitmaps[filename], width * _scaleFactor, height * _scaleFactor);
-
-			delete image;
-		} else {
+	if (!scalablefile.empty()) {
+		if (!stream)
 			return false;
-		}
-
-		return true;
-	}
 
-	const Graphics::Surface *srcSurface = nullptr;
+		Graphics::SVGBitmap *image = new Graphics::SVGBitmap(stream.get());
+		surf = new Graphics::ManagedSurface(width * _scaleFactor, height * _scaleFactor, *image->getPixelFormat());
+		image->render(*surf, width * _scaleFactor, height * _scaleFactor);
+		delete image;
+	} else if (stream) {
+		const Graphics::Surface *srcSurface = nullptr;
 
-	if (filename.hasSuffix(".png")) {
-		// Maybe it is PNG?
+		if (filename.hasSuffix(".png")) {
+			// Maybe it is PNG?
 #ifdef USE_PNG
-		Image::PNGDecoder decoder;
-		Common::ArchiveMemberList members;
-		_themeFiles.listMatchingMembers(members, filename);
-		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
-			Common::SeekableReadStream *stream = (*i)->createReadStream();
-			if (stream) {
-				if (!decoder.loadStream(*stream))
-					error("Error decoding PNG");
-
-				srcSurface = decoder.getSurface();
-				delete stream;
-				if (srcSurface)
-					break;
-			}
-		}
+			Image::PNGDecoder decoder;
+			if (!decoder.loadStream(*stream))
+				error("Error decoding PNG");
 
-		if (srcSurface && srcSurface->format.bytesPerPixel != 1)
-			surf = new Graphics::ManagedSurface(srcSurface->convertTo(_overlayFormat));
+			srcSurface = decoder.getSurface();
+			if (srcSurface && srcSurface->format.bytesPerPixel != 1)
+				surf = new Graphics::ManagedSurface(srcSurface->convertTo(_overlayFormat));
 #else
-		error("No PNG support compiled in");
+			error("No PNG support compiled in");
 #endif
-	} else {
-		// If not, try to load the bitmap via the BitmapDecoder class.
-		Image::BitmapDecoder bitmapDecoder;
-		Common::ArchiveMemberList members;
-		_themeFiles.listMatchingMembers(members, filename);
-		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
-			Common::SeekableReadStream *stream = (*i)->createReadStream();
-			if (stream) {
-				bitmapDecoder.loadStream(*stream);
-				srcSurface = bitmapDecoder.getSurface();
-				delete stream;
-				if (srcSurface)
-					break;
-			}
+		} else {
+			// If not, try to load the bitmap via the BitmapDecoder class.
+			Image::BitmapDecoder bitmapDecoder;
+			bitmapDecoder.loadStream(*stream);
+			srcSurface = bitmapDecoder.getSurface();
+			if (srcSurface && srcSurface->format.bytesPerPixel != 1)
+				surf = new Graphics::ManagedSurface(srcSurface->convertTo(_overlayFormat));
 		}
 
-		if (srcSurface && srcSurface->format.bytesPerPixel != 1)
-			surf = new Graphics::ManagedSurface(srcSurface->convertTo(_overlayFormat));
-	}
-
-	if (_scaleFactor != 1.0 && surf) {
-		Graphics::Surface *tmp2 = surf->rawSurface().scale(surf->w * _scaleFactor, surf->h * _scaleFactor, false);
+		if (_scaleFactor != 1.0 && surf) {
+			Graphics::Surface *tmp2 = surf->rawSurface().scale(surf->w * _scaleFactor, surf->h * _scaleFactor, false);
 
-		surf->free();
-		delete surf;
+			surf->free();
+			delete surf;
 
-		surf = new Graphics::ManagedSurface(tmp2);
+			surf = new Graphics::ManagedSurface(tmp2);
+		}
 	}
+
+	if (surf && _cache)
+		_cache->addBitmap(cacheName, hash, _overlayFormat, scale, *surf);
+
 	// Store the surface into our hashmap (attention, may store NULL entries!)
 	_bitmaps[filename] = surf;
 
@@ -776,6 +786,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_layer = kDrawDataDefaults[id].layer;
+	_widgets[id]->_cacheable = false;
 	_widgets[id]->_textDataId = kTextDataNone;
 
 	return true;
@@ -819,6 +830,7 @@ void ThemeEngine::unloadTheme() {
 		delete _widgets[i];
 		_widgets[i] = nullptr;
 	}
+	_drawCache->clear();
 
 	for (int i = 0; i < kTextDataMAX; ++i) {
 		// Don't unload the language specific extra font here or it will be lost after a refresh() call.
@@ -913,26 +925,85 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 	}
 
 	//
-	// Loop over all STX files, load and parse them
+	// Read all STX files, as the compiled ones are only used if none of them changed
 	//
+	Common::MemoryWriteStreamDynamic sources(DisposeAfterUse::YES);
+	Common::Array<uint32> sourceOffsets;
 	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
 		assert((*i)->getName().hasSuffix(".stx"));
 
-		if (_parser->loadStream((*i)->createReadStream()) == false) {
+		Common::ScopedPtr<Common::SeekableReadStream> stream((*i)->createReadStream());
+		if (!stream) {
 			warning("Failed to load STX file '%s'", (*i)->getName().c_str());
-			_parser->close();
 			return false;
 		}
 
-		if (_parser->parse() == false) {
-			warning("Failed to parse STX file '%s'", (*i)->getName().c_str());
+		sources.writeUint32LE((*i)->getName().size());
+		sources.writeString((*i)->getName());
+		sources.writeUint32LE(stream->size());
+		sourceOffsets.push_back(sources.pos());
+		sources.writeStream(stream.get());
+	}
+
+	if (!_cache) {
+		_cache = ThemeCache::createForTheme(_themeFile);
+		if (_cache) {
+			byte hash[ThemeCache::kHashSize];
+			Common::MemoryReadStream sourcesStream(sources.getData(), sources.size());
+			ThemeCache::computeHash(sourcesStream, hash);
+			_cache->load(hash);
+		}
+	} else {
+		// Only keep the bitmaps used by this theme load
+		_cache->resetUsage();
+	}
+
+	Common::ScopedPtr<Common::SeekableReadStream> compiled(_cache ? _cache->getCompiledSTX() : nullptr);
+	bool compiledOk = false;
+	if (compiled) {
+		compiledOk = true;
+		while (compiled->pos() < compiled->size()) {
+			if (!_parser->parseCompiled(*compiled)) {
+				// Whatever has been set up so far is defined again by the sources
+				warning("Failed to process the compiled STX files of theme '%s', using the STX files", themeId.c_str());
+				compiledOk = false;
+				break;
+			}
+		}
+	}
+
+	if (!compiledOk) {
+		//
+		// Parse all STX files, and compile them for the next time
+		//
+		Common::MemoryWriteStreamDynamic compiledSTX(DisposeAfterUse::YES);
+		if (_cache)
+			_parser->setCompileStream(&compiledSTX);
+
+		Common::ArchiveMemberList::iterator member = members.begin();
+		for (uint i = 0; i < sourceOffsets.size(); i++, ++member) {
+			const byte *data = sources.getData() + sourceOffsets[i];
+			uint32 size = READ_LE_UINT32(data - 4);
+			_parser->loadBuffer(data, size);
+
+			if (_parser->parse() == false) {
+				warning("Failed to parse STX file '%s'", (*member)->getName().c_str());
+				_parser->close();
+				_parser->setCompileStream(nullptr);
+				return false;
+			}
+
 			_parser->close();
-			return false;
 		}
 
-		_parser->close();
+		_parser->setCompileStream(nullptr);
+		if (_cache)
+			_cache->setCompiledSTX(compiledSTX.getData(), compiledSTX.size());
 	}
 
+	if (_cache)
+		_cache->save();
+
 	assert(!_themeName.empty());
 	return true;
 }
@@ -961,6 +1032,10 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		extendedRect.bottom += drawData->_shadowOffset - drawData->_backgroundOffset;
 	}
 
+	// Only the elements drawn as a whole, relatively to their area, are cached
+	bool cacheable = drawData->_cacheable && area == r && !_clip.isEmpty() &&
+	                 _clip.contains(extendedRect) && Common::Rect(_screen.w, _screen.h).contains(extendedRect);
+
 	if (!_clip.isEmpty()) {
 		extendedRect.clip(_clip);
 	}
@@ -974,9 +1049,23 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		Graphics::ManagedSurface &surface = *_vectorRenderer->getActiveSurface();
 		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		if (cacheable && _drawCache->draw(type, dynamic, extendedRect, surface)) {
+			// Leave the renderer as if the steps were drawn
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->applyStepSettings(area, _clip, *step, dynamic);
+			}
+		} else {
+			if (cacheable)
+				_drawCache->begin(type, dynamic, extendedRect, surface);
+
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+			}
+
+			if (cacheable)
+				_drawCache->end(surface);
 		}
 
 		addDirtyRect(extendedRect);
@@ -53,6 +53,8 @@ struct TextDrawData;
 struct TextColorData;
 class Dialog;
 class GuiObject;
+class ThemeCache;
+class ThemeDrawCache;
 class ThemeEval;
 class ThemeParser;
 
@@ -809,6 +811,12 @@ protected:
 #endif
 
 	Common::Rect _clip;
+
+	/** Compiled STX files and decoded bitmaps of the theme, or nullptr if it isn't cached */
+	ThemeCache *_cache;
+
+	/** Widgets drawn recently, to copy them when they are drawn the same way again */
+	ThemeDrawCache *_drawCache;
 };
 
 } // End of namespace GUI.
@@ -26,6 +26,7 @@
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
@@ -79,6 +80,9 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+
+	registerCmd("profiler",			WRAP_METHOD(Debugger, cmdProfiler));
+	registerCmd("searchman_stats",	WRAP_METHOD(Debugger, cmdSearchManStats));
 }
 
 Debugger::~Debugger() {
@@ -804,6 +808,38 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdProfiler(int argc, const char **argv) {
+	if (argc < 2) {
+		debugPrintf("profiler [on | off | overlay | summary | dump <filename>]\n");
+		debugPrintf("Profiler is %s, %d frames recorded\n", Common::Profiler::isEnabled() ? "on" : "off", ProfilerMan.getNumFrames());
+	} else if (!scumm_stricmp(argv[1], "on")) {
+		ProfilerMan.setEnabled(true);
+	} else if (!scumm_stricmp(argv[1], "off")) {
+		ProfilerMan.setEnabled(false);
+	} else if (!scumm_stricmp(argv[1], "overlay")) {
+		ProfilerMan.setOverlayVisible(!ProfilerMan.isOverlayVisible());
+	} else if (!scumm_stricmp(argv[1], "summary")) {
+		debugPrintf("%s\n", ProfilerMan.getSummary().c_str());
+	} else if (!scumm_stricmp(argv[1], "dump") && argc == 3) {
+		Common::DumpFile out;
+		if (!out.open(argv[2])) {
+			debugPrintf("Failed to open '%s'\n", argv[2]);
+		} else {
+			ProfilerMan.exportChromeTrace(out);
+			out.finalize();
+			debugPrintf("Wrote %d frames to '%s'\n", ProfilerMan.getNumFrames(), argv[2]);
+		}
+	} else {
+		debugPrintf("profiler [on | off | overlay | summary | dump <filename>]\n");
+	}
+	return true;
+}
+
+bool Debugger::cmdSearchManStats(int argc, const char **argv) {
+	debugPrintf("%s", SearchMan.getStatsReport().c_str());
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
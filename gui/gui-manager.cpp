@@ -79,8 +79,10 @@ GuiManager::GuiManager() : _redrawStatus(kRedrawDisabled), _stateIsSaved(false),
 	memset(_cursor, 0xFF, sizeof(_cursor));
 
 #ifdef USE_TRANSLATION
-	// Enable translation
-	TransMan.setLanguage(ConfMan.get("gui_language").c_str());
+	// Enable translation. When a game was started from the command line,
+	// the GUI is first set up while it runs, and keeps the game language.
+	if (!g_engine)
+		TransMan.setLanguage(ConfMan.get("gui_language").c_str());
 	setLanguageRTL();
 #endif // USE_TRANSLATION
 
@@ -0,0 +1,98 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/coroutines.h"
+#include "common/system.h"
+#include "../null_osystem.h"
+
+static int s_coroRuns = 0;
+
+static void countingProcess(CORO_PARAM, const void *param) {
+	CORO_BEGIN_CONTEXT;
+		int i;
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	for (_ctx->i = 0; _ctx->i < 3; _ctx->i++) {
+		s_coroRuns++;
+		CORO_SLEEP(1);
+	}
+
+	CORO_END_CODE;
+}
+
+static void sleepingProcess(CORO_PARAM, const void *param) {
+	CORO_BEGIN_CONTEXT;
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	CORO_INVOKE_ARGS(CoroScheduler.sleep, (CORO_SUBCTX, 100000));
+	s_coroRuns++;
+
+	CORO_END_CODE;
+}
+
+class CoroutineTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		if (!g_system)
+			Common::install_null_g_system();
+#endif
+		s_coroRuns = 0;
+		CoroScheduler.reset();
+	}
+
+	void test_process_runs_to_completion() {
+		uint32 pid = CoroScheduler.createProcess(countingProcess, nullptr, 0);
+		TS_ASSERT_DIFFERS(pid, (uint32)CORO_INVALID_PID_VALUE);
+		TS_ASSERT_EQUALS(CoroScheduler.getStats().numProcesses, 1u);
+
+		for (int i = 0; i < 5; i++)
+			CoroScheduler.schedule();
+
+		TS_ASSERT_EQUALS(s_coroRuns, 3);
+		TS_ASSERT_EQUALS(CoroScheduler.getStats().numProcesses, 0u);
+	}
+
+	void test_kill_matching_process() {
+		CoroScheduler.createProcess(countingProcess, nullptr, 0);
+		CoroScheduler.createProcess(countingProcess, nullptr, 0);
+		CoroScheduler.schedule();
+
+		TS_ASSERT_EQUALS(CoroScheduler.killMatchingProcess(0, 0), 2);
+		TS_ASSERT_EQUALS(CoroScheduler.getStats().numProcesses, 0u);
+	}
+
+	void test_sleeping_process_is_parked() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		CoroScheduler.createProcess(sleepingProcess, nullptr, 0);
+		CoroScheduler.schedule();
+
+		uint32 dispatches = CoroScheduler.getStats().dispatches;
+		for (int i = 0; i < 10; i++)
+			CoroScheduler.schedule();
+
+		TS_ASSERT_EQUALS(CoroScheduler.getStats().dispatches, dispatches);
+		TS_ASSERT_EQUALS(s_coroRuns, 0);
+
+		TS_ASSERT_EQUALS(CoroScheduler.killMatchingProcess(0, 0), 1);
+#endif
+	}
+
+	void test_scheduler_recreated() {
+		// Destroying the scheduler with live contexts releases the context
+		// pools; a new scheduler must start from fresh ones
+		CoroScheduler.createProcess(countingProcess, nullptr, 0);
+		CoroScheduler.schedule();
+		Common::CoroutineScheduler::destroy();
+
+		CoroScheduler.createProcess(countingProcess, nullptr, 0);
+		for (int i = 0; i < 5; i++)
+			CoroScheduler.schedule();
+
+		TS_ASSERT_EQUALS(s_coroRuns, 4);
+		TS_ASSERT_EQUALS(CoroScheduler.getStats().numProcesses, 0u);
+	}
+};
@@ -0,0 +1,75 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/lz4.h"
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+class LZ4TestSuite : public CxxTest::TestSuite {
+	// Compressible text, followed by data which does not compress
+	static byte dataByte(uint32 pos) {
+		if (pos < 100000)
+			return "Lorem ipsum dolor sit amet, consectetur adipiscing elit"[pos % 56];
+		return (pos * 2654435761U) >> 24;
+	}
+
+public:
+	void test_block_roundtrip() {
+		byte src[1000], compressed[1100], dst[1000];
+		for (uint i = 0; i < sizeof(src); i++)
+			src[i] = (i / 10) & 0xff;
+
+		uint32 size = Common::lz4Compress(compressed, src, sizeof(src));
+		TS_ASSERT_LESS_THAN(size, sizeof(src) / 2);
+		TS_ASSERT(Common::lz4Decompress(dst, sizeof(dst), compressed, size));
+		TS_ASSERT(!memcmp(src, dst, sizeof(src)));
+
+		// Wrong sizes and truncated data are detected
+		TS_ASSERT(!Common::lz4Decompress(dst, sizeof(dst) - 1, compressed, size));
+		TS_ASSERT(!Common::lz4Decompress(dst, sizeof(dst), compressed, size - 3));
+	}
+
+	void test_short_blocks() {
+		byte compressed[32], dst[8];
+		const byte src[] = "abcdabc";
+		uint32 size = Common::lz4Compress(compressed, src, sizeof(src));
+		TS_ASSERT(Common::lz4Decompress(dst, sizeof(src), compressed, size));
+		TS_ASSERT(!memcmp(src, dst, sizeof(src)));
+
+		size = Common::lz4Compress(compressed, src, 0);
+		TS_ASSERT(Common::lz4Decompress(dst, 0, compressed, size));
+	}
+
+	void test_stream_roundtrip() {
+		const uint32 size = 300000;
+
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *writer = Common::wrapLZ4WriteStream(compressed);
+		for (uint32 pos = 0; pos < size; pos++)
+			writer->writeByte(dataByte(pos));
+		writer->finalize();
+		TS_ASSERT_EQUALS(writer->pos(), (int64)size);
+
+		uint32 compressedSize = compressed->size();
+		TS_ASSERT_LESS_THAN(compressedSize, size);
+		Common::SeekableReadStream *reader = Common::wrapLZ4ReadStream(
+			new Common::MemoryReadStream(compressed->getData(), compressedSize, DisposeAfterUse::YES));
+		delete writer;
+
+		TS_ASSERT(reader);
+		TS_ASSERT_EQUALS(reader->size(), (int64)size);
+		bool same = true;
+		for (uint32 pos = 0; pos < size; pos++)
+			same &= reader->readByte() == dataByte(pos);
+		TS_ASSERT(same);
+		delete reader;
+	}
+
+	void test_uncompressed_stream() {
+		const byte data[] = "LZ4 is not a header";
+		Common::SeekableReadStream *stream = Common::wrapLZ4ReadStream(new Common::MemoryReadStream(data, sizeof(data)));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), (int64)sizeof(data));
+		TS_ASSERT_EQUALS(stream->pos(), 0);
+		delete stream;
+	}
+};
@@ -0,0 +1,55 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/profiler.h"
+#include "../null_osystem.h"
+
+class ProfilerTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		if (!g_system)
+			Common::install_null_g_system();
+#endif
+	}
+
+	void test_zones_and_frames() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ProfilerMan.setEnabled(true);
+		TS_ASSERT(Common::Profiler::isEnabled());
+		TS_ASSERT_EQUALS(ProfilerMan.getNumFrames(), 0u);
+
+		ProfilerMan.addZone("first", 0, 10, Common::kProfileTrackMain);
+		ProfilerMan.endFrame();
+		ProfilerMan.addZone("second", 20, 30, Common::kProfileTrackAudio);
+		ProfilerMan.endFrame();
+		TS_ASSERT_EQUALS(ProfilerMan.getNumFrames(), 2u);
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		ProfilerMan.exportChromeTrace(out);
+		Common::String json((const char *)out.getData(), out.size());
+		TS_ASSERT(json.hasPrefix("{"));
+		TS_ASSERT(json.contains("\"name\":\"first\""));
+		TS_ASSERT(json.contains("\"name\":\"second\""));
+		TS_ASSERT(json.contains("\"tid\":1,\"ts\":20,\"dur\":10"));
+
+		// Restarting discards the recorded frames
+		ProfilerMan.setEnabled(false);
+		TS_ASSERT(!Common::Profiler::isEnabled());
+		ProfilerMan.setEnabled(true);
+		TS_ASSERT_EQUALS(ProfilerMan.getNumFrames(), 0u);
+		ProfilerMan.setEnabled(false);
+#endif
+	}
+
+	void test_ring_buffer() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		ProfilerMan.setEnabled(true);
+		for (uint i = 0; i < 2 * Common::Profiler::kNumFrames; i++)
+			ProfilerMan.endFrame();
+
+		TS_ASSERT_EQUALS(ProfilerMan.getNumFrames(), (uint)Common::Profiler::kNumFrames - 1);
+		ProfilerMan.setEnabled(false);
+#endif
+	}
+};
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+// Archive with a single member, which may or may not be listed by name
+class SingleMemberArchive : public Common::Archive {
+public:
+	SingleMemberArchive(const Common::String &name, byte content, bool indexable)
+		: _name(name), _content(content), _indexable(indexable) {}
+
+	bool hasFile(const Common::Path &path) const override {
+		return path.toString().equalsIgnoreCase(_name);
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_name, this)));
+		return 1;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_name, this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return nullptr;
+		return new Common::MemoryReadStream(&_content, 1);
+	}
+
+	bool listMemberNames(Common::StringArray &names) const override {
+		if (_indexable)
+			names.push_back(Common::Path(_name).rawString());
+		return _indexable;
+	}
+
+private:
+	Common::String _name;
+	byte _content;
+	bool _indexable;
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+	static byte readMember(const Common::SearchSet &set, const char *name) {
+		Common::SeekableReadStream *stream = set.createReadStreamForMember(name);
+		if (!stream)
+			return 0;
+		byte b = stream->readByte();
+		delete stream;
+		return b;
+	}
+
+public:
+	void test_priorities() {
+		Common::SearchSet set;
+		set.add("low", new SingleMemberArchive("file", 1, true), 0);
+		set.add("other", new SingleMemberArchive("dir/other", 2, true), 0);
+
+		TS_ASSERT(set.hasFile("FILE"));
+		TS_ASSERT(set.hasFile("dir/other"));
+		TS_ASSERT(!set.hasFile("missing"));
+		TS_ASSERT_EQUALS(readMember(set, "file"), 1);
+
+		// Archives of higher priority take precedence, indexed or not
+		set.add("unindexed", new SingleMemberArchive("file", 3, false), 1);
+		TS_ASSERT_EQUALS(readMember(set, "file"), 3);
+
+		set.add("high", new SingleMemberArchive("file", 4, true), 2);
+		TS_ASSERT_EQUALS(readMember(set, "file"), 4);
+
+		set.remove("high");
+		set.setPriority("unindexed", -1);
+		TS_ASSERT_EQUALS(readMember(set, "file"), 1);
+
+		Common::SearchSet::Stats stats = set.getStats();
+		TS_ASSERT_EQUALS(stats.misses, 1u);
+		TS_ASSERT_EQUALS(stats.indexedNames, 2u);
+	}
+
+	void test_lazy_indexing() {
+		Common::SearchSet set;
+		set.add("first", new SingleMemberArchive("a", 1, true), 2);
+		set.add("second", new SingleMemberArchive("b", 2, true), 1);
+		set.add("third", new SingleMemberArchive("c", 3, true), 0);
+
+		// Only archives a lookup reaches get indexed
+		TS_ASSERT_EQUALS(readMember(set, "a"), 1);
+		TS_ASSERT_EQUALS(set.getStats().archivesIndexed, 1u);
+		TS_ASSERT_EQUALS(readMember(set, "b"), 2);
+		TS_ASSERT_EQUALS(set.getStats().archivesIndexed, 2u);
+		TS_ASSERT(!set.hasFile("missing"));
+		TS_ASSERT_EQUALS(set.getStats().archivesIndexed, 3u);
+		TS_ASSERT_EQUALS(set.getStats().indexedNames, 3u);
+
+		// Adding or removing an archive leaves the others indexed
+		set.remove("second");
+		TS_ASSERT_EQUALS(set.getStats().indexedNames, 2u);
+		TS_ASSERT(!set.hasFile("b"));
+
+		set.add("fourth", new SingleMemberArchive("c", 4, true), 1);
+		TS_ASSERT_EQUALS(readMember(set, "a"), 1);
+		TS_ASSERT_EQUALS(set.getStats().archivesIndexed, 3u);
+		TS_ASSERT_EQUALS(readMember(set, "c"), 4);
+		TS_ASSERT_EQUALS(set.getStats().archivesIndexed, 4u);
+		TS_ASSERT_EQUALS(set.getStats().indexedNames, 2u);
+
+		set.remove("fourth");
+		TS_ASSERT_EQUALS(readMember(set, "c"), 3);
+	}
+};
@@ -0,0 +1,157 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/threadpool.h"
+#include "../null_osystem.h"
+
+// Exercises the synchronous fallback used on ports without threads, and
+// real workers where the null backend provides them
+class ThreadPoolTestSuite : public CxxTest::TestSuite {
+	class CountTask : public Common::Task {
+	public:
+		CountTask(int &counter) : _counter(counter) {}
+		void run() override { _counter++; }
+
+	private:
+		int &_counter;
+	};
+
+	class LockedCountTask : public Common::Task {
+	public:
+		LockedCountTask(Common::Mutex &mutex, int &counter) : _mutex(mutex), _counter(counter) {}
+		void run() override {
+			Common::StackLock lock(_mutex);
+			_counter++;
+		}
+
+	private:
+		Common::Mutex &_mutex;
+		int &_counter;
+	};
+
+	// Waits for a nested group from within a task
+	class NestedTask : public Common::Task {
+	public:
+		NestedTask(Common::ThreadPool &pool, Common::Mutex &mutex, int &counter) : _pool(pool), _mutex(mutex), _counter(counter) {}
+		void run() override {
+			Common::TaskGroup group(_pool);
+			for (int i = 0; i < 10; i++)
+				group.run(new LockedCountTask(_mutex, _counter));
+			group.wait();
+		}
+
+	private:
+		Common::ThreadPool &_pool;
+		Common::Mutex &_mutex;
+		int &_counter;
+	};
+
+	class RangeBody : public Common::Functor2<int, int, void> {
+	public:
+		RangeBody(Common::Array<int> &hits) : _hits(hits) {}
+		bool isValid() const override { return true; }
+		void operator()(int first, int last) const override {
+			for (int i = first; i < last; i++)
+				_hits[i]++;
+		}
+
+	private:
+		Common::Array<int> &_hits;
+	};
+
+	int answer() { return 42; }
+
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		if (!g_system)
+			Common::install_null_g_system();
+#endif
+	}
+
+	void test_task_group() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool(0);
+		TS_ASSERT_EQUALS(pool.getNumWorkers(), 0u);
+
+		int counter = 0;
+		Common::TaskGroup group(pool);
+		for (int i = 0; i < 10; i++)
+			group.run(new CountTask(counter));
+		group.wait();
+
+		TS_ASSERT(group.isDone());
+		TS_ASSERT_EQUALS(counter, 10);
+		TS_ASSERT_EQUALS(pool.getStats().tasksInline, 10u);
+#endif
+	}
+
+	void test_future() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool(0);
+		Common::Future<int> result(pool, new Common::Functor0Mem<int, ThreadPoolTestSuite>(this, &ThreadPoolTestSuite::answer));
+		TS_ASSERT(result.isReady());
+		TS_ASSERT_EQUALS(result.get(), 42);
+#endif
+	}
+
+	void test_parallel_for() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool(0);
+		Common::Array<int> hits;
+		hits.resize(1000);
+		for (uint i = 0; i < hits.size(); i++)
+			hits[i] = 0;
+
+		RangeBody body(hits);
+		pool.parallelFor(0, 1000, 64, body);
+		pool.parallelFor(10, 10, 64, body);
+
+		for (uint i = 0; i < hits.size(); i++)
+			TS_ASSERT_EQUALS(hits[i], 1);
+#endif
+	}
+
+	void test_workers() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::ThreadPool pool(3);
+		if (!pool.getNumWorkers())
+			return;
+		TS_ASSERT_EQUALS(pool.getNumWorkers(), 3u);
+
+		Common::Mutex mutex;
+		int counter = 0;
+		{
+			Common::TaskGroup group(pool);
+			for (int i = 0; i < 1000; i++)
+				group.run(new LockedCountTask(mutex, counter));
+			group.wait();
+			TS_ASSERT(group.isDone());
+		}
+		TS_ASSERT_EQUALS(counter, 1000);
+
+		// Nested waits must not deadlock, even with more waiting tasks
+		// than workers
+		counter = 0;
+		{
+			Common::TaskGroup group(pool);
+			for (int i = 0; i < 20; i++)
+				group.run(new NestedTask(pool, mutex, counter));
+		}
+		TS_ASSERT_EQUALS(counter, 200);
+
+		Common::Array<int> hits;
+		hits.resize(10000);
+		for (uint i = 0; i < hits.size(); i++)
+			hits[i] = 0;
+
+		RangeBody body(hits);
+		pool.parallelFor(0, 10000, 16, body);
+		for (uint i = 0; i < hits.size(); i++)
+			TS_ASSERT_EQUALS(hits[i], 1);
+
+		Common::ThreadPool::Stats stats = pool.getStats();
+		TS_ASSERT_EQUALS(stats.tasksInline, 0u);
+		TS_ASSERT_EQUALS(stats.tasksRun + stats.tasksHelped, 1000u + 20u + 200u + 625u);
+#endif
+	}
+};
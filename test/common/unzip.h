@@ -0,0 +1,257 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/unzip.h"
+#include "../null_osystem.h"
+
+// Archive with "stored.txt" (stored), "small.txt" (deflated) and "big.bin"
+// (deflated, 1 MB + 4 KB of ((i >> 12) + (i & 3)) & 0xff)
+static const byte zipData[] = {
+	0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xab, 0xb0,
+	0x04, 0xeb, 0x15, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x73, 0x74,
+	0x6f, 0x72, 0x65, 0x64, 0x2e, 0x74, 0x78, 0x74, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x73,
+	0x74, 0x6f, 0x72, 0x65, 0x64, 0x20, 0x6d, 0x65, 0x6d, 0x62, 0x65, 0x72, 0x21, 0x50, 0x4b, 0x03,
+	0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0x31, 0x39, 0x20, 0xb9, 0x1f,
+	0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x73, 0x6d, 0x61, 0x6c, 0x6c,
+	0x2e, 0x74, 0x78, 0x74, 0xf3, 0x48, 0xcd, 0xc9, 0xc9, 0xd7, 0x51, 0x48, 0x49, 0x4d, 0xcb, 0x49,
+	0x2c, 0x49, 0x4d, 0x51, 0xc8, 0x4d, 0xcd, 0x4d, 0x4a, 0x2d, 0x52, 0x54, 0xf0, 0x18, 0x15, 0x1f,
+	0x16, 0xe2, 0x00, 0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21,
+	0x00, 0x7e, 0x72, 0x6f, 0x21, 0xd4, 0x06, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00, 0x07, 0x00, 0x00,
+	0x00, 0x62, 0x69, 0x67, 0x2e, 0x62, 0x69, 0x6e, 0xed, 0xc3, 0x83, 0x12, 0x20, 0x86, 0x01, 0x05,
+	0xc0, 0xbb, 0x5c, 0xd4, 0xa8, 0x41, 0x63, 0xb4, 0xb1, 0x6d, 0x37, 0x46, 0x63, 0xdb, 0xb6, 0x6d,
+	0xdb, 0x68, 0x6c, 0xdb, 0xb6, 0x6d, 0xdb, 0xb6, 0x9d, 0xf7, 0x1d, 0x6f, 0x76, 0x66, 0x77, 0xc0,
+	0xc0, 0xc1, 0x06, 0x0d, 0x50, 0x55, 0x55, 0x55, 0xab, 0xc7, 0xe0, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7,
+	0x18, 0x42, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x43, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x28, 0x55,
+	0x55, 0x55, 0xb5, 0x7b, 0x0c, 0xad, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x7f, 0xa8, 0xaa, 0xaa, 0xaa,
+	0xdd, 0x63, 0x18, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x0c, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xe1,
+	0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xbc, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x46, 0x50, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0x3f, 0x55, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xa2, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0x46, 0x52, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xc8, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x45, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0xff, 0x52, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xa8, 0xaa, 0xaa, 0xaa, 0x6a,
+	0xf7, 0x18, 0x4d, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xa3, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x0c,
+	0x55, 0x55, 0x55, 0xb5, 0x7b, 0x8c, 0xa9, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xb1, 0x54, 0x55, 0x55,
+	0xd5, 0xee, 0x31, 0xb6, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xc6, 0x51, 0x55, 0x55, 0x55, 0xbb, 0xc7,
+	0xb8, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x18, 0x4f, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xff, 0x56, 0x55,
+	0x55, 0x55, 0xbb, 0xc7, 0x7f, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xbe, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0x26, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x84, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x48,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0x13, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x12, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0x4c, 0xaa, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xc9, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31,
+	0xb9, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xa6, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x94, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0x98, 0x4a, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x53, 0xab, 0xaa, 0xaa, 0xaa, 0xdd,
+	0x63, 0x1a, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x4c, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xe9, 0x54,
+	0x55, 0x55, 0xd5, 0xee, 0x31, 0xbd, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x66, 0x50, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0x8c, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x49, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x33,
+	0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x16, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xcc, 0xaa, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0xd9, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x31, 0xbb, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0xe6, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x9c, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x98, 0x4b, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0x73, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x1e, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0xcc, 0xab, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xff, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x3e,
+	0x55, 0x55, 0x55, 0xb5, 0x7b, 0xcc, 0xaf, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x05, 0x54, 0x55, 0x55,
+	0xd5, 0xee, 0xb1, 0xa0, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x16, 0x52, 0x55, 0x55, 0x55, 0xbb, 0xc7,
+	0xc2, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x44, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x8b, 0xaa, 0xaa,
+	0xaa, 0xaa, 0xdd, 0x63, 0x31, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x2c, 0xae, 0xaa, 0xaa, 0xaa, 0x76,
+	0x8f, 0xff, 0xa9, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x09, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x2c, 0xa9,
+	0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xa5, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xb4, 0xaa, 0xaa, 0xaa,
+	0xda, 0x3d, 0x96, 0x51, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xb2, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58,
+	0x4e, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xcb, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x05, 0x55, 0x55,
+	0x55, 0xb5, 0x7b, 0xac, 0xa8, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x95, 0x54, 0x55, 0x55, 0xd5, 0xee,
+	0xb1, 0xb2, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x56, 0x51, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xaa, 0xaa,
+	0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x4d, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xab, 0xab, 0xaa, 0xaa, 0xaa,
+	0xdd, 0x63, 0x0d, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xac, 0xa9, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xb5,
+	0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xb6, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xd6, 0x51, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0xba, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x58, 0x4f, 0x55, 0x55, 0x55, 0xed, 0x1e,
+	0xeb, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x03, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x6c, 0xa8, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0x8d, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xb1, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0x36, 0x51, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xa6, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x4c,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0x9b, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x0b, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0x6c, 0xa9, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xad, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1,
+	0xb5, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xb6, 0x51, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xb6, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0xd8, 0x4e, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xdb, 0xab, 0xaa, 0xaa, 0xaa, 0xdd,
+	0x63, 0x07, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xec, 0xa8, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x9d, 0x54,
+	0x55, 0x55, 0xd5, 0xee, 0xb1, 0xb3, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x76, 0x51, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0xae, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x4d, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xbb,
+	0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0x63, 0x0f, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xec, 0xa9, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0xbd, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xb1, 0xb7, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0xf6, 0x51, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xbe, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xd8, 0x4f, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0xfb, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x00, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0x1c, 0xa8, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x83, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xb0,
+	0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x0e, 0x51, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xa1, 0xaa, 0xaa, 0xaa,
+	0x6a, 0xf7, 0x38, 0x4c, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x87, 0xab, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3,
+	0x08, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x1c, 0xa9, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0xa3, 0x54, 0x55,
+	0x55, 0xd5, 0xee, 0x71, 0xb4, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x8e, 0x51, 0x55, 0x55, 0x55, 0xbb,
+	0xc7, 0xb1, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x38, 0x4e, 0x55, 0x55, 0x55, 0xed, 0x1e, 0xc7, 0xab,
+	0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x04, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x9c, 0xa8, 0xaa, 0xaa, 0xaa,
+	0x76, 0x8f, 0x93, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xb2, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xfe,
+	0xaf, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x53, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xaa, 0xaa, 0xaa,
+	0xaa, 0xda, 0x3d, 0x4e, 0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xe9, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7,
+	0x38, 0x43, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x67, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x2c, 0x55,
+	0x55, 0x55, 0xb5, 0x7b, 0x9c, 0xad, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x73, 0x54, 0x55, 0x55, 0xd5,
+	0xee, 0x71, 0xae, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xce, 0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xf9,
+	0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x40, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x17, 0xaa, 0xaa, 0xaa,
+	0xaa, 0xdd, 0xe3, 0x22, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x5c, 0xac, 0xaa, 0xaa, 0xaa, 0x76, 0x8f,
+	0x4b, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xa9, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x2e, 0x53, 0x55,
+	0x55, 0x55, 0xbb, 0xc7, 0xe5, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x42, 0x55, 0x55, 0x55, 0xed,
+	0x1e, 0x57, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x2a, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x5c, 0xad,
+	0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x6b, 0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xad, 0xaa, 0xaa, 0xaa,
+	0xda, 0x3d, 0xae, 0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xf5, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xb8,
+	0x41, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x37, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x26, 0x55, 0x55,
+	0x55, 0xb5, 0x7b, 0xdc, 0xac, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x5b, 0x54, 0x55, 0x55, 0xd5, 0xee,
+	0x71, 0xab, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x6e, 0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xed, 0xaa,
+	0xaa, 0xaa, 0x6a, 0xf7, 0xb8, 0x43, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x77, 0xaa, 0xaa, 0xaa, 0xaa,
+	0xdd, 0xe3, 0x2e, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xdc, 0xad, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x7b,
+	0x54, 0x55, 0x55, 0xd5, 0xee, 0x71, 0xaf, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xee, 0x53, 0x55, 0x55,
+	0x55, 0xbb, 0xc7, 0xfd, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x40, 0x55, 0x55, 0x55, 0xed, 0x1e,
+	0x0f, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x21, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x3c, 0xac, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0x47, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0xa8, 0xaa, 0xaa, 0xaa, 0xda,
+	0x3d, 0x1e, 0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xe3, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x42,
+	0x55, 0x55, 0x55, 0xed, 0x1e, 0x4f, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x29, 0x55, 0x55, 0x55,
+	0xb5, 0x7b, 0x3c, 0xad, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x67, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1,
+	0xac, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x9e, 0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xf3, 0xaa, 0xaa,
+	0xaa, 0x6a, 0xf7, 0x78, 0x41, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x2f, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd,
+	0xe3, 0x25, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xbc, 0xac, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x57, 0x54,
+	0x55, 0x55, 0xd5, 0xee, 0xf1, 0xaa, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x5e, 0x53, 0x55, 0x55, 0x55,
+	0xbb, 0xc7, 0xeb, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0x78, 0x43, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x6f,
+	0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x2d, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xbc, 0xad, 0xaa, 0xaa,
+	0xaa, 0x76, 0x8f, 0x77, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0xae, 0xaa, 0xaa, 0xaa, 0xda, 0x3d,
+	0xde, 0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xfb, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x40, 0x55,
+	0x55, 0x55, 0xed, 0x1e, 0x1f, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x23, 0x55, 0x55, 0x55, 0xb5,
+	0x7b, 0x7c, 0xac, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x4f, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0xa9,
+	0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x3e, 0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xe7, 0xaa, 0xaa, 0xaa,
+	0x6a, 0xf7, 0xf8, 0x42, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x5f, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3,
+	0x2b, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x7c, 0xad, 0xaa, 0xaa, 0xaa, 0x76, 0x8f, 0x6f, 0x54, 0x55,
+	0x55, 0xd5, 0xee, 0xf1, 0xad, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0xbe, 0x53, 0x55, 0x55, 0x55, 0xbb,
+	0xc7, 0xf7, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x41, 0x55, 0x55, 0x55, 0xed, 0x1e, 0x3f, 0xaa,
+	0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x27, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0xfc, 0xac, 0xaa, 0xaa, 0xaa,
+	0x76, 0x8f, 0x5f, 0x54, 0x55, 0x55, 0xd5, 0xee, 0xf1, 0xab, 0xaa, 0xaa, 0xaa, 0xda, 0x3d, 0x7e,
+	0x53, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0xef, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xf8, 0x43, 0x55, 0x55,
+	0x55, 0xed, 0x1e, 0x7f, 0xaa, 0xaa, 0xaa, 0xaa, 0xdd, 0xe3, 0x2f, 0x55, 0x55, 0x55, 0xb5, 0x7b,
+	0x0c, 0x50, 0x55, 0x55, 0x55, 0xbb, 0xc7, 0x40, 0x55, 0x55, 0x55, 0xb5, 0x7b, 0x0c, 0xa6, 0xaa,
+	0xaa, 0xaa, 0x76, 0x8f, 0x41, 0xaa, 0xaa, 0xaa, 0x6a, 0xf7, 0xbf, 0x01, 0x50, 0x4b, 0x01, 0x02,
+	0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xab, 0xb0, 0x04, 0xeb,
+	0x15, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64,
+	0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00,
+	0x00, 0x00, 0x21, 0x00, 0x31, 0x39, 0x20, 0xb9, 0x1f, 0x00, 0x00, 0x00, 0xe0, 0x01, 0x00, 0x00,
+	0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x3d, 0x00,
+	0x00, 0x00, 0x73, 0x6d, 0x61, 0x6c, 0x6c, 0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b, 0x01, 0x02, 0x14,
+	0x03, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0x7e, 0x72, 0x6f, 0x21, 0xd4,
+	0x06, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x80, 0x01, 0x83, 0x00, 0x00, 0x00, 0x62, 0x69, 0x67, 0x2e, 0x62, 0x69, 0x6e,
+	0x50, 0x4b, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0xa4, 0x00, 0x00, 0x00,
+	0x7c, 0x07, 0x00, 0x00, 0x00, 0x00,};
+
+static const uint32 bigSize = 1024 * 1024 + 4096;
+
+static byte bigByte(uint32 pos) {
+	return ((pos >> 12) + (pos & 3)) & 0xff;
+}
+
+class ZipArchiveTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		if (!g_system)
+			Common::install_null_g_system();
+#endif
+	}
+
+	void test_stored_member() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::Archive *archive = Common::makeZipArchive(new Common::MemoryReadStream(zipData, sizeof(zipData)));
+		TS_ASSERT(archive);
+
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("stored.txt");
+		TS_ASSERT(stream);
+
+		// Member streams outlive the archive
+		delete archive;
+
+		TS_ASSERT_EQUALS(stream->size(), 21);
+		TS_ASSERT_EQUALS(stream->readLine(), "Hello, stored member!");
+		delete stream;
+#endif
+	}
+
+	void test_stored_member_bytewise() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::Archive *archive = Common::makeZipArchive(new Common::MemoryReadStream(zipData, sizeof(zipData)));
+		Common::SeekableReadStream *stream1 = archive->createReadStreamForMember("stored.txt");
+		Common::SeekableReadStream *stream2 = archive->createReadStreamForMember("stored.txt");
+
+		// Interleaved reads through the buffers of two cursors
+		static const char text[] = "Hello, stored member!";
+		for (int i = 0; i < 21; i++) {
+			TS_ASSERT_EQUALS(stream1->readByte(), (byte)text[i]);
+			TS_ASSERT_EQUALS(stream2->readByte(), (byte)text[i]);
+		}
+		TS_ASSERT(!stream1->eos());
+		stream1->readByte();
+		TS_ASSERT(stream1->eos());
+		TS_ASSERT(!stream1->err());
+
+		TS_ASSERT(stream1->seek(7));
+		TS_ASSERT_EQUALS(stream1->readByte(), (byte)'s');
+		TS_ASSERT(stream2->seek(-7, SEEK_END));
+		TS_ASSERT_EQUALS(stream2->readByte(), (byte)'m');
+
+		delete stream1;
+		delete stream2;
+		delete archive;
+#endif
+	}
+
+	void test_independent_members() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(USE_ZLIB)
+		Common::Archive *archive = Common::makeZipArchive(new Common::MemoryReadStream(zipData, sizeof(zipData)));
+		TS_ASSERT(archive);
+
+		Common::SeekableReadStream *small1 = archive->createReadStreamForMember("small.txt");
+		Common::SeekableReadStream *small2 = archive->createReadStreamForMember("small.txt");
+		Common::SeekableReadStream *stored = archive->createReadStreamForMember("stored.txt");
+
+		char buf1[8], buf2[8];
+		TS_ASSERT_EQUALS(small1->read(buf1, 7), 7u);
+		TS_ASSERT_EQUALS(stored->read(buf2, 7), 7u);
+		TS_ASSERT_EQUALS(small2->read(buf2, 7), 7u);
+		TS_ASSERT_EQUALS(small1->read(buf1, 8), 8u);
+		TS_ASSERT(!memcmp(buf1, "deflated", 8));
+		TS_ASSERT(!memcmp(buf2, "Hello, ", 7));
+
+		delete small1;
+		delete small2;
+		delete stored;
+		delete archive;
+#endif
+	}
+
+	void test_seek_large_member() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(USE_ZLIB)
+		Common::Archive *archive = Common::makeZipArchive(new Common::MemoryReadStream(zipData, sizeof(zipData)));
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("big.bin");
+		TS_ASSERT_EQUALS(stream->size(), (int64)bigSize);
+
+		// Reading through the whole member verifies the CRC
+		byte buf[4096];
+		uint32 total = 0;
+		while (uint32 actualSize = stream->read(buf, sizeof(buf))) {
+			for (uint32 i = 0; i < actualSize; i += 1021)
+				TS_ASSERT_EQUALS(buf[i], bigByte(total + i));
+			total += actualSize;
+		}
+		TS_ASSERT_EQUALS(total, bigSize);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!stream->err());
+
+		static const uint32 positions[] = { 700000, 5, 1000001, 262144, 262143, bigSize - 1, 300000 };
+		for (uint i = 0; i < ARRAYSIZE(positions); i++) {
+			TS_ASSERT(stream->seek(positions[i]));
+			TS_ASSERT_EQUALS(stream->pos(), (int64)positions[i]);
+			TS_ASSERT_EQUALS(stream->readByte(), bigByte(positions[i]));
+		}
+
+		delete stream;
+		delete archive;
+#endif
+	}
+};
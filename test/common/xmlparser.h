@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/xmlparser.h"
+#include "../null_osystem.h"
+
+class TestXMLParser : public Common::XMLParser {
+public:
+	Common::String _log;
+
+protected:
+	CUSTOM_XML_PARSER(TestXMLParser) {
+		XML_KEY(layout)
+			XML_PROP(name, true)
+			XML_KEY(widget)
+				XML_PROP(name, true)
+				XML_PROP(width, false)
+			KEY_END()
+		KEY_END()
+	} PARSER_END()
+
+	bool parserCallback_layout(ParserNode *node) {
+		_log += "layout:" + node->values["name"] + ";";
+		return true;
+	}
+
+	bool parserCallback_widget(ParserNode *node) {
+		_log += "widget:" + node->values["name"];
+		if (node->values.contains("width"))
+			_log += "," + node->values["width"];
+		_log += ";";
+		return true;
+	}
+
+	bool closedKeyCallback(ParserNode *node) override {
+		_log += "/" + node->name + ";";
+		return true;
+	}
+};
+
+class XMLParserTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		if (!g_system)
+			Common::install_null_g_system();
+#endif
+	}
+
+	void test_compiled_replay() {
+		static const char *const documents[] = {
+			"<?xml version = '1.0'?><layout name = 'first'><widget name = 'a' width = '10'/><widget name = 'b'/></layout>",
+			"<?xml version = '1.0'?><layout name = 'second'></layout>"
+		};
+
+		Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+		TestXMLParser parser;
+		parser.setCompileStream(&compiled);
+		for (uint i = 0; i < ARRAYSIZE(documents); i++) {
+			TS_ASSERT(parser.loadBuffer((const byte *)documents[i], strlen(documents[i])));
+			TS_ASSERT(parser.parse());
+			parser.close();
+		}
+		parser.setCompileStream(nullptr);
+
+		TestXMLParser replay;
+		Common::MemoryReadStream stream(compiled.getData(), compiled.size());
+		TS_ASSERT(replay.parseCompiled(stream));
+		TS_ASSERT(replay.parseCompiled(stream));
+		TS_ASSERT_EQUALS(stream.pos(), stream.size());
+		TS_ASSERT_EQUALS(replay._log, parser._log);
+		TS_ASSERT_EQUALS(replay._log, Common::String("/xml;layout:first;widget:a,10;/widget;widget:b;/widget;/layout;/xml;layout:second;/layout;"));
+	}
+
+	void test_compiled_truncated() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		static const char document[] = "<?xml version = '1.0'?><layout name = 'first'><widget name = 'a'/></layout>";
+
+		Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+		TestXMLParser parser;
+		parser.setCompileStream(&compiled);
+		TS_ASSERT(parser.loadBuffer((const byte *)document, strlen(document)));
+		TS_ASSERT(parser.parse());
+		parser.close();
+
+		TestXMLParser replay;
+		Common::MemoryReadStream stream(compiled.getData(), compiled.size() - 1);
+		TS_ASSERT(!replay.parseCompiled(stream));
+#endif
+	}
+};
@@ -0,0 +1,49 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+class ZlibTestSuite : public CxxTest::TestSuite {
+	static byte dataByte(uint32 pos) {
+		return ((pos >> 10) ^ (pos * 7)) & 0xff;
+	}
+
+public:
+	void test_gzip_seek() {
+#ifdef USE_ZLIB
+		// Large enough for the inflate state to be checkpointed
+		const uint32 size = 3 * 1024 * 1024;
+
+		Common::MemoryWriteStreamDynamic *compressed = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *writer = Common::wrapCompressedWriteStream(compressed);
+		byte buf[4096];
+		for (uint32 pos = 0; pos < size; pos += sizeof(buf)) {
+			for (uint32 i = 0; i < sizeof(buf); i++)
+				buf[i] = dataByte(pos + i);
+			writer->write(buf, sizeof(buf));
+		}
+		writer->finalize();
+
+		Common::SeekableReadStream *reader = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(compressed->getData(), compressed->size(), DisposeAfterUse::YES));
+		delete writer;
+
+		TS_ASSERT(reader);
+		TS_ASSERT_EQUALS(reader->size(), (int64)size);
+
+		static const uint32 positions[] = { 2000000, 10, 3000000, 1048576, 1048575, size - 1, 0, 2500000, 1500000 };
+		for (uint i = 0; i < ARRAYSIZE(positions); i++) {
+			TS_ASSERT(reader->seek(positions[i]));
+			TS_ASSERT_EQUALS(reader->pos(), (int64)positions[i]);
+			TS_ASSERT_EQUALS(reader->readByte(), dataByte(positions[i]));
+		}
+
+		TS_ASSERT(reader->seek(size - 100));
+		TS_ASSERT_EQUALS(reader->read(buf, sizeof(buf)), 100u);
+		TS_ASSERT(reader->eos());
+		TS_ASSERT(!reader->err());
+
+		delete reader;
+#endif
+	}
+};
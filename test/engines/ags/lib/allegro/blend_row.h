@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/ags/lib/allegro/blend_row.h"
+#include "engines/ags/lib/allegro/surface.h"
+
+/**
+ * Test suite for the row kernels in engines/ags/lib/allegro/blend_row.cpp
+ *
+ * Every kernel must produce the same pixels as the per pixel blender of
+ * BITMAP for its mode, as used by BITMAP::draw().
+ */
+class AGSBlendRowTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 37,
+		kTransColor = 0x00FF00FF,   // Magenta, without alpha
+		kAlphaMask = 0x00FFFFFF
+	};
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed;
+	}
+
+	static void blendPixel(AGS3::BlenderMode mode, uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc,
+	                       uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) {
+		switch (mode) {
+		case AGS3::kSourceAlphaBlender:
+			AGS3::BITMAP::blendSourceAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case AGS3::kArgbToRgbBlender:
+			AGS3::BITMAP::blendArgbToRgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case AGS3::kRgbToRgbBlender:
+			AGS3::BITMAP::blendRgbToRgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case AGS3::kAlphaPreservedBlenderMode:
+			AGS3::BITMAP::blendPreserveAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case AGS3::kOpaqueBlenderMode:
+			AGS3::BITMAP::blendOpaque(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case AGS3::kAdditiveBlenderMode:
+			AGS3::BITMAP::blendAdditiveAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		default:
+			TS_FAIL("No per pixel blender for the mode");
+			break;
+		}
+	}
+
+	// Same as the per pixel loop of BITMAP::draw() for 32-bit ARGB bitmaps
+	static void blendRowPerPixel(AGS3::BlenderMode mode, uint32 *destP, const uint32 *srcP, int count,
+	                             int xDir, bool skipTrans, uint32 alpha) {
+		for (int x = 0; x < count; ++x) {
+			uint32 srcCol = srcP[x * xDir];
+			if (skipTrans && (srcCol & kAlphaMask) == kTransColor)
+				continue;
+
+			uint32 destCol = destP[x];
+			uint8 aDest = destCol >> 24, rDest = destCol >> 16, gDest = destCol >> 8, bDest = destCol;
+			blendPixel(mode, srcCol >> 24, srcCol >> 16, srcCol >> 8, srcCol, aDest, rDest, gDest, bDest, alpha);
+			destP[x] = ((uint32)aDest << 24) | ((uint32)rDest << 16) | ((uint32)gDest << 8) | bDest;
+		}
+	}
+
+public:
+	void test_kernels_match_blenders() {
+		uint32 src[kWidth];
+		uint32 seed = 12345;
+		for (int x = 0; x < kWidth; ++x) {
+			// Every fifth pixel is the transparent color, with some alpha
+			src[x] = nextRandom(seed);
+			if (x % 5 == 0)
+				src[x] = (src[x] & 0xFF000000) | kTransColor;
+		}
+
+		const AGS3::BlenderMode modes[] = { AGS3::kRgbToRgbBlender, AGS3::kAlphaPreservedBlenderMode,
+		                                    AGS3::kArgbToRgbBlender, AGS3::kSourceAlphaBlender,
+		                                    AGS3::kOpaqueBlenderMode, AGS3::kAdditiveBlenderMode };
+		const uint32 alphas[] = { 0, 1, 127, 254, 255 };
+
+		for (int m = 0; m < ARRAYSIZE(modes); ++m) {
+			for (int a = 0; a < ARRAYSIZE(alphas); ++a) {
+				for (int flags = 0; flags < 4; ++flags) {
+					const bool horizFlip = (flags & 1) != 0;
+					const bool skipTrans = (flags & 2) != 0;
+
+					uint32 expected[kWidth], dest[kWidth];
+					for (int x = 0; x < kWidth; ++x)
+						expected[x] = dest[x] = nextRandom(seed);
+
+					// A flipped row is read backwards from its last pixel
+					const uint32 *srcP = horizFlip ? src + kWidth - 1 : src;
+					const int xDir = horizFlip ? -1 : 1;
+
+					AGS3::BlendRow32 blendRow = AGS3::getBlendRow32(modes[m], skipTrans);
+					TS_ASSERT(blendRow != nullptr);
+					if (!blendRow)
+						continue;
+
+					blendRowPerPixel(modes[m], expected, srcP, kWidth, xDir, skipTrans, alphas[a]);
+					blendRow(dest, srcP, kWidth, xDir, kTransColor, kAlphaMask, alphas[a]);
+					for (int x = 0; x < kWidth; ++x)
+						TS_ASSERT_EQUALS(dest[x], expected[x]);
+				}
+			}
+		}
+	}
+
+	void test_no_kernel() {
+		// These modes are only handled per pixel
+		TS_ASSERT(!AGS3::getBlendRow32(AGS3::kArgbToArgbBlender, false));
+		TS_ASSERT(!AGS3::getBlendRow32(AGS3::kRgbToArgbBlender, true));
+		TS_ASSERT(!AGS3::getBlendRow32(AGS3::kTintBlenderMode, false));
+		TS_ASSERT(!AGS3::getBlendRow32(AGS3::kTintLightBlenderMode, false));
+	}
+};
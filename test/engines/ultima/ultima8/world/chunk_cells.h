@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/ultima/ultima8/world/chunk_cells.h"
+
+/**
+ * Test suite for the ChunkCells class in engines/ultima/ultima8/world/chunk_cells.h
+ */
+class U8ChunkCellsTestSuite : public CxxTest::TestSuite {
+	typedef Ultima::Ultima8::ChunkCells<int> Cells;
+
+	int _items[8];
+
+	public:
+	U8ChunkCellsTestSuite() {
+		for (int i = 0; i < 8; i++)
+			_items[i] = i;
+	}
+
+	/* Collect the item numbers in iteration order, e.g. 3,1,2 -> 312 */
+	int iterate(const Cells &cells, uint16 mask) {
+		Cells::Iterator iter(&cells, mask);
+		int result = 0;
+		for (int *item = iter.next(); item; item = iter.next())
+			result = result * 10 + *item;
+		return result;
+	}
+
+	/* Iterating over several cells gives the order they were added in */
+	void test_order() {
+		Cells cells;
+		cells.addToEnd(&_items[1], 0, 0);
+		cells.addToFront(&_items[2], 5, 0);
+		cells.addToEnd(&_items[3], 5, 0);
+		cells.addToFront(&_items[4], 0, 0);
+		cells.addToEnd(&_items[5], 15, 0);
+
+		TS_ASSERT_EQUALS(iterate(cells, 0xFFFF), 42135);
+		TS_ASSERT_EQUALS(iterate(cells, 1 << 0), 41);
+		TS_ASSERT_EQUALS(iterate(cells, 1 << 5), 23);
+		TS_ASSERT_EQUALS(iterate(cells, (1 << 5) | (1 << 15)), 235);
+		TS_ASSERT_EQUALS(iterate(cells, 1 << 1), 0);
+
+		Cells::Iterator empty(nullptr, 0xFFFF);
+		TS_ASSERT(!empty.next());
+	}
+
+	/* Moving an item to another cell keeps its place in the order */
+	void test_update() {
+		Cells cells;
+		cells.addToEnd(&_items[1], 0, 0);
+		cells.addToEnd(&_items[2], 1, 0);
+		cells.addToEnd(&_items[3], 2, 0);
+
+		TS_ASSERT(cells.update(&_items[3], 2, 0, 0));
+		TS_ASSERT(cells.update(&_items[1], 0, 1, 0));
+		TS_ASSERT_EQUALS(iterate(cells, 1 << 0), 3);
+		TS_ASSERT_EQUALS(iterate(cells, 1 << 1), 12);
+		TS_ASSERT_EQUALS(iterate(cells, 0xFFFF), 123);
+
+		// Found in another cell than expected
+		TS_ASSERT(cells.update(&_items[2], 3, 2, 0));
+		TS_ASSERT_EQUALS(iterate(cells, 1 << 2), 2);
+
+		TS_ASSERT(!cells.update(&_items[4], 0, 1, 0));
+	}
+
+	void test_remove() {
+		Cells cells;
+		cells.addToEnd(&_items[1], 0, 0);
+		cells.addToEnd(&_items[2], 3, 0);
+
+		TS_ASSERT(cells.remove(&_items[1], 0));
+		TS_ASSERT(!cells.remove(&_items[1], 0));
+		TS_ASSERT(!cells.empty());
+		// Found in another cell than expected
+		TS_ASSERT(cells.remove(&_items[2], 0));
+		TS_ASSERT(cells.empty());
+		TS_ASSERT_EQUALS(iterate(cells, 0xFFFF), 0);
+	}
+
+	/* Cells are selected by their location and the footpads of their items */
+	void test_area_cells() {
+		Cells cells;
+		// Cells are 128 units, so cell 5 holds locations 128-255 in x and y
+		cells.addToEnd(&_items[1], 5, 32);
+		cells.addToEnd(&_items[2], 15, 0);
+
+		// Empty cells are never selected
+		TS_ASSERT_EQUALS(cells.getAreaCells(0, 0, 511, 511, 128), (1 << 5) | (1 << 15));
+
+		// Areas after the cell
+		TS_ASSERT_EQUALS(cells.getAreaCells(255, 255, 300, 300, 128), 1 << 5);
+		TS_ASSERT_EQUALS(cells.getAreaCells(256, 0, 300, 300, 128), 0);
+		TS_ASSERT_EQUALS(cells.getAreaCells(0, 256, 300, 300, 128), 0);
+
+		// Areas before the cell, which the footpads can reach
+		TS_ASSERT_EQUALS(cells.getAreaCells(0, 0, 96, 200, 128), 1 << 5);
+		TS_ASSERT_EQUALS(cells.getAreaCells(0, 0, 95, 200, 128), 0);
+		TS_ASSERT_EQUALS(cells.getAreaCells(0, 0, 200, 95, 128), 0);
+
+		// Larger footpads and areas outside the chunk
+		TS_ASSERT(cells.update(&_items[2], 15, 15, 200));
+		TS_ASSERT_EQUALS(cells.getAreaCells(-100, -100, 184, 184, 128), (1 << 5) | (1 << 15));
+		TS_ASSERT_EQUALS(cells.getAreaCells(600, 600, 700, 700, 128), 0);
+
+		// The footpad is forgotten when the cell is empty
+		TS_ASSERT(cells.remove(&_items[1], 5));
+		cells.addToEnd(&_items[1], 5, 0);
+		TS_ASSERT_EQUALS(cells.getAreaCells(0, 0, 127, 200, 128), 0);
+	}
+};
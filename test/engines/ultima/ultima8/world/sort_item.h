@@ -74,6 +74,29 @@ class U8SortItemTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT(!si2.below(si1));
 	}
 
+	/* The display list is ordered by z, flats first, and then in the order items were added */
+	void test_list_order() {
+		Ultima::Ultima8::SortItem si1(nullptr);
+		Ultima::Ultima8::SortItem si2(nullptr);
+
+		si1._addOrder = 1;
+		si2._addOrder = 0;
+		si1._z = 0;
+		si2._z = 10;
+		TS_ASSERT(si1.ListBefore(&si2));
+		TS_ASSERT(!si2.ListBefore(&si1));
+
+		si2._z = 0;
+		si1._flat = true;
+		TS_ASSERT(si1.ListBefore(&si2));
+		TS_ASSERT(!si2.ListBefore(&si1));
+
+		si2._flat = true;
+		TS_ASSERT(si2.ListBefore(&si1));
+		TS_ASSERT(!si1.ListBefore(&si2));
+		TS_ASSERT(!si1.ListBefore(&si1));
+	}
+
 	/* Overlapping flat items (generally the floor) follow a set of rules */
 	void test_flat_sort() {
 		Ultima::Ultima8::SortItem si1(nullptr);
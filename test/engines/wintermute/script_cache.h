@@ -0,0 +1,241 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/wintermute/base/scriptables/script_cache.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+
+/**
+ * Test suite for the script inline caches in
+ * engines/wintermute/base/scriptables/script_cache.h
+ *
+ * TestValue mimics how ScValue maintains its layout id: a new one on
+ * construction and whenever a property is added or removed. Natives and
+ * strings only take assignments through their setter, like ScValue does
+ * with scSetProperty().
+ */
+class ScriptCacheTestSuite : public CxxTest::TestSuite {
+	struct TestValue {
+		TestValue() : layoutId(Wintermute::scNextLayoutId()), _type(Wintermute::VAL_OBJECT), _valRef(nullptr),
+		              value(0), setterCalls(0) {}
+
+		uint32 getLayoutId() const { return layoutId; }
+
+		TestValue *getOwnProp(const char *name) {
+			PropMap::iterator it = props.find(name);
+			return it != props.end() ? it->_value : nullptr;
+		}
+		void setProp(const char *name, TestValue *val) {
+			if (_type == Wintermute::VAL_VARIABLE_REF) {
+				_valRef->setProp(name, val);
+				return;
+			}
+			if (_type == Wintermute::VAL_NATIVE || _type == Wintermute::VAL_STRING) {
+				value = val->value;
+				setterCalls++;
+				return;
+			}
+			if (!props.contains(name)) {
+				layoutId = Wintermute::scNextLayoutId();
+			}
+			props[name] = val;
+		}
+		void deleteProp(const char *name) {
+			if (props.contains(name)) {
+				props.erase(name);
+				layoutId = Wintermute::scNextLayoutId();
+			}
+		}
+
+		typedef Common::HashMap<Common::String, TestValue *> PropMap;
+		PropMap props;
+		uint32 layoutId;
+		Wintermute::TValType _type;
+		TestValue *_valRef;
+		int value;
+		int setterCalls;
+	};
+
+	// Same shape as ScScript::getVarCached(): search scope, then globals,
+	// then engine globals, and only do so on a cache miss
+	static TestValue *getVarCached(Wintermute::ScVarCacheEntry<TestValue> &entry, const char *name,
+	                               TestValue *scope, TestValue *globals, TestValue *engineGlobals, int &lookups) {
+		if (entry.matches(scope, globals, engineGlobals)) {
+			return entry.value;
+		}
+
+		lookups++;
+		TestValue *ret = scope ? scope->getOwnProp(name) : nullptr;
+		if (!ret) {
+			ret = globals->getOwnProp(name);
+		}
+		if (!ret) {
+			ret = engineGlobals->getOwnProp(name);
+		}
+		entry.store(scope, globals, engineGlobals, ret);
+		return ret;
+	}
+
+	// Same shape as ScScript::setPropCached(), which runs II_POP_BY_EXP
+	static void setPropCached(Wintermute::ScPropCacheEntry<TestValue> &entry, TestValue *var, const char *name,
+	                          TestValue *val, int &lookups) {
+		TestValue *owner = Wintermute::scCacheableObject(var);
+		TestValue *prop = nullptr;
+		if (owner) {
+			if (!entry.matches(owner, name)) {
+				lookups++;
+				entry.store(owner, name, owner->getOwnProp(name));
+			}
+			prop = entry.value;
+		}
+
+		if (prop) {
+			prop->value = val->value;
+		} else {
+			var->setProp(name, val);
+		}
+	}
+
+	static void makeRef(TestValue &ref, TestValue &target) {
+		ref._type = Wintermute::VAL_VARIABLE_REF;
+		ref._valRef = &target;
+	}
+
+	public:
+	void test_layout_ids() {
+		TestValue a;
+		TestValue b;
+		TestValue c;
+
+		TS_ASSERT_DIFFERS(a.getLayoutId(), 0u);
+		TS_ASSERT_DIFFERS(a.getLayoutId(), b.getLayoutId());
+		TS_ASSERT_DIFFERS(b.getLayoutId(), c.getLayoutId());
+
+		uint32 layout = a.getLayoutId();
+		a.setProp("x", &b);
+		TS_ASSERT_DIFFERS(a.getLayoutId(), layout);
+
+		// Assigning to an existing property keeps the layout
+		layout = a.getLayoutId();
+		a.setProp("x", &c);
+		TS_ASSERT_EQUALS(a.getLayoutId(), layout);
+	}
+
+	void test_var_cache_hit() {
+		TestValue scope, globals, engineGlobals, x;
+		globals.setProp("x", &x);
+
+		Wintermute::ScVarCacheEntry<TestValue> entry;
+		int lookups = 0;
+		TS_ASSERT_EQUALS(getVarCached(entry, "x", &scope, &globals, &engineGlobals, lookups), &x);
+		TS_ASSERT_EQUALS(getVarCached(entry, "x", &scope, &globals, &engineGlobals, lookups), &x);
+		TS_ASSERT_EQUALS(lookups, 1);
+
+		// Without a scope, as in the script's top level code
+		Wintermute::ScVarCacheEntry<TestValue> topEntry;
+		TS_ASSERT_EQUALS(getVarCached(topEntry, "x", nullptr, &globals, &engineGlobals, lookups), &x);
+		TS_ASSERT_EQUALS(getVarCached(topEntry, "x", nullptr, &globals, &engineGlobals, lookups), &x);
+		TS_ASSERT_EQUALS(lookups, 2);
+	}
+
+	void test_var_cache_shadowing() {
+		TestValue scope, globals, engineGlobals, global, local;
+		engineGlobals.setProp("x", &global);
+
+		Wintermute::ScVarCacheEntry<TestValue> entry;
+		int lookups = 0;
+		TS_ASSERT_EQUALS(getVarCached(entry, "x", &scope, &globals, &engineGlobals, lookups), &global);
+
+		// A local variable with the same name must hide the cached global
+		scope.setProp("x", &local);
+		TS_ASSERT_EQUALS(getVarCached(entry, "x", &scope, &globals, &engineGlobals, lookups), &local);
+		TS_ASSERT_EQUALS(lookups, 2);
+
+		// Same for a variable that was deleted
+		scope.deleteProp("x");
+		TS_ASSERT_EQUALS(getVarCached(entry, "x", &scope, &globals, &engineGlobals, lookups), &global);
+		TS_ASSERT_EQUALS(lookups, 3);
+	}
+
+	void test_var_cache_scope_change() {
+		TestValue scope1, scope2, globals, engineGlobals, x1, x2;
+		scope1.setProp("x", &x1);
+		scope2.setProp("x", &x2);
+
+		Wintermute::ScVarCacheEntry<TestValue> entry;
+		int lookups = 0;
+		TS_ASSERT_EQUALS(getVarCached(entry, "x", &scope1, &globals, &engineGlobals, lookups), &x1);
+		// Another call of the same function has its own scope
+		TS_ASSERT_EQUALS(getVarCached(entry, "x", &scope2, &globals, &engineGlobals, lookups), &x2);
+		TS_ASSERT_EQUALS(lookups, 2);
+
+		entry.clear();
+		TS_ASSERT(!entry.matches(&scope2, &globals, &engineGlobals));
+	}
+
+	void test_prop_cache() {
+		TestValue obj, other, x, y;
+		obj.setProp("x", &x);
+		obj.setProp("y", &y);
+		other.setProp("x", &y);
+
+		Wintermute::ScPropCacheEntry<TestValue> entry;
+		TS_ASSERT(!entry.matches(&obj, "x"));
+		entry.store(&obj, "x", obj.getOwnProp("x"));
+		TS_ASSERT(entry.matches(&obj, "x"));
+		TS_ASSERT_EQUALS(entry.value, &x);
+
+		// The same instruction may access a different name or object
+		TS_ASSERT(!entry.matches(&obj, "y"));
+		TS_ASSERT(!entry.matches(&other, "x"));
+
+		// Removing any property invalidates the entry
+		obj.deleteProp("y");
+		TS_ASSERT(!entry.matches(&obj, "x"));
+	}
+
+	void test_prop_cache_write() {
+		TestValue obj, x, ten, twenty;
+		obj.setProp("x", &x);
+		ten.value = 10;
+		twenty.value = 20;
+
+		TestValue ref;
+		makeRef(ref, obj);
+		Wintermute::ScPropCacheEntry<TestValue> entry;
+		int lookups = 0;
+		setPropCached(entry, &ref, "x", &ten, lookups);
+		setPropCached(entry, &ref, "x", &twenty, lookups);
+		TS_ASSERT_EQUALS(x.value, 20);
+		TS_ASSERT_EQUALS(lookups, 1);
+
+		// A new property has no storage to write to yet
+		setPropCached(entry, &ref, "y", &ten, lookups);
+		TS_ASSERT(obj.getOwnProp("y") != nullptr);
+	}
+
+	void test_prop_cache_write_native() {
+		TestValue native, str, ten;
+		native._type = Wintermute::VAL_NATIVE;
+		str._type = Wintermute::VAL_STRING;
+		ten.value = 10;
+
+		// actor.X = 10 must reach the setter of the native
+		TestValue ref;
+		makeRef(ref, native);
+		TS_ASSERT(!Wintermute::scCacheableObject(&ref));
+		Wintermute::ScPropCacheEntry<TestValue> entry;
+		int lookups = 0;
+		setPropCached(entry, &ref, "X", &ten, lookups);
+		setPropCached(entry, &ref, "X", &ten, lookups);
+		TS_ASSERT_EQUALS(native.value, 10);
+		TS_ASSERT_EQUALS(native.setterCalls, 2);
+
+		TestValue strRef;
+		makeRef(strRef, str);
+		setPropCached(entry, &strRef, "Length", &ten, lookups);
+		TS_ASSERT_EQUALS(str.setterCalls, 1);
+
+		// Neither is cached
+		TS_ASSERT_EQUALS(lookups, 0);
+		TS_ASSERT(!entry.value);
+	}
+};
@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/font.h"
+#include "graphics/surface.h"
+
+/**
+ * Monospaced font drawing each character as a solid box, with a kerning
+ * of -1 between two 'A's.
+ */
+class TestFont : public Graphics::Font {
+public:
+	mutable int _kerningQueries;
+	mutable int _drawCalls;
+
+	TestFont() : _kerningQueries(0), _drawCalls(0) {}
+
+	int getFontHeight() const override { return 4; }
+	int getMaxCharWidth() const override { return 3; }
+	int getCharWidth(uint32 chr) const override { return 3; }
+
+	int getKerningOffset(uint32 left, uint32 right) const override {
+		_kerningQueries++;
+		return (left == 'A' && right == 'A') ? -1 : 0;
+	}
+
+	void drawChar(Graphics::Surface *dst, uint32 chr, int x, int y, uint32 color) const override {
+		Common::Rect r(x, y, x + 2, y + 4);
+		r.clip(dst->w, dst->h);
+		if (!r.isEmpty())
+			dst->fillRect(r, chr);
+	}
+
+	void drawChars(Graphics::Surface *dst, const PlacedChar *chars, uint count, int y, uint32 color) const override {
+		_drawCalls++;
+		Graphics::Font::drawChars(dst, chars, count, y, color);
+	}
+};
+
+class FontTestSuite : public CxxTest::TestSuite {
+public:
+	void test_draw_string_placement() {
+		TestFont font;
+		Graphics::Surface surface;
+		surface.create(20, 4, Graphics::PixelFormat::createFormatCLUT8());
+		surface.fillRect(Common::Rect(20, 4), 0);
+
+		font.drawString(&surface, "AAB", 0, 0, 20, 0);
+
+		// Everything is placed before drawing, with one kerning query per character
+		TS_ASSERT_EQUALS(font._kerningQueries, 3);
+		TS_ASSERT_EQUALS(font._drawCalls, 1);
+
+		static const byte expected[] = { 'A', 'A', 'A', 'A', 0, 'B', 'B', 0, 0 };
+		for (uint x = 0; x < ARRAYSIZE(expected); x++)
+			TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(x, 0), expected[x]);
+
+		surface.free();
+	}
+
+	void test_draw_string_alignment() {
+		TestFont font;
+		Graphics::Surface surface;
+		surface.create(20, 4, Graphics::PixelFormat::createFormatCLUT8());
+		surface.fillRect(Common::Rect(20, 4), 0);
+
+		// "AB" is 6 pixels wide, and ends at the right of the area
+		font.drawString(&surface, "AB", 0, 0, 10, 0, Graphics::kTextAlignRight);
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(3, 0), 0);
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(4, 0), 'A');
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(7, 0), 'B');
+
+		surface.free();
+	}
+
+	void test_draw_string_clipping() {
+		TestFont font;
+		Graphics::Surface surface;
+		surface.create(20, 4, Graphics::PixelFormat::createFormatCLUT8());
+		surface.fillRect(Common::Rect(20, 4), 0);
+
+		// Only the characters fitting in the 8 pixels of the area are drawn
+		font.drawString(&surface, "BBBB", 0, 0, 8, 0);
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(6, 0), 'B');
+		TS_ASSERT_EQUALS(*(const byte *)surface.getBasePtr(9, 0), 0);
+
+		surface.free();
+	}
+};
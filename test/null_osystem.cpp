@@ -2,6 +2,9 @@
 #define NULL_DRIVER_USE_FOR_TEST 1
 #include "null_osystem.h"
 #include "../backends/platform/null/null.cpp"
+#ifdef POSIX
+#include "../backends/mutex/pthread/pthread-mutex.cpp"
+#endif
 
 void Common::install_null_g_system() {
 	g_system = OSystem_NULL_create();
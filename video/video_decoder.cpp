@@ -27,6 +27,7 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #include "graphics/palette.h"
@@ -185,6 +186,8 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	Common::ProfileZone zone("decodeNextFrame");
+
 	_needsUpdate = false;
 	_canSetDither = false;
 